@@ -52,6 +52,17 @@ FString ULoopRoutineSelectAbilityRoutine::DescribeRoutineToGameplayDebugger() co
 	return FString::Printf(TEXT("{yellow} %s {white}[loop %i]%s"), *GetName(), LoopCount, *DescribeAbilityMapToGameplayDebugger());
 }
 
+void ULoopRoutineSelectAbilityRoutine::AppendAbilityClassList(TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList) const
+{
+	for (const TPair<TSubclassOf<UAbilityInfo>, FRoutineAbilityEntry>& Entry : RoutineAbilityMap)
+	{
+		if (Entry.Key)
+		{
+			AbilityClassList.AddUnique(Entry.Key);
+		}
+	}
+}
+
 URoutineAction* ULoopRoutineSelectAbilityRoutine::CreateRoutineAction(TSubclassOf<URoutineAction> RoutineActionClass, bool bAutoStart)
 {
 	if (!NextSelectedAbility.IsValid())
@@ -10,7 +10,7 @@
 UCombatHistoryComponent::UCombatHistoryComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	
 	SetIsReplicatedByDefault(true);
@@ -20,35 +20,51 @@ void UCombatHistoryComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	DamageLogList.Reserve(MaxDamageLogCount);
+	DamageLogBufferList.Reserve(MaxBufferedDamageLogCount);
+
 	OwningStatusInterface = GetOwner();
 	BindToStatusComponent();
 }
 
-void UCombatHistoryComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCombatHistoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	if (DamageLogBufferList.Num() == 0)
+	if (UWorld* World = GetWorld())
 	{
-		return;
+		World->GetTimerManager().ClearTimer(DamageLogFlushTimer);
 	}
 
-	const float WorldTimeSeconds = GetWorld()->GetTimeSeconds();
-	for (int32 Index = DamageLogBufferList.Num() - 1; Index >= 0; Index--)
+	Super::EndPlay(EndPlayReason);
+}
+
+UStatusComponent* UCombatHistoryComponent::GetStatusComponent() const
+{
+	return UStatusInterfaceStatics::GetStatusComponent(OwningStatusInterface);
+}
+
+TArray<FDamageLogEvent> UCombatHistoryComponent::GetDamageLogList() const
+{
+	TArray<FDamageLogEvent> OrderedDamageLogList;
+	OrderedDamageLogList.Reserve(DamageLogList.Num());
+
+	for (int32 Index = 0; Index < DamageLogList.Num(); Index++)
 	{
-		if (DamageLogBufferList[Index].IsExpired(WorldTimeSeconds))
-		{
-			AddDamageLogEvent(DamageLogBufferList[Index]);
-			DamageLogBufferList.RemoveAt(Index, 1, false);
-		}
+		OrderedDamageLogList.Add(DamageLogList[(DamageLogHeadIndex + Index) % DamageLogList.Num()]);
 	}
 
-	SetComponentTickEnabled(DamageLogBufferList.Num() > 0);
+	return OrderedDamageLogList;
 }
 
-UStatusComponent* UCombatHistoryComponent::GetStatusComponent() const
+const FDamageLogEvent& UCombatHistoryComponent::GetDamageLogDeathEvent() const
 {
-	return UStatusInterfaceStatics::GetStatusComponent(OwningStatusInterface);
+	if (DamageLogList.Num() == 0)
+	{
+		static const FDamageLogEvent InvalidDamageLogEvent = FDamageLogEvent();
+		return InvalidDamageLogEvent;
+	}
+
+	//DamageLogHeadIndex is 0 until the ring is full, so this resolves to the last written entry in both cases.
+	return DamageLogList[(DamageLogHeadIndex + DamageLogList.Num() - 1) % DamageLogList.Num()];
 }
 
 void UCombatHistoryComponent::BindToStatusComponent()
@@ -91,65 +107,63 @@ void UCombatHistoryComponent::ProcessDamageLogEvent(const FDamageLogEvent& Damag
 	if (IsBufferedEvent(DamageLogEvent))
 	{
 		PushDamageLogEventToBuffer(DamageLogEvent);
-		SetComponentTickEnabled(true);
+		UpdateFlushTimer();
 		return;
 	}
 
 	AddDamageLogEvent(DamageLogEvent);
 }
 
+//Returns true if both events come from the same source and are close enough in time to be merged.
 inline bool CanCombine(const FDamageLogEvent& A, const FDamageLogEvent& B)
 {
-	if (A.Instigator == B.Instigator && A.InstigatorWeaponClass == B.InstigatorWeaponClass
-		/* && A.InstigatorFireModeClass == B.InstigatorFireModeClass */ && A.InstigatorDamageType == B.InstigatorDamageType)
+	if (A.Instigator != B.Instigator || A.InstigatorWeaponClass != B.InstigatorWeaponClass
+		/* || A.InstigatorFireModeClass != B.InstigatorFireModeClass */ || A.InstigatorDamageType != B.InstigatorDamageType)
 	{
 		return false;
 	}
 
-	return true;
+	return FMath::Abs(A.TimeStamp - B.TimeStamp) <= FDamageLogEvent::MaxMergeDeltaTime;
 }
 
 void UCombatHistoryComponent::ProcessDeathDamageLogEvent(const FDamageLogEvent& DeathDamageLogEvent)
 {
+	FDamageLogEvent FinalDeathDamageLogEvent = DeathDamageLogEvent;
+
 	//If the death damage log can be buffered, check if we have a suitable event in the buffer to merge with.
 	if (IsBufferedEvent(DeathDamageLogEvent))
 	{
-		int32 CombinedEventIndex = INDEX_NONE;
-		//Find if we have an event to merge with. While doing that, push through all events that were buffered (as we are about to die).
 		for (int32 Index = 0; Index < DamageLogBufferList.Num(); Index++)
 		{
 			if (!CanCombine(DamageLogBufferList[Index], DeathDamageLogEvent))
 			{
-				AddDamageLogEvent(DamageLogBufferList[Index]);
 				continue;
 			}
 
-			DamageLogBufferList[Index].CombineWithEvent(DeathDamageLogEvent);
-			CombinedEventIndex = Index;
-		}
-
-		if (CombinedEventIndex == INDEX_NONE)
-		{
-			AddDamageLogEvent(DeathDamageLogEvent);
-		}
-		else
-		{
-			DamageLogBufferList[CombinedEventIndex];
+			FinalDeathDamageLogEvent = DamageLogBufferList[Index];
+			FinalDeathDamageLogEvent.CombineWithEvent(DeathDamageLogEvent);
+			FinalDeathDamageLogEvent.MarkDeathEvent();
+			DamageLogBufferList.RemoveAt(Index, 1, false);
+			break;
 		}
-		return;
 	}
 
-	//Flush buffered damage log events, then push the death event.
-	for (const FDamageLogEvent& BufferedDamageLogEvent : DamageLogBufferList)
-	{
-		AddDamageLogEvent(BufferedDamageLogEvent);
-	}
-	AddDamageLogEvent(DeathDamageLogEvent);
+	//Flush buffered damage log events (as we are about to die), then push the death event.
+	FlushDamageLogBuffer(true);
+	AddDamageLogEvent(FinalDeathDamageLogEvent);
 }
 
 void UCombatHistoryComponent::AddDamageLogEvent(const FDamageLogEvent& DamageLogEvent)
 {
-	DamageLogList.Add(DamageLogEvent);
+	if (DamageLogList.Num() < MaxDamageLogCount)
+	{
+		DamageLogList.Add(DamageLogEvent);
+	}
+	else
+	{
+		DamageLogList[DamageLogHeadIndex] = DamageLogEvent;
+		DamageLogHeadIndex = (DamageLogHeadIndex + 1) % DamageLogList.Num();
+	}
 
 	OnReceivedDamageLogEvent.Broadcast(this, DamageLogEvent);
 
@@ -158,15 +172,31 @@ void UCombatHistoryComponent::AddDamageLogEvent(const FDamageLogEvent& DamageLog
 		OnReceivedDamageLogDeathEvent.Broadcast(this, DamageLogEvent);
 	}
 
-	if (GetOwnerRole() == ROLE_Authority)
+	//Only bother batching events if there is a remote owning client to send them to.
+	if (GetOwnerRole() != ROLE_Authority || !GetOwner() || !GetOwner()->GetNetConnection())
+	{
+		return;
+	}
+
+	//The owning client only keeps the last MaxDamageLogCount events, anything older than that would be evicted on arrival anyway.
+	if (PendingDamageLogSendList.Num() >= MaxDamageLogCount)
 	{
-		Client_Relaible_SendDamageLog(DamageLogEvent);
+		PendingDamageLogSendList.RemoveAt(0, (PendingDamageLogSendList.Num() - MaxDamageLogCount) + 1, false);
 	}
+
+	PendingDamageLogSendList.Add(DamageLogEvent);
+
+	if (DamageLogEvent.IsDeathEvent())
+	{
+		SendPendingDamageLogEvents(true);
+	}
+
+	UpdateFlushTimer();
 }
 
 int32 UCombatHistoryComponent::PushDamageLogEventToBuffer(const FDamageLogEvent& DamageLogEvent)
 {
-	for (int32 Index = DamageLogList.Num() - 1; Index >= 0; Index--)
+	for (int32 Index = DamageLogBufferList.Num() - 1; Index >= 0; Index--)
 	{
 		if (!CanCombine(DamageLogBufferList[Index], DamageLogEvent))
 		{
@@ -177,16 +207,115 @@ int32 UCombatHistoryComponent::PushDamageLogEventToBuffer(const FDamageLogEvent&
 		return Index;
 	}
 
-	DamageLogBufferList.Add(DamageLogEvent);
-	return DamageLogBufferList.Num() - 1;
+	//Buffer is full, push the oldest buffered event through to make room.
+	if (DamageLogBufferList.Num() >= MaxBufferedDamageLogCount)
+	{
+		const FDamageLogEvent OldestDamageLogEvent = DamageLogBufferList[0];
+		DamageLogBufferList.RemoveAt(0, 1, false);
+		AddDamageLogEvent(OldestDamageLogEvent);
+	}
+
+	return DamageLogBufferList.Add(DamageLogEvent);
+}
+
+void UCombatHistoryComponent::FlushDamageLog()
+{
+	FlushDamageLogBuffer(false);
+	SendPendingDamageLogEvents(false);
+	UpdateFlushTimer();
 }
 
-void UCombatHistoryComponent::Client_Relaible_SendDamageLog_Implementation(const FDamageLogEvent& DamageLog)
+void UCombatHistoryComponent::FlushDamageLogBuffer(bool bForceFlush)
+{
+	if (DamageLogBufferList.Num() == 0)
+	{
+		return;
+	}
+
+	const float WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	//Iterate forward so that events are added to the log in the order they were buffered.
+	for (int32 Index = 0; Index < DamageLogBufferList.Num();)
+	{
+		if (!bForceFlush && !DamageLogBufferList[Index].IsExpired(WorldTimeSeconds))
+		{
+			Index++;
+			continue;
+		}
+
+		const FDamageLogEvent ExpiredDamageLogEvent = DamageLogBufferList[Index];
+		DamageLogBufferList.RemoveAt(Index, 1, false);
+		AddDamageLogEvent(ExpiredDamageLogEvent);
+	}
+}
+
+void UCombatHistoryComponent::SendPendingDamageLogEvents(bool bReliable)
+{
+	int32 BatchCount = 0;
+
+	while (PendingDamageLogSendList.Num() > 0)
+	{
+		if (!bReliable && BatchCount >= MaxUnreliableDamageLogBatchesPerFlush)
+		{
+			return;
+		}
+
+		const int32 BatchSize = FMath::Min(PendingDamageLogSendList.Num(), MaxDamageLogBatchSize);
+		const TArray<FDamageLogEvent> DamageLogBatch(PendingDamageLogSendList.GetData(), BatchSize);
+		PendingDamageLogSendList.RemoveAt(0, BatchSize, false);
+		BatchCount++;
+
+		if (!bReliable)
+		{
+			Client_Unreliable_SendDamageLogBatch(DamageLogBatch);
+			continue;
+		}
+
+		Client_Reliable_SendDamageLogBatch(DamageLogBatch);
+	}
+}
+
+void UCombatHistoryComponent::UpdateFlushTimer()
+{
+	UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+
+	if (DamageLogBufferList.Num() == 0 && PendingDamageLogSendList.Num() == 0)
+	{
+		TimerManager.ClearTimer(DamageLogFlushTimer);
+		return;
+	}
+
+	if (!TimerManager.IsTimerActive(DamageLogFlushTimer))
+	{
+		TimerManager.SetTimer(DamageLogFlushTimer, FTimerDelegate::CreateUObject(this, &UCombatHistoryComponent::FlushDamageLog), DamageLogFlushInterval, true);
+	}
+}
+
+void UCombatHistoryComponent::Client_Unreliable_SendDamageLogBatch_Implementation(const TArray<FDamageLogEvent>& DamageLogEventList)
+{
+	ReceiveDamageLogBatch(DamageLogEventList);
+}
+
+void UCombatHistoryComponent::Client_Reliable_SendDamageLogBatch_Implementation(const TArray<FDamageLogEvent>& DamageLogEventList)
+{
+	ReceiveDamageLogBatch(DamageLogEventList);
+}
+
+void UCombatHistoryComponent::ReceiveDamageLogBatch(const TArray<FDamageLogEvent>& DamageLogEventList)
 {
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		return;
 	}
 
-	AddDamageLogEvent(DamageLog);
-}
\ No newline at end of file
+	for (const FDamageLogEvent& DamageLogEvent : DamageLogEventList)
+	{
+		AddDamageLogEvent(DamageLogEvent);
+	}
+}
@@ -22,6 +22,7 @@
 #include "Player/CoreWidgetInteractionComponent.h"
 #include "Character/VoiceComponent.h"
 #include "Character/CoreCharacterAnimInstance.h"
+#include "Character/CorpseManager.h"
 #include "System/ReplicatedObjectInterface.h"
 
 inline void UpdatePlayerSkeletalMesh(USkeletalMeshComponent* Mesh)
@@ -513,6 +514,8 @@ void ACoreCharacter::Died(float Damage, struct FDamageEvent const& DamageEvent,
 				MeshComponent->AddImpulseAtLocation(HitMomentum, DeathEvent.HitLocation);
 			}
 		}
+
+		UCorpseManager::RegisterCorpse(this);
 	}
 	else
 	{
@@ -1,6 +1,7 @@
 // Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
 
 #include "Character/CoreCharacterAnimInstance.h"
+#include "Nausea.h"
 #include "Character/CoreCharacter.h"
 #include "Character/CoreCharacterMovementComponent.h"
 #include "Weapon/InventoryManagerComponent.h"
@@ -18,16 +19,21 @@ FCoreCharacterAnimInstanceProxy::FCoreCharacterAnimInstanceProxy(UAnimInstance*
 
 void FCoreCharacterAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
 {
+	CSV_SCOPED_TIMING_STAT(Nausea, CoreCharacterAnimPreUpdate);
+
 	if (UCoreCharacterAnimInstance* CoreAnimInstance = Cast<UCoreCharacterAnimInstance>(InAnimInstance))
 	{
-		CoreAnimInstance->SetLocomotionAnimation(CoreAnimInstance->GetLocomotionAnimation());
+		LocomotionAnimations = CoreAnimInstance->GetLocomotionAnimation();
+		CoreAnimInstance->SetLocomotionAnimation(LocomotionAnimations);
+		CoreAnimInstance->UpdateStatusMontageLoops();
 
-		if (ACoreCharacter* CoreCharacter = CoreAnimInstance->GetCharacter())
+		if (const ACoreCharacter* CoreCharacter = CoreAnimInstance->GetCharacter())
 		{
-			const FVector& Velocity = CoreCharacter->GetVelocity();
+			const FRotator ActorRotation = CoreCharacter->GetActorRotation();
+			Velocity = CoreCharacter->GetVelocity();
 
-			MovementSpeed = CoreCharacter->GetVelocity().Size2D();
-			MovementDirection = CoreAnimInstance->CalculateDirection(Velocity, CoreCharacter->GetActorRotation());
+			MovementSpeed = Velocity.Size2D();
+			MovementDirection = CoreAnimInstance->CalculateDirection(Velocity, ActorRotation);
 
 			bMoving = MovementSpeed > CoreAnimInstance->MinMoveSpeed;
 			bRunning = MovementSpeed > CoreAnimInstance->MinRunMoveSpeed;
@@ -37,12 +43,22 @@ void FCoreCharacterAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, f
 			bJumping = CoreCharacter->bPressedJump || CoreCharacter->IsFalling();
 			bRunJumping = bJumping && bRunning;
 
+			const FRotator AimOffset = (CoreCharacter->GetBaseAimRotation() - ActorRotation).GetNormalized();
+			AimPitch = AimOffset.Pitch;
+			AimYaw = AimOffset.Yaw;
+
 			bDead = CoreCharacter->IsDead();
+			bActionBlocked = CoreCharacter->GetStatusComponent() && CoreCharacter->GetStatusComponent()->IsBlockingAction();
+
+			const UWeapon* CurrentWeapon = CoreCharacter->GetInventoryManager() ? CoreCharacter->GetInventoryManager()->GetCurrentWeapon() : nullptr;
+			bHasWeapon = CurrentWeapon != nullptr;
+			WeaponState = CurrentWeapon ? CurrentWeapon->GetWeaponState() : EWeaponState::Inactive;
+			bFiring = CurrentWeapon && CurrentWeapon->IsFiring();
 		}
 
-		if (CoreAnimInstance->GetSkelMeshComponent())
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = CoreAnimInstance->GetSkelMeshComponent())
 		{
-			bIsLowLOD = InAnimInstance->GetSkelMeshComponent()->GetPredictedLODLevel() > 0;
+			bIsLowLOD = SkeletalMeshComponent->GetPredictedLODLevel() > 0;
 		}
 		else
 		{
@@ -61,7 +77,7 @@ UCoreCharacterAnimInstance::UCoreCharacterAnimInstance(const FObjectInitializer&
 
 ACoreCharacter* UCoreCharacterAnimInstance::GetCharacter() const
 {
-	return Cast<ACoreCharacter>(GetOwningActor());
+	return OwningCharacter ? OwningCharacter : Cast<ACoreCharacter>(GetOwningActor());
 }
 
 const FLocomotionAnimationContainer& UCoreCharacterAnimInstance::GetLocomotionAnimation() const
@@ -89,21 +105,6 @@ void UCoreCharacterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* In
 
 }
 
-void UCoreCharacterAnimInstance::BeginDestroy()
-{
-	if (GetWorld())
-	{
-		FTimerManager& TimerManager = GetWorld()->GetTimerManager();
-
-		for (TPair<UAnimMontage*, FTimerHandle>& Entry : StatusMontageLoopTimerMap)
-		{
-			TimerManager.ClearTimer(Entry.Value);
-		}
-	}
-
-	Super::BeginDestroy();
-}
-
 const UAnimationObject* UCoreCharacterAnimInstance::GetCharacterAnimationObject() const
 {
 	if (!GetCharacter())
@@ -121,33 +122,70 @@ const UAnimationObject* UCoreCharacterAnimInstance::GetCharacterAnimationObject(
 	}
 }
 
-bool UCoreCharacterAnimInstance::DoesMontageHaveRegisteredLoopTimerHandle(UAnimMontage* Montage) const
+bool UCoreCharacterAnimInstance::IsStatusMontageLooping(UAnimMontage* Montage) const
 {
-	return StatusMontageLoopTimerMap.Contains(Montage);
+	for (const FStatusMontageLoopEntry& Entry : StatusMontageLoopList)
+	{
+		if (Entry.Montage == Montage)
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
-void UCoreCharacterAnimInstance::RegisterMontageLoopTimerHandle(UAnimMontage* Montage, FTimerHandle Handle)
+void UCoreCharacterAnimInstance::RegisterStatusMontageLoop(UAnimMontage* Montage, UStatusEffectBase* StatusEffect, float LoopEndSectionStartTime, float LoopEndSectionLength)
 {
-	ensure(!StatusMontageLoopTimerMap.Contains(Montage));
-	StatusMontageLoopTimerMap.Add(Montage) = Handle;
+	ensure(!IsStatusMontageLooping(Montage));
+	StatusMontageLoopList.Emplace(Montage, StatusEffect, LoopEndSectionStartTime, LoopEndSectionLength);
 }
 
-void UCoreCharacterAnimInstance::RevokeMontageLoopTimerHandle(UAnimMontage* Montage)
+void UCoreCharacterAnimInstance::RevokeStatusMontageLoop(UAnimMontage* Montage)
 {
-	if (!StatusMontageLoopTimerMap.Contains(Montage))
+	StatusMontageLoopList.RemoveAllSwap([Montage](const FStatusMontageLoopEntry& Entry) { return Entry.Montage == Montage; }, false);
+}
+
+void UCoreCharacterAnimInstance::UpdateStatusMontageLoops()
+{
+	for (int32 Index = StatusMontageLoopList.Num() - 1; Index >= 0; Index--)
 	{
-		return;
-	}
+		const FStatusMontageLoopEntry& Entry = StatusMontageLoopList[Index];
 
-	GetWorld()->GetTimerManager().ClearTimer(StatusMontageLoopTimerMap[Montage]);
-	StatusMontageLoopTimerMap.Remove(Montage);
+		if (!Entry.Montage || !Entry.StatusEffect.IsValid())
+		{
+			StatusMontageLoopList.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		if (Entry.LoopEndSectionLength < 0.f)
+		{
+			continue;
+		}
+
+		const float StatusTimeRemaining = Entry.StatusEffect->GetStatusTimeRemaining();
+
+		if (StatusTimeRemaining == -1.f || StatusTimeRemaining > Entry.LoopEndSectionLength)
+		{
+			continue;
+		}
+
+		UAnimMontage* Montage = Entry.Montage;
+		const float LoopEndPosition = Entry.LoopEndSectionStartTime + FMath::Clamp(Entry.LoopEndSectionLength - StatusTimeRemaining, 0.f, Entry.LoopEndSectionLength);
+		StatusMontageLoopList.RemoveAtSwap(Index, 1, false);
+
+		Montage_Stop(0.25f, Montage);
+		Montage_Play(Montage, 1.f, EMontagePlayReturnType::MontageLength, LoopEndPosition, false);
+	}
 }
 
 void UCoreCharacterAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 
-	if (ACoreCharacter* CoreCharacter = Cast<ACoreCharacter>(GetOwningActor()))
+	OwningCharacter = Cast<ACoreCharacter>(GetOwningActor());
+
+	if (ACoreCharacter* CoreCharacter = OwningCharacter)
 	{
 		SetCoreCharacterMovementComponent(CoreCharacter->GetCoreMovementComponent());
 
@@ -172,6 +210,7 @@ void UCoreCharacterAnimInstance::NativeInitializeAnimation()
 	if (const UAnimationObject* LocomotionCDO = DefaultAnimationObject ? DefaultAnimationObject.GetDefaultObject() : nullptr)
 	{
 		DefaultLocomationAnimations = LocomotionCDO->LocomontionAnimations;
+		LocomotionCDO->PrepareAnimationContent();
 	}
 }
 
@@ -6,6 +6,9 @@
 #include "Character/CoreCharacterAnimInstance.h"
 #include "Gameplay/StatusEffect/StatusEffectBase.h"
 #include "Animation/AnimMontage.h"
+#include "Character/CoreCharacter.h"
+#include "Weapon/InventoryManagerComponent.h"
+#include "Weapon/Weapon.h"
 
 FWeaponMontagePair FWeaponMontagePair::InvalidMontagePair = FWeaponMontagePair();
 
@@ -34,6 +37,13 @@ UAnimMontage* FHitReactionAnimationContainer::GetMontageForStream(EHitReactionSt
 	return nullptr;
 }
 
+void FHitReactionAnimationContainer::AppendMontageList(TArray<UAnimMontage*>& OutMontageList) const
+{
+	OutMontageList.Append(*LightHitReaction);
+	OutMontageList.Append(*MediumHitReaction);
+	OutMontageList.Append(*HeavyHitReaction);
+}
+
 FName UAnimationObject::StatusLoopSection = "Loop";
 FName UAnimationObject::StatusLoopEndSection = "LoopEnd";
 UAnimationObject::UAnimationObject(const FObjectInitializer& ObjectInitializer)
@@ -53,6 +63,47 @@ void UAnimationObject::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 	UpdateVisibleProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		ResetMontageSectionCache();
+	}
+}
+
+//Animation objects with a filled section cache. Lets a re-saved montage find every cache holding stale section info for it.
+static TArray<TWeakObjectPtr<const UAnimationObject>> SectionCachedAnimationObjectList;
+
+void UAnimationObject::ResetMontageSectionCache() const
+{
+	MontageSectionInfoMap.Reset();
+	bAnimationContentPrepared = false;
+	SectionCachedAnimationObjectList.RemoveSwap(this);
+}
+
+void UAnimationObject::OnObjectSaved(UObject* Object)
+{
+	const UAnimMontage* Montage = Cast<UAnimMontage>(Object);
+
+	if (!Montage)
+	{
+		return;
+	}
+
+	for (int32 Index = SectionCachedAnimationObjectList.Num() - 1; Index >= 0; Index--)
+	{
+		const UAnimationObject* AnimationObject = SectionCachedAnimationObjectList[Index].Get();
+
+		if (!AnimationObject)
+		{
+			SectionCachedAnimationObjectList.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		if (AnimationObject->MontageSectionInfoMap.Contains(Montage))
+		{
+			AnimationObject->ResetMontageSectionCache();
+		}
+	}
 }
 
 void UAnimationObject::UpdateVisibleProperties()
@@ -250,22 +301,7 @@ bool UAnimationObject::PlayHitReactionMontage(UCoreCharacterAnimInstance* AnimIn
 
 	AnimInstance->Montage_Play(HitMontage, 1.f, EMontagePlayReturnType::MontageLength, 0.f, false);
 
-	FName SectionName = NAME_None;
-	switch (Direction)
-	{
-	case EHitReactionDirection::Front:
-		SectionName = HitMontage->IsValidSectionName(FrontHitSection) ? FrontHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Back:
-		SectionName = HitMontage->IsValidSectionName(BackHitSection) ? BackHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Left:
-		SectionName = HitMontage->IsValidSectionName(LeftHitSection) ? LeftHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Right:
-		SectionName = HitMontage->IsValidSectionName(RightHitSection) ? RightHitSection : NAME_None;
-		break;
-	}
+	const FName SectionName = GetMontageSectionInfo(HitMontage).GetDirectionSection(Direction);
 	
 	if (SectionName != NAME_None)
 	{
@@ -282,99 +318,56 @@ bool UAnimationObject::PlayStatusStartMontage(UStatusEffectBase* StatusEffect, U
 		return false;
 	}
 
-	if (!StatusEffectAnimations.StatusMap.Contains(StatusEffect->GetStatusType()))
+	const FStatusAnimationMontageContainer* StatusMontageContainer = StatusEffectAnimations.StatusMap.Find(StatusEffect->GetStatusType());
+
+	if (!StatusMontageContainer)
 	{
 		return false;
 	}
 
-	UAnimMontage* StatusMontage = StatusEffectAnimations.StatusMap[StatusEffect->GetStatusType()].GetRandomMontage(0);
-	const bool bRestartOnRefresh = StatusEffectAnimations.StatusMap[StatusEffect->GetStatusType()].bRestartAnimationOnRefresh;
+	UAnimMontage* StatusMontage = StatusMontageContainer->GetRandomMontage(0);
+	const bool bRestartOnRefresh = StatusMontageContainer->bRestartAnimationOnRefresh;
 
 	if (!StatusMontage)
 	{
 		return false;
 	}
 
-	if (!AnimInstance->DoesMontageHaveRegisteredLoopTimerHandle(StatusMontage) || BeginType == EStatusBeginType::Initial || bRestartOnRefresh)
+	if (!AnimInstance->IsStatusMontageLooping(StatusMontage) || BeginType == EStatusBeginType::Initial || bRestartOnRefresh)
 	{
 		AnimInstance->Montage_Stop(0.2f, StatusMontage);
 		AnimInstance->Montage_Play(StatusMontage, 1.f, EMontagePlayReturnType::MontageLength, 0.f, false);
 	}
 
-	AnimInstance->RevokeMontageLoopTimerHandle(StatusMontage);
-	FName SectionName = NAME_None;
-	switch (Direction)
-	{
-	case EHitReactionDirection::Front:
-		SectionName = StatusMontage->IsValidSectionName(FrontHitSection) ? FrontHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Back:
-		SectionName = StatusMontage->IsValidSectionName(BackHitSection) ? BackHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Left:
-		SectionName = StatusMontage->IsValidSectionName(LeftHitSection) ? LeftHitSection : NAME_None;
-		break;
-	case EHitReactionDirection::Right:
-		SectionName = StatusMontage->IsValidSectionName(RightHitSection) ? RightHitSection : NAME_None;
-		break;
-	}
+	AnimInstance->RevokeStatusMontageLoop(StatusMontage);
+
+	const FAnimationMontageSectionInfo& SectionInfo = GetMontageSectionInfo(StatusMontage);
+	const FName SectionName = SectionInfo.GetDirectionSection(Direction);
 
 	if (SectionName != NAME_None)
 	{
 		AnimInstance->Montage_JumpToSection(SectionName, StatusMontage);
 	}
 
-	int32 SectionIndex = StatusMontage->GetSectionIndex(StatusLoopEndSection);
-
-	if (SectionIndex == INDEX_NONE)
+	if (!SectionInfo.HasLoopEndSection())
 	{
 		if (!bRestartOnRefresh)
 		{
-			const float StatusTimeRemaining = StatusEffect->GetStatusTimeRemaining();
-			FTimerHandle LoopEndHandle;
-			StatusEffect->GetWorld()->GetTimerManager().SetTimer(LoopEndHandle, StatusTimeRemaining, false);
-			AnimInstance->RegisterMontageLoopTimerHandle(StatusMontage, LoopEndHandle);
+			AnimInstance->RegisterStatusMontageLoop(StatusMontage, StatusEffect, 0.f, -1.f);
 		}
 
 		return true;
 	}
 
-	auto PlayMontageEnd = [](TWeakObjectPtr<UStatusEffectBase> StatusEffect, TWeakObjectPtr<UAnimMontage> AnimMontage, TWeakObjectPtr<UCoreCharacterAnimInstance> AnimInstance)
-	{
-		if (!StatusEffect.IsValid() || !AnimInstance.IsValid() || !AnimMontage.IsValid())
-		{
-			return;
-		}
-
-		AnimInstance->Montage_Stop(0.25f, AnimMontage.Get());
-		AnimInstance->Montage_Play(AnimMontage.Get(), 1.f, EMontagePlayReturnType::MontageLength, 0.f, false);
-		AnimInstance->Montage_JumpToSection(StatusLoopEndSection, AnimMontage.Get());
-		AnimInstance->RevokeMontageLoopTimerHandle(AnimMontage.Get());
-	};
-
-	const float StatusTimeRemaining = StatusEffect->GetStatusTimeRemaining();
-
 	//If we have no idea when this montage ends assume it's being manually controlled elsewhere.
-	if (StatusTimeRemaining == -1.f)
+	if (StatusEffect->GetStatusTimeRemaining() == -1.f)
 	{
 		return true;
 	}
 
-	const float TimeUntilStartLoopEnd = StatusTimeRemaining - StatusMontage->GetSectionLength(SectionIndex);
-
-	//If this effect is already about to end then start montage end immediately.
-	if (TimeUntilStartLoopEnd <= 0.f)
-	{
-		PlayMontageEnd(StatusEffect, StatusMontage, AnimInstance);
-		return true;
-	}
-
-	FTimerHandle LoopEndHandle;
-	StatusEffect->GetWorld()->GetTimerManager().SetTimer(LoopEndHandle,
-		FTimerDelegate::CreateWeakLambda(StatusEffect->GetTypedOuter<AActor>(), PlayMontageEnd, TWeakObjectPtr<UStatusEffectBase>(StatusEffect), TWeakObjectPtr<UAnimMontage>(StatusMontage), TWeakObjectPtr<UCoreCharacterAnimInstance>(AnimInstance)),
-		TimeUntilStartLoopEnd, false);
-	
-	AnimInstance->RegisterMontageLoopTimerHandle(StatusMontage, LoopEndHandle);
+	//The anim instance starts the loop end section once the status has less time remaining than the section's length (immediately if it already does).
+	AnimInstance->RegisterStatusMontageLoop(StatusMontage, StatusEffect, SectionInfo.LoopEndSectionStartTime, SectionInfo.LoopEndSectionLength);
+	AnimInstance->UpdateStatusMontageLoops();
 	return true;
 }
 
@@ -385,24 +378,169 @@ bool UAnimationObject::PlayStatusEndMontage(UStatusEffectBase* StatusEffect, UCo
 		return false;
 	}
 
-	if (!StatusEffectAnimations.StatusMap.Contains(StatusEffect->GetStatusType()))
+	const FStatusAnimationMontageContainer* StatusMontageContainer = StatusEffectAnimations.StatusMap.Find(StatusEffect->GetStatusType());
+
+	if (!StatusMontageContainer)
 	{
 		return false;
 	}
 
-	UAnimMontage* StatusMontage = StatusEffectAnimations.StatusMap[StatusEffect->GetStatusType()].GetRandomMontage(0);
+	UAnimMontage* StatusMontage = StatusMontageContainer->GetRandomMontage(0);
 
 	if (!StatusMontage)
 	{
 		return false;
 	}
 
-	AnimInstance->RevokeMontageLoopTimerHandle(StatusMontage);
-	AnimInstance->Montage_Stop(StatusEffectAnimations.StatusMap[StatusEffect->GetStatusType()].StopBlendTime, StatusMontage);
+	AnimInstance->RevokeStatusMontageLoop(StatusMontage);
+	AnimInstance->Montage_Stop(StatusMontageContainer->StopBlendTime, StatusMontage);
 
 	return true;
 }
 
+void UAnimationObject::AppendMontageList(TArray<UAnimMontage*>& OutMontageList) const
+{
+	HitReactionAnimations.AppendMontageList(OutMontageList);
+
+	for (const TPair<EStatusType, FStatusAnimationMontageContainer>& Entry : StatusEffectAnimations.StatusMap)
+	{
+		OutMontageList.Append(*Entry.Value);
+	}
+
+	auto AppendMontagePair = [&OutMontageList](const FWeaponMontagePair& MontagePair)
+	{
+		OutMontageList.Add(MontagePair.PlayerMontage);
+		OutMontageList.Add(MontagePair.WeaponMontage);
+	};
+
+	AppendMontagePair(EquipMontage);
+	AppendMontagePair(PutDownMontage);
+
+	for (const TMap<EFireMode, FWeaponMontagePair>* MontageMap : { &FireMontage, &ReloadMontage, &LoopingReloadMontage })
+	{
+		for (const TPair<EFireMode, FWeaponMontagePair>& Entry : *MontageMap)
+		{
+			AppendMontagePair(Entry.Value);
+		}
+	}
+
+	OutMontageList.Remove(nullptr);
+}
+
+const FAnimationMontageSectionInfo& UAnimationObject::GetMontageSectionInfo(const UAnimMontage* Montage) const
+{
+	if (const FAnimationMontageSectionInfo* SectionInfo = MontageSectionInfoMap.Find(Montage))
+	{
+		return *SectionInfo;
+	}
+
+#if WITH_EDITOR
+	if (MontageSectionInfoMap.Num() == 0)
+	{
+		static FDelegateHandle ObjectSavedHandle = FCoreUObjectDelegates::OnObjectSaved.AddStatic(&UAnimationObject::OnObjectSaved);
+		SectionCachedAnimationObjectList.AddUnique(this);
+	}
+#endif //WITH_EDITOR
+
+	FAnimationMontageSectionInfo& SectionInfo = MontageSectionInfoMap.Add(Montage);
+
+	if (!Montage)
+	{
+		return SectionInfo;
+	}
+
+	auto SetDirectionSection = [&SectionInfo, Montage](EHitReactionDirection Direction, const FName& SectionName)
+	{
+		SectionInfo.DirectionSectionList[uint8(Direction)] = Montage->IsValidSectionName(SectionName) ? SectionName : NAME_None;
+	};
+
+	SetDirectionSection(EHitReactionDirection::Front, FrontHitSection);
+	SetDirectionSection(EHitReactionDirection::Back, BackHitSection);
+	SetDirectionSection(EHitReactionDirection::Left, LeftHitSection);
+	SetDirectionSection(EHitReactionDirection::Right, RightHitSection);
+
+	const int32 LoopEndSectionIndex = Montage->GetSectionIndex(StatusLoopEndSection);
+
+	if (LoopEndSectionIndex != INDEX_NONE)
+	{
+		float LoopEndSectionEndTime = 0.f;
+		Montage->GetSectionStartAndEndTime(LoopEndSectionIndex, SectionInfo.LoopEndSectionStartTime, LoopEndSectionEndTime);
+		SectionInfo.LoopEndSectionLength = Montage->GetSectionLength(LoopEndSectionIndex);
+	}
+	return SectionInfo;
+}
+
+int32 UAnimationObject::PrepareAnimationContent() const
+{
+	if (bAnimationContentPrepared)
+	{
+		return 0;
+	}
+
+	bAnimationContentPrepared = true;
+
+	TArray<UAnimMontage*> MontageList;
+	AppendMontageList(MontageList);
+
+	for (const UAnimMontage* Montage : MontageList)
+	{
+		GetMontageSectionInfo(Montage);
+	}
+
+	return MontageList.Num();
+}
+
+int32 UAnimationObject::PrepareCharacterAnimationContent(TSubclassOf<AActor> CharacterClass)
+{
+	const ACoreCharacter* CharacterCDO = CharacterClass ? Cast<ACoreCharacter>(CharacterClass->GetDefaultObject()) : nullptr;
+
+	if (!CharacterCDO)
+	{
+		return 0;
+	}
+
+	TArray<const UAnimationObject*, TInlineAllocator<8>> AnimationObjectList;
+
+	for (const USkeletalMeshComponent* MeshComponent : { CharacterCDO->GetMesh(), CharacterCDO->GetMesh1P() })
+	{
+		const UCoreCharacterAnimInstance* AnimInstanceCDO = MeshComponent && MeshComponent->AnimClass ? Cast<UCoreCharacterAnimInstance>(MeshComponent->AnimClass->GetDefaultObject()) : nullptr;
+
+		if (AnimInstanceCDO && AnimInstanceCDO->GetDefaultAnimationObject())
+		{
+			AnimationObjectList.AddUnique(AnimInstanceCDO->GetDefaultAnimationObject());
+		}
+	}
+
+	if (const UInventoryManagerComponent* InventoryManager = CharacterCDO->GetInventoryManager())
+	{
+		for (TSubclassOf<UInventory> InventoryClass : InventoryManager->GetDefaultInventoryList())
+		{
+			const UWeapon* WeaponCDO = Cast<UWeapon>(InventoryClass.GetDefaultObject());
+
+			if (!WeaponCDO)
+			{
+				continue;
+			}
+
+			for (TSubclassOf<UAnimationObject> AnimationClass : { WeaponCDO->GetFirstPersonAnimationClass(), WeaponCDO->GetThirdPersonAnimationClass() })
+			{
+				if (AnimationClass)
+				{
+					AnimationObjectList.AddUnique(AnimationClass.GetDefaultObject());
+				}
+			}
+		}
+	}
+
+	int32 MontageCount = 0;
+	for (const UAnimationObject* AnimationObject : AnimationObjectList)
+	{
+		MontageCount += AnimationObject->PrepareAnimationContent();
+	}
+
+	return MontageCount;
+}
+
 const FWeaponMontagePair& UAnimationObject::GetLoopingReloadMontage(EFireMode FireMode) const
 {
 	if (!bHasLoopingReload)
@@ -276,6 +276,7 @@ void UCoreCharacterMovementComponent::OnPlayerClassChanged(ACorePlayerState* Pla
 	{
 		if (WeakPlayerClassComponent.IsValid())
 		{
+			Multiplier *= WeakPlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::MovementSpeed, nullptr);
 			WeakPlayerClassComponent->OnProcessMovementSpeed.Broadcast(GetCoreCharacter(), Multiplier);
 		}
 	});
@@ -5,6 +5,9 @@
 #include "Engine/SkeletalMesh.h"
 #include "Animation/Skeleton.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
 #include "Character/CoreCharacter.h"
 #include "Character/Customization/CustomizationObject.h"
 
@@ -22,6 +25,8 @@ void UCoreCustomizationComponent::BeginPlay()
 
 void UCoreCustomizationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    ReleaseCustomizationStreamHandles();
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -32,9 +37,57 @@ void UCoreCustomizationComponent::SetCustomization(const TArray<UCustomizationAs
     UpdateCustomization();
 }
 
-void UCoreCustomizationComponent::AddCustomizationStreamHandle(TSharedPtr<FStreamableHandle> StreamHandle)
+void UCoreCustomizationComponent::AddCustomizationStreamHandle(FCustomizationStreamHandle StreamHandle)
 {
-    CustomizationStreamableHandleList.Add(StreamHandle);
+    CustomizationStreamHandleList.Add(StreamHandle);
+}
+
+ECustomizationStreamPriority UCoreCustomizationComponent::GetCustomizationStreamPriority() const
+{
+    const ACoreCharacter* Character = GetOwningCharacter();
+    return Character && Character->IsLocallyControlled() ? ECustomizationStreamPriority::Immediate : ECustomizationStreamPriority::Normal;
+}
+
+bool UCoreCustomizationComponent::GetDefaultCustomizationList(TSubclassOf<AActor> ActorClass, TArray<UCustomizationAsset*>& OutCustomizationList)
+{
+    OutCustomizationList.Reset();
+
+    if (!ActorClass)
+    {
+        return false;
+    }
+
+    const UCoreCustomizationComponent* ComponentTemplate = ActorClass->GetDefaultObject<AActor>()->FindComponentByClass<UCoreCustomizationComponent>();
+
+    //Components added in blueprint are not present on the class default object and need to be found through the construction script.
+    for (UClass* Class = ActorClass; !ComponentTemplate && Class; Class = Class->GetSuperClass())
+    {
+        const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Class);
+
+        if (!BlueprintClass || !BlueprintClass->SimpleConstructionScript)
+        {
+            continue;
+        }
+
+        for (const USCS_Node* Node : BlueprintClass->SimpleConstructionScript->GetAllNodes())
+        {
+            ComponentTemplate = Node ? Cast<UCoreCustomizationComponent>(Node->ComponentTemplate) : nullptr;
+
+            if (ComponentTemplate)
+            {
+                break;
+            }
+        }
+    }
+
+    if (!ComponentTemplate)
+    {
+        return false;
+    }
+
+    OutCustomizationList = ComponentTemplate->DefaultCustomizationList;
+    OutCustomizationList.Remove(nullptr);
+    return OutCustomizationList.Num() > 0;
 }
 
 void UCoreCustomizationComponent::AddCustomizationComponent(UActorComponent* Component)
@@ -60,16 +113,7 @@ void UCoreCustomizationComponent::UpdateCustomization()
     }
     CustomizationComponentList.Reset();
 
-    for (TSharedPtr<FStreamableHandle> Handle : CustomizationStreamableHandleList)
-    {
-        if (!Handle.IsValid())
-        {
-            continue;
-        }
-
-        Handle->CancelHandle();
-    }
-    CustomizationStreamableHandleList.Reset();
+    ReleaseCustomizationStreamHandles();
 
     if (!bPerformMergeInEditor || CustomizationList.Num() == 0)
     {
@@ -96,6 +140,15 @@ void UCoreCustomizationComponent::ValidateCustomization(TArray<UCustomizationAss
 	UCustomizationAsset::ValidateCustomization(Cast<ACorePlayerController>(GetOwningController()), GetOwningCharacter(), InCustomizationList);
 }
 
+void UCoreCustomizationComponent::ReleaseCustomizationStreamHandles()
+{
+    for (FCustomizationStreamHandle Handle : CustomizationStreamHandleList)
+    {
+        UCustomizationStreamingManager::ReleaseRequest(this, Handle);
+    }
+    CustomizationStreamHandleList.Reset();
+}
+
 void UCoreCustomizationComponent::OnMeshMergeComplete()
 {
 	if (IsNetMode(NM_DedicatedServer))
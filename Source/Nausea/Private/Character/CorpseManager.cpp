@@ -0,0 +1,548 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "Character/CorpseManager.h"
+#include "Nausea.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/PoseableMeshComponent.h"
+#include "Character/CoreCharacter.h"
+#include "System/CoreGameState.h"
+
+DECLARE_STATS_GROUP(TEXT("CorpseManager"), STATGROUP_CorpseManager, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Update Corpses"), STAT_CorpseManagerUpdate, STATGROUP_CorpseManager);
+DECLARE_CYCLE_STAT(TEXT("Freeze Corpse"), STAT_CorpseManagerFreeze, STATGROUP_CorpseManager);
+
+UCorpseManager::UCorpseManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UCorpseManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CorpseManagerUpdate);
+	CSV_SCOPED_TIMING_STAT(Nausea, CorpseManagerUpdate);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	RemoveStaleCorpses();
+	FreezeSettledCorpses(CurrentTime);
+	UpdateSortScores(CurrentTime);
+	EnforceSimulationBudget();
+	EnforceCorpseBudget(CurrentTime);
+	UpdateFadingCorpses(DeltaTime, CurrentTime);
+}
+
+inline UCorpseManager* GetCorpseManager(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ACoreGameState* CoreGameState = World->GetGameState<ACoreGameState>();
+
+	if (!CoreGameState)
+	{
+		return nullptr;
+	}
+
+	return CoreGameState->GetCorpseManager();
+}
+
+bool UCorpseManager::RegisterCorpse(ACoreCharacter* Character)
+{
+	if (!Character || Character->IsNetMode(NM_DedicatedServer))
+	{
+		return false;
+	}
+
+	UCorpseManager* CorpseManager = GetCorpseManager(Character);
+
+	if (!CorpseManager)
+	{
+		return false;
+	}
+
+	for (const FCorpseEntry& Corpse : CorpseManager->CorpseList)
+	{
+		if (Corpse.Character == Character)
+		{
+			return true;
+		}
+	}
+
+	CorpseManager->CorpseList.Emplace(Character, Character->GetWorld()->GetTimeSeconds());
+	return true;
+}
+
+int32 UCorpseManager::GetSimulatingCorpseCount() const
+{
+	int32 SimulatingCount = 0;
+	for (const FCorpseEntry& Corpse : CorpseList)
+	{
+		if (Corpse.State == ECorpseState::Simulating)
+		{
+			SimulatingCount++;
+		}
+	}
+
+	return SimulatingCount;
+}
+
+void UCorpseManager::RemoveStaleCorpses()
+{
+	//Corpses whose character was destroyed elsewhere (and were not moved onto a pooled mesh) no longer need tracking.
+	CorpseList.RemoveAllSwap([](const FCorpseEntry& Corpse)
+	{
+		if (Corpse.PooledMesh)
+		{
+			return Corpse.PooledMesh->IsPendingKill();
+		}
+
+		return !Corpse.Character.IsValid();
+	}, false);
+}
+
+void UCorpseManager::FreezeSettledCorpses(float CurrentTime)
+{
+	for (FCorpseEntry& Corpse : CorpseList)
+	{
+		if (Corpse.State != ECorpseState::Simulating || CurrentTime - Corpse.DeathTime < MinSimulationTime)
+		{
+			continue;
+		}
+
+		if (IsCorpseAtRest(Corpse))
+		{
+			FreezeCorpse(Corpse);
+		}
+	}
+}
+
+void UCorpseManager::EnforceSimulationBudget()
+{
+	const int32 ExcessCount = GetSimulatingCorpseCount() - MaxSimulatingCorpses;
+
+	if (ExcessCount <= 0)
+	{
+		return;
+	}
+
+	SortedCorpseIndexList.Reset();
+	for (int32 Index = 0; Index < CorpseList.Num(); Index++)
+	{
+		if (CorpseList[Index].State == ECorpseState::Simulating)
+		{
+			SortedCorpseIndexList.Add(Index);
+		}
+	}
+
+	SortedCorpseIndexList.Sort([this](int32 A, int32 B) { return CorpseList[A].SortScore > CorpseList[B].SortScore; });
+
+	for (int32 Index = 0; Index < ExcessCount; Index++)
+	{
+		FreezeCorpse(CorpseList[SortedCorpseIndexList[Index]]);
+	}
+}
+
+void UCorpseManager::EnforceCorpseBudget(float CurrentTime)
+{
+	SortedCorpseIndexList.Reset();
+	for (int32 Index = 0; Index < CorpseList.Num(); Index++)
+	{
+		if (CorpseList[Index].State != ECorpseState::FadingOut)
+		{
+			SortedCorpseIndexList.Add(Index);
+		}
+	}
+
+	const int32 ExcessCount = SortedCorpseIndexList.Num() - MaxCorpses;
+
+	if (ExcessCount <= 0)
+	{
+		return;
+	}
+
+	SortedCorpseIndexList.Sort([this](int32 A, int32 B) { return CorpseList[A].SortScore > CorpseList[B].SortScore; });
+
+	for (int32 Index = 0; Index < ExcessCount; Index++)
+	{
+		StartFadeOut(CorpseList[SortedCorpseIndexList[Index]], CurrentTime);
+	}
+}
+
+inline void OffsetCorpse(const FCorpseEntry& Corpse, const FVector& Offset)
+{
+	if (Corpse.PooledMesh)
+	{
+		Corpse.PooledMesh->AddWorldOffset(Offset);
+		return;
+	}
+
+	const ACoreCharacter* Character = Corpse.Character.Get();
+
+	if (!Character)
+	{
+		return;
+	}
+
+	const TArray<TWeakObjectPtr<UPrimitiveComponent>>& MeshList = Character->GetThirdPersonMeshList();
+	for (const TWeakObjectPtr<UPrimitiveComponent>& MeshComponent : MeshList)
+	{
+		if (!MeshComponent.IsValid())
+		{
+			continue;
+		}
+
+		//Meshes attached to another corpse mesh will follow it.
+		if (MeshList.Contains(Cast<UPrimitiveComponent>(MeshComponent->GetAttachParent())))
+		{
+			continue;
+		}
+
+		MeshComponent->AddWorldOffset(Offset);
+	}
+}
+
+void UCorpseManager::UpdateFadingCorpses(float DeltaTime, float CurrentTime)
+{
+	const FVector SinkOffset = FVector(0.f, 0.f, -FadeOutSinkDistance * (DeltaTime / FMath::Max(FadeOutDuration, KINDA_SMALL_NUMBER)));
+
+	for (int32 Index = CorpseList.Num() - 1; Index >= 0; Index--)
+	{
+		FCorpseEntry& Corpse = CorpseList[Index];
+
+		if (Corpse.State != ECorpseState::FadingOut)
+		{
+			continue;
+		}
+
+		if (CurrentTime - Corpse.FadeStartTime < FadeOutDuration)
+		{
+			OffsetCorpse(Corpse, SinkOffset);
+			continue;
+		}
+
+		RecycleCorpse(Corpse);
+		CorpseList.RemoveAtSwap(Index, 1, false);
+	}
+}
+
+void UCorpseManager::FreezeCorpse(FCorpseEntry& Corpse)
+{
+	if (Corpse.State != ECorpseState::Simulating)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CorpseManagerFreeze);
+
+	Corpse.State = ECorpseState::Frozen;
+
+	ACoreCharacter* Character = Corpse.Character.Get();
+
+	if (!Character)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& MeshComponent : Character->GetThirdPersonMeshList())
+	{
+		if (!MeshComponent.IsValid())
+		{
+			continue;
+		}
+
+		MeshComponent->SetSimulatePhysics(false);
+		MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+		//Without ticking the skeletal mesh never refreshes its bones, leaving it holding the last simulated pose.
+		if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent.Get()))
+		{
+			SkeletalMeshComponent->bPauseAnims = true;
+			SkeletalMeshComponent->SetComponentTickEnabled(false);
+		}
+	}
+
+	TransferToPooledMesh(Corpse);
+}
+
+void UCorpseManager::StartFadeOut(FCorpseEntry& Corpse, float CurrentTime)
+{
+	if (Corpse.State == ECorpseState::FadingOut)
+	{
+		return;
+	}
+
+	FreezeCorpse(Corpse);
+
+	Corpse.State = ECorpseState::FadingOut;
+	Corpse.FadeStartTime = CurrentTime;
+}
+
+void UCorpseManager::RecycleCorpse(FCorpseEntry& Corpse)
+{
+	if (Corpse.PooledMesh)
+	{
+		ReleasePooledMesh(Corpse.PooledMesh);
+		Corpse.PooledMesh = nullptr;
+	}
+
+	if (ACoreCharacter* Character = Corpse.Character.Get())
+	{
+		//Characters that have not been torn off on this client yet cannot be destroyed locally.
+		if (!Character->Destroy())
+		{
+			Character->SetActorHiddenInGame(true);
+		}
+	}
+
+	Corpse.Character = nullptr;
+}
+
+inline bool IsLocalViewTarget(const AActor* Actor)
+{
+	const UWorld* World = Actor->GetWorld();
+
+	if (!World)
+	{
+		return false;
+	}
+
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+
+		if (PlayerController && PlayerController->IsLocalController() && PlayerController->GetViewTarget() == Actor)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UCorpseManager::TransferToPooledMesh(FCorpseEntry& Corpse)
+{
+	ACoreCharacter* Character = Corpse.Character.Get();
+
+	if (!Character || Character->GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	//Player corpses stay on the freeze and fade path. Destroying them would snap a death camera still looking at them and, on a listen server, pull the pawn out from under respawn and spectating.
+	if (Character->GetPlayerState() || Character->IsPlayerControlled() || IsLocalViewTarget(Character))
+	{
+		return false;
+	}
+
+	USkeletalMeshComponent* SkeletalMeshComponent = nullptr;
+	for (const TWeakObjectPtr<UPrimitiveComponent>& MeshComponent : Character->GetThirdPersonMeshList())
+	{
+		if (!MeshComponent.IsValid())
+		{
+			continue;
+		}
+
+		if (SkeletalMeshComponent)
+		{
+			return false;
+		}
+
+		SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent.Get());
+
+		if (!SkeletalMeshComponent)
+		{
+			return false;
+		}
+	}
+
+	//Anything attached to the mesh (held weapons, effects) would be lost when the character is released.
+	if (!SkeletalMeshComponent || !SkeletalMeshComponent->SkeletalMesh || SkeletalMeshComponent->MasterPoseComponent.IsValid()
+		|| SkeletalMeshComponent->GetAttachChildren().Num() > 0)
+	{
+		return false;
+	}
+
+	UPoseableMeshComponent* PoseableMesh = AcquirePooledMesh();
+
+	if (!PoseableMesh)
+	{
+		return false;
+	}
+
+	PoseableMesh->SetSkeletalMesh(SkeletalMeshComponent->SkeletalMesh);
+	PoseableMesh->SetWorldTransform(SkeletalMeshComponent->GetComponentTransform());
+	PoseableMesh->SetCastShadow(SkeletalMeshComponent->CastShadow);
+
+	const int32 MaterialCount = SkeletalMeshComponent->GetNumMaterials();
+	for (int32 MaterialIndex = 0; MaterialIndex < MaterialCount; MaterialIndex++)
+	{
+		PoseableMesh->SetMaterial(MaterialIndex, SkeletalMeshComponent->GetMaterial(MaterialIndex));
+	}
+
+	PoseableMesh->CopyPoseFromSkeletalComponent(SkeletalMeshComponent);
+	PoseableMesh->SetVisibility(true);
+
+	Corpse.PooledMesh = PoseableMesh;
+	Corpse.Character = nullptr;
+	Character->Destroy();
+	return true;
+}
+
+UPoseableMeshComponent* UCorpseManager::AcquirePooledMesh()
+{
+	while (AvailablePooledMeshList.Num() > 0)
+	{
+		UPoseableMeshComponent* PoseableMesh = AvailablePooledMeshList.Pop(false);
+
+		if (PoseableMesh && !PoseableMesh->IsPendingKill())
+		{
+			return PoseableMesh;
+		}
+	}
+
+	UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (!CorpsePoolActor || CorpsePoolActor->IsPendingKillPending())
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		CorpsePoolActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+
+		if (!CorpsePoolActor)
+		{
+			return nullptr;
+		}
+
+		USceneComponent* RootComponent = NewObject<USceneComponent>(CorpsePoolActor, TEXT("CorpsePoolRoot"));
+		CorpsePoolActor->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+	}
+
+	UPoseableMeshComponent* PoseableMesh = NewObject<UPoseableMeshComponent>(CorpsePoolActor);
+	PoseableMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	PoseableMesh->SetGenerateOverlapEvents(false);
+	PoseableMesh->PrimaryComponentTick.bStartWithTickEnabled = false;
+	PoseableMesh->RegisterComponent();
+	CorpsePoolActor->AddInstanceComponent(PoseableMesh);
+	return PoseableMesh;
+}
+
+void UCorpseManager::ReleasePooledMesh(UPoseableMeshComponent* PoseableMesh)
+{
+	if (!PoseableMesh || PoseableMesh->IsPendingKill())
+	{
+		return;
+	}
+
+	PoseableMesh->SetVisibility(false);
+	PoseableMesh->EmptyOverrideMaterials();
+	PoseableMesh->SetSkeletalMesh(nullptr);
+	AvailablePooledMeshList.Add(PoseableMesh);
+}
+
+void UCorpseManager::UpdateSortScores(float CurrentTime)
+{
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation = FRotator::ZeroRotator;
+	bool bHasView = false;
+
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasView = true;
+	}
+
+	for (FCorpseEntry& Corpse : CorpseList)
+	{
+		Corpse.SortScore = CurrentTime - Corpse.DeathTime;
+
+		if (bHasView)
+		{
+			Corpse.SortScore += FVector::Dist(ViewLocation, GetCorpseLocation(Corpse)) * DistanceScoreScale;
+		}
+
+		if (!WasCorpseRecentlyRendered(Corpse))
+		{
+			Corpse.SortScore += OffscreenScore;
+		}
+	}
+}
+
+FVector UCorpseManager::GetCorpseLocation(const FCorpseEntry& Corpse) const
+{
+	if (Corpse.PooledMesh)
+	{
+		return Corpse.PooledMesh->GetComponentLocation();
+	}
+
+	const ACoreCharacter* Character = Corpse.Character.Get();
+
+	if (!Character)
+	{
+		return FVector::ZeroVector;
+	}
+
+	//Ragdolls detach from the capsule so the mesh is a better indication of where the corpse is.
+	return Character->GetMesh() ? Character->GetMesh()->GetComponentLocation() : Character->GetActorLocation();
+}
+
+bool UCorpseManager::WasCorpseRecentlyRendered(const FCorpseEntry& Corpse) const
+{
+	if (Corpse.PooledMesh)
+	{
+		return Corpse.PooledMesh->WasRecentlyRendered(0.2f);
+	}
+
+	const ACoreCharacter* Character = Corpse.Character.Get();
+	return Character && Character->WasRecentlyRendered(0.2f);
+}
+
+bool UCorpseManager::IsCorpseAtRest(const FCorpseEntry& Corpse) const
+{
+	const ACoreCharacter* Character = Corpse.Character.Get();
+
+	if (!Character)
+	{
+		return true;
+	}
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& MeshComponent : Character->GetThirdPersonMeshList())
+	{
+		if (!MeshComponent.IsValid() || !MeshComponent->IsSimulatingPhysics())
+		{
+			continue;
+		}
+
+		if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent.Get()))
+		{
+			if (SkeletalMeshComponent->IsAnyRigidBodyAwake())
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		if (MeshComponent->RigidBodyIsAwake())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
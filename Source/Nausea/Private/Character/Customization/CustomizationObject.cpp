@@ -3,8 +3,11 @@
 
 #include "Character/Customization/CustomizationObject.h"
 #include "Engine/AssetManager.h"
+#include "AssetData.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "System/MeshMergeTypes.h"
+#include "System/CustomizationStreamingManager.h"
 #include "Character/CoreCustomizationComponent.h"
 
 const TArray<ECustomizationSlot> BodySlotList = {
@@ -55,6 +58,55 @@ FPrimaryAssetId UCustomizationAsset::GetPrimaryAssetId() const
 	return FPrimaryAssetId(UCustomizationAsset::StaticClass()->GetFName(), GetFName());
 }
 
+//Asset registry tags written by UCustomizationAsset::GetAssetRegistryTags and read back by UCustomizationAsset::ReadIndexEntry.
+static const FName CustomizationSlotTagName = FName(TEXT("CustomizationSlot"));
+static const FName CustomizationNameTagName = FName(TEXT("CustomizationName"));
+static const FName PreviewIconTagName = FName(TEXT("PreviewIcon"));
+
+void UCustomizationAsset::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	FString CustomizationNameString;
+	FTextStringHelper::WriteToBuffer(CustomizationNameString, CustomizationName);
+
+	OutTags.Add(FAssetRegistryTag(CustomizationSlotTagName, StaticEnum<ECustomizationSlot>()->GetNameStringByValue(int64(CustomizationSlot)), FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(FAssetRegistryTag(CustomizationNameTagName, CustomizationNameString, FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(PreviewIconTagName, PreviewIcon.ToString(), FAssetRegistryTag::TT_Hidden));
+}
+
+bool UCustomizationAsset::ReadIndexEntry(const FAssetData& AssetData, FCustomizationIndexEntry& OutEntry)
+{
+	FString TagValue;
+
+	//Assets saved before registry tags were written will not have any of them.
+	if (!AssetData.IsValid() || !AssetData.GetTagValue(CustomizationSlotTagName, TagValue))
+	{
+		return false;
+	}
+
+	const int64 SlotValue = StaticEnum<ECustomizationSlot>()->GetValueByNameString(TagValue);
+	OutEntry.Slot = SlotValue != INDEX_NONE ? ECustomizationSlot(SlotValue) : ECustomizationSlot::Invalid;
+	OutEntry.CustomizationAsset = TSoftObjectPtr<UCustomizationAsset>(AssetData.ToSoftObjectPath());
+
+	AssetData.GetTagValue(CustomizationNameTagName, OutEntry.CustomizationName);
+
+	if (AssetData.GetTagValue(PreviewIconTagName, TagValue))
+	{
+		OutEntry.PreviewIcon = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TagValue));
+	}
+
+	return true;
+}
+
+void UCustomizationAsset::GetIndexEntry(FCustomizationIndexEntry& OutEntry) const
+{
+	OutEntry.CustomizationAsset = TSoftObjectPtr<UCustomizationAsset>(FSoftObjectPath(this));
+	OutEntry.Slot = CustomizationSlot;
+	OutEntry.CustomizationName = CustomizationName;
+	OutEntry.PreviewIcon = PreviewIcon;
+}
+
 FText UCustomizationAsset::GetSlotEditorName() const
 {
 	switch (CustomizationSlot)
@@ -323,6 +375,32 @@ TArray<TSoftObjectPtr<USkeletalMesh>> UCustomizationAsset::GetMeshMergeListForCu
 	return ResultMeshList;
 }
 
+void UCustomizationAsset::GetAssetListForCustomizationList(const TArray<UCustomizationAsset*>& CustomizationList, TArray<FSoftObjectPath>& OutAssetList)
+{
+	OutAssetList.Reset();
+
+	auto AddAsset = [&OutAssetList](const FSoftObjectPath& AssetPath)
+	{
+		if (!AssetPath.IsNull())
+		{
+			OutAssetList.AddUnique(AssetPath);
+		}
+	};
+
+	for (UCustomizationAsset* Customization : CustomizationList)
+	{
+		if (!Customization)
+		{
+			continue;
+		}
+
+		AddAsset(Customization->GetSkeletalMesh().ToSoftObjectPath());
+		AddAsset(Customization->GetStaticMesh().ToSoftObjectPath());
+		AddAsset(Customization->GetMaterial().ToSoftObjectPath());
+		AddAsset(Customization->GetTexture().ToSoftObjectPath());
+	}
+}
+
 void UCustomizationAsset::ApplyCustomizationList(UCoreCustomizationComponent* CustomizationComponent, USkeletalMeshComponent* SkeletalMeshComponent, const TArray<UCustomizationAsset*>& CustomizationList)
 {
 	if (!CustomizationComponent || !SkeletalMeshComponent)
@@ -366,13 +444,6 @@ bool UCustomizationAsset_Accessory_StaticMesh::Apply(UCoreCustomizationComponent
 		return true;
 	}
 
-	if (!UAssetManager::IsValid())
-	{
-		return false;
-	}
-
-	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
-	
 	TWeakObjectPtr<UCustomizationAsset_Accessory_StaticMesh> WeakThis = const_cast<UCustomizationAsset_Accessory_StaticMesh*>(this);
 	TWeakObjectPtr<UCoreCustomizationComponent> WeakCustomizationComponent = CustomizationComponent;
 	TWeakObjectPtr<USkeletalMeshComponent> WeakSkeletalMeshComponent = SkeletalMeshComponent;
@@ -385,7 +456,8 @@ bool UCustomizationAsset_Accessory_StaticMesh::Apply(UCoreCustomizationComponent
 		SoftObjectPathList.Add(MaterialOverride.ToSoftObjectPath());
 	}
 
-	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(SoftObjectPathList, FStreamableDelegate::CreateWeakLambda(WeakThis.Get(), [WeakThis, WeakCustomizationComponent, WeakSkeletalMeshComponent]()
+	const FCustomizationStreamHandle Handle = UCustomizationStreamingManager::RequestLoad(CustomizationComponent, CustomizationComponent, SoftObjectPathList, CustomizationComponent->GetCustomizationStreamPriority(),
+		FStreamableDelegate::CreateWeakLambda(WeakThis.Get(), [WeakThis, WeakCustomizationComponent, WeakSkeletalMeshComponent]()
 		{
 			if (!WeakThis.IsValid() || !WeakCustomizationComponent.IsValid() || !WeakSkeletalMeshComponent.IsValid())
 			{
@@ -395,13 +467,16 @@ bool UCustomizationAsset_Accessory_StaticMesh::Apply(UCoreCustomizationComponent
 			WeakThis->OnStaticMeshLoaded(WeakCustomizationComponent.Get(), WeakSkeletalMeshComponent.Get());
 		}));
 
-	if (Handle->HasLoadCompleted())
+	if (!Handle.IsValid())
 	{
-		OnStaticMeshLoaded(CustomizationComponent, SkeletalMeshComponent);
+		return false;
 	}
-	else
+
+	CustomizationComponent->AddCustomizationStreamHandle(Handle);
+
+	if (UCustomizationStreamingManager::IsRequestComplete(CustomizationComponent, Handle))
 	{
-		CustomizationComponent->AddCustomizationStreamHandle(Handle);
+		OnStaticMeshLoaded(CustomizationComponent, SkeletalMeshComponent);
 	}
 
 	return true;
@@ -486,17 +561,12 @@ bool UCustomizationAsset_TextureOverride::Apply(UCoreCustomizationComponent* Cus
 		return true;
 	}
 
-	if (!UAssetManager::IsValid())
-	{
-		return false;
-	}
-
-	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
-
 	TWeakObjectPtr<UCustomizationAsset_TextureOverride> WeakThis = const_cast<UCustomizationAsset_TextureOverride*>(this);
 	TWeakObjectPtr<UCoreCustomizationComponent> WeakCustomizationComponent = CustomizationComponent;
 	TWeakObjectPtr<USkeletalMeshComponent> WeakSkeletalMeshComponent = SkeletalMeshComponent;
-	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(Texture.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(WeakThis.Get(), [WeakThis, WeakCustomizationComponent, WeakSkeletalMeshComponent]()
+
+	const FCustomizationStreamHandle Handle = UCustomizationStreamingManager::RequestLoad(CustomizationComponent, CustomizationComponent, { Texture.ToSoftObjectPath() }, CustomizationComponent->GetCustomizationStreamPriority(),
+		FStreamableDelegate::CreateWeakLambda(WeakThis.Get(), [WeakThis, WeakCustomizationComponent, WeakSkeletalMeshComponent]()
 		{
 			if (!WeakThis.IsValid() || !WeakCustomizationComponent.IsValid() || !WeakSkeletalMeshComponent.IsValid())
 			{
@@ -506,13 +576,16 @@ bool UCustomizationAsset_TextureOverride::Apply(UCoreCustomizationComponent* Cus
 			WeakThis->OnTextureLoaded(WeakCustomizationComponent.Get(), WeakSkeletalMeshComponent.Get());
 		}));
 
-	if (Handle->HasLoadCompleted())
+	if (!Handle.IsValid())
 	{
-		OnTextureLoaded(CustomizationComponent, SkeletalMeshComponent);
+		return false;
 	}
-	else
+
+	CustomizationComponent->AddCustomizationStreamHandle(Handle);
+
+	if (UCustomizationStreamingManager::IsRequestComplete(CustomizationComponent, Handle))
 	{
-		CustomizationComponent->AddCustomizationStreamHandle(Handle);
+		OnTextureLoaded(CustomizationComponent, SkeletalMeshComponent);
 	}
 
 	return true;
@@ -585,14 +658,15 @@ void UCustomizationAsset_TextureOverride::OnTextureLoaded(UCoreCustomizationComp
 			continue;
 		}
 
-		UMaterialInstanceDynamic* MID = SkeletalMeshComponent->CreateDynamicMaterialInstance(Index);
+		//Every character wearing the same texture overrides on this material shares one instance instead of each creating its own.
+		UMaterialInterface* SharedMaterial = UCustomizationMergeManager::GetSharedTextureOverrideMaterial(SkeletalMeshComponent, MaterialInstance, TextureParamName, Texture.Get());
 
-		if (!MID)
+		if (!SharedMaterial)
 		{
 			continue;
 		}
 
-		MID->SetTextureParameterValue(TextureParamName, Texture.Get());
+		SkeletalMeshComponent->SetMaterial(Index, SharedMaterial);
 	}
 }
 
@@ -2,7 +2,7 @@
 
 
 #include "Character/Customization/MainMenuCustomizationComponent.h"
-#include "Engine/StreamableManager.h"
+#include "System/CustomizationStreamingManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Character/CoreCharacter.h"
 #include "Character/Customization/CustomizationObject.h"
@@ -51,17 +51,31 @@ void UMainMenuCustomizationComponent::UpdateCustomization()
 	}
 	CustomizationComponentList.Reset();
 
-	for (TSharedPtr<FStreamableHandle> Handle : CustomizationStreamableHandleList)
+	ReleaseCustomizationStreamHandles();
+
+	TArray<FSoftObjectPath> AssetList;
+	UCustomizationAsset::GetAssetListForCustomizationList(CustomizationList, AssetList);
+
+	//Everything is streamed in as a single request and applied together once it has loaded rather than blocking on each asset.
+	const FCustomizationStreamHandle Handle = UCustomizationStreamingManager::RequestLoad(this, this, AssetList, GetCustomizationStreamPriority(),
+		FStreamableDelegate::CreateUObject(this, &UMainMenuCustomizationComponent::OnCustomizationLoaded));
+
+	if (!Handle.IsValid())
 	{
-		if (!Handle.IsValid())
-		{
-			continue;
-		}
+		OnCustomizationLoaded();
+		return;
+	}
 
-		Handle->CancelHandle();
+	AddCustomizationStreamHandle(Handle);
+
+	if (UCustomizationStreamingManager::IsRequestComplete(this, Handle))
+	{
+		OnCustomizationLoaded();
 	}
-	CustomizationStreamableHandleList.Reset();
+}
 
+void UMainMenuCustomizationComponent::OnCustomizationLoaded()
+{
 	TMap<ECustomizationSlot, UCustomizationAsset*> CustomizationMap;
 	for (UCustomizationAsset* Customization : CustomizationList)
 	{
@@ -77,38 +91,7 @@ void UMainMenuCustomizationComponent::UpdateCustomization()
 	{
 		if (SkeletalMeshBodyComponents.Contains(Slot))
 		{
-			SkeletalMeshBodyComponents[Slot]->SetSkeletalMesh(CustomizationMap.Contains(Slot) ? CustomizationMap[Slot]->GetSkeletalMesh().LoadSynchronous() : nullptr);
-		}
-	}
-
-	for (ECustomizationSlot Slot : AccessorySlotList)
-	{
-		if (!CustomizationMap.Contains(Slot))
-		{
-			continue;
-		}
-
-		if (!CustomizationMap[Slot]->GetStaticMesh().IsNull())
-		{
-			CustomizationMap[Slot]->GetStaticMesh().LoadSynchronous();
-		}
-
-		if (!CustomizationMap[Slot]->GetMaterial().IsNull())
-		{
-			CustomizationMap[Slot]->GetStaticMesh().LoadSynchronous();
-		}
-
-		if (!CustomizationMap[Slot]->GetSkeletalMesh().IsNull())
-		{
-			CustomizationMap[Slot]->GetSkeletalMesh().LoadSynchronous();
-		}
-	}
-
-	for (ECustomizationSlot Slot : TextureSlotList)
-	{
-		if (CustomizationMap.Contains(Slot) && !CustomizationMap[Slot]->GetTexture().IsNull())
-		{
-			CustomizationMap[Slot]->GetTexture().LoadSynchronous();
+			SkeletalMeshBodyComponents[Slot]->SetSkeletalMesh(CustomizationMap.Contains(Slot) ? CustomizationMap[Slot]->GetSkeletalMesh().Get() : nullptr);
 		}
 	}
 
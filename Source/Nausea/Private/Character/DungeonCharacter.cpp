@@ -6,8 +6,10 @@
 #include "Camera/CameraComponent.h"
 #include "SkeletalMeshComponentBudgeted.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
 #include "Overlord/DungeonGameState.h"
 #include "Character/DungeonCharacterMovementComponent.h"
+#include "Character/HordeReplicationManager.h"
 
 #if WITH_EDITORONLY_DATA
 #include "Components/ArrowComponent.h"
@@ -83,9 +85,20 @@ void ADungeonCharacter::BeginPlay()
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		SpawnLocation = GetActorLocation();
+		UHordeReplicationManager::RegisterCharacter(this);
 	}
 }
 
+void ADungeonCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		UHordeReplicationManager::UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ADungeonCharacter::PreRegisterAllComponents()
 {
 	Super::PreRegisterAllComponents();
@@ -143,6 +156,16 @@ void ADungeonCharacter::PreRegisterAllComponents()
 	}
 }
 
+float ADungeonCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	return Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth) * UHordeReplicationManager::GetConnectionPriorityScale(this, Viewer);
+}
+
+bool ADungeonCharacter::IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer)
+{
+	return UHordeReplicationManager::IsReplicationPausedForViewer(this, ConnectionOwnerNetViewer.InViewer) || Super::IsReplicationPausedForConnection(ConnectionOwnerNetViewer);
+}
+
 void ADungeonCharacter::Died(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	if (bHasDied)
@@ -159,6 +182,12 @@ void ADungeonCharacter::Died(float Damage, struct FDamageEvent const& DamageEven
 		}
 	}
 
+	//Make sure the tear off is not held back by dormancy or a paused connection.
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		UHordeReplicationManager::UnregisterCharacter(this);
+	}
+
 	Super::Died(Damage, DamageEvent, EventInstigator, DamageCauser);
 }
 
@@ -0,0 +1,469 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "Character/HordeReplicationManager.h"
+#include "Nausea.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "Character/DungeonCharacter.h"
+#include "Gameplay/StatusComponent.h"
+#include "AI/CoreAIController.h"
+#include "AI/EnemySelectionComponent.h"
+#include "Overlord/DungeonGameState.h"
+
+DECLARE_STATS_GROUP(TEXT("HordeReplicationManager"), STATGROUP_HordeReplicationManager, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Horde Replication"), STAT_HordeReplicationEvaluate, STATGROUP_HordeReplicationManager);
+DECLARE_CYCLE_STAT(TEXT("Apply Connection Budgets"), STAT_HordeReplicationBudget, STATGROUP_HordeReplicationManager);
+
+UHordeReplicationManager::UHordeReplicationManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UHordeReplicationManager::Tick(float DeltaTime)
+{
+	TimeUntilEvaluation -= DeltaTime;
+
+	if (TimeUntilEvaluation > 0.f)
+	{
+		return;
+	}
+
+	TimeUntilEvaluation = EvaluationInterval;
+
+	SCOPE_CYCLE_COUNTER(STAT_HordeReplicationEvaluate);
+	CSV_SCOPED_TIMING_STAT(Nausea, HordeReplicationEvaluate);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	RemoveStaleEntries();
+	GatherViewers();
+
+	for (FHordeReplicationEntry& Entry : EntryList)
+	{
+		EvaluateEntry(Entry, CurrentTime);
+		UpdateDormancy(Entry, CurrentTime);
+	}
+
+	ApplyConnectionBudgets(CurrentTime);
+}
+
+inline UHordeReplicationManager* GetHordeReplicationManager(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ADungeonGameState* DungeonGameState = World->GetGameState<ADungeonGameState>();
+
+	if (!DungeonGameState)
+	{
+		return nullptr;
+	}
+
+	return DungeonGameState->GetHordeReplicationManager();
+}
+
+bool UHordeReplicationManager::RegisterCharacter(ADungeonCharacter* Character)
+{
+	if (!Character || Character->GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	//Only servers with remote connections have anything to manage.
+	const ENetMode NetMode = Character->GetNetMode();
+	if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+	{
+		return false;
+	}
+
+	UHordeReplicationManager* HordeReplicationManager = GetHordeReplicationManager(Character);
+
+	if (!HordeReplicationManager || HordeReplicationManager->EntryIndexMap.Contains(Character))
+	{
+		return false;
+	}
+
+	const int32 EntryIndex = HordeReplicationManager->EntryList.Emplace(Character, Character->GetWorld()->GetTimeSeconds());
+	HordeReplicationManager->EntryIndexMap.Add(Character, EntryIndex);
+
+	if (UStatusComponent* StatusComponent = Character->GetStatusComponent())
+	{
+		StatusComponent->OnDamageReceived.AddDynamic(HordeReplicationManager, &UHordeReplicationManager::OnCharacterDamageReceived);
+	}
+
+	return true;
+}
+
+void UHordeReplicationManager::UnregisterCharacter(ADungeonCharacter* Character)
+{
+	UHordeReplicationManager* HordeReplicationManager = GetHordeReplicationManager(Character);
+
+	if (!HordeReplicationManager)
+	{
+		return;
+	}
+
+	int32 EntryIndex = INDEX_NONE;
+	if (!HordeReplicationManager->EntryIndexMap.RemoveAndCopyValue(Character, EntryIndex))
+	{
+		return;
+	}
+
+	FHordeReplicationEntry& Entry = HordeReplicationManager->EntryList[EntryIndex];
+
+	if (Entry.bDormant)
+	{
+		HordeReplicationManager->SetEntryDormant(Entry, false);
+	}
+
+	if (UStatusComponent* StatusComponent = Character->GetStatusComponent())
+	{
+		StatusComponent->OnDamageReceived.RemoveDynamic(HordeReplicationManager, &UHordeReplicationManager::OnCharacterDamageReceived);
+	}
+
+	HordeReplicationManager->EntryList.RemoveAtSwap(EntryIndex, 1, false);
+
+	if (HordeReplicationManager->EntryList.IsValidIndex(EntryIndex))
+	{
+		HordeReplicationManager->EntryIndexMap.Add(HordeReplicationManager->EntryList[EntryIndex].Character.Get(), EntryIndex);
+	}
+}
+
+float UHordeReplicationManager::GetConnectionPriorityScale(const ADungeonCharacter* Character, const AActor* Viewer)
+{
+	UHordeReplicationManager* HordeReplicationManager = GetHordeReplicationManager(Character);
+
+	if (!HordeReplicationManager)
+	{
+		return 1.f;
+	}
+
+	const FHordeConnectionState* ConnectionState = HordeReplicationManager->FindConnectionState(Character, Viewer);
+	return ConnectionState ? ConnectionState->PriorityScale : 1.f;
+}
+
+bool UHordeReplicationManager::IsReplicationPausedForViewer(const ADungeonCharacter* Character, const AActor* Viewer)
+{
+	UHordeReplicationManager* HordeReplicationManager = GetHordeReplicationManager(Character);
+
+	if (!HordeReplicationManager)
+	{
+		return false;
+	}
+
+	const FHordeConnectionState* ConnectionState = HordeReplicationManager->FindConnectionState(Character, Viewer);
+	return ConnectionState && ConnectionState->bPaused;
+}
+
+void UHordeReplicationManager::OnCharacterDamageReceived(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	const int32* EntryIndex = Component ? EntryIndexMap.Find(Cast<ADungeonCharacter>(Component->GetOwner())) : nullptr;
+
+	if (!EntryIndex)
+	{
+		return;
+	}
+
+	FHordeReplicationEntry& Entry = EntryList[*EntryIndex];
+	Entry.LastDamageInstigator = EventInstigator;
+	Entry.LastDamageTime = GetWorld()->GetTimeSeconds();
+	Entry.LastActiveTime = Entry.LastDamageTime;
+
+	//Don't wait for the next evaluation to wake up, the damage needs to go out now.
+	if (Entry.bDormant)
+	{
+		SetEntryDormant(Entry, false);
+	}
+}
+
+void UHordeReplicationManager::RemoveStaleEntries()
+{
+	const int32 InitialCount = EntryList.Num();
+
+	//Dead characters have been torn off and no longer replicate.
+	EntryList.RemoveAllSwap([](const FHordeReplicationEntry& Entry)
+	{
+		const ADungeonCharacter* Character = Entry.Character.Get();
+		return !Character || Character->GetTearOff() || Character->IsDead();
+	}, false);
+
+	if (InitialCount == EntryList.Num())
+	{
+		return;
+	}
+
+	EntryIndexMap.Reset();
+	for (int32 Index = 0; Index < EntryList.Num(); Index++)
+	{
+		EntryIndexMap.Add(EntryList[Index].Character.Get(), Index);
+	}
+}
+
+void UHordeReplicationManager::GatherViewers()
+{
+	//Viewers keep their index for as long as they are connected so per connection state stays aligned with them.
+	for (int32 ViewerIndex = ViewerList.Num() - 1; ViewerIndex >= 0; ViewerIndex--)
+	{
+		const APlayerController* PlayerController = ViewerList[ViewerIndex].PlayerController;
+
+		if (IsValid(PlayerController) && PlayerController->GetNetConnection())
+		{
+			continue;
+		}
+
+		ViewerList.RemoveAt(ViewerIndex, 1, false);
+
+		for (FHordeReplicationEntry& Entry : EntryList)
+		{
+			if (Entry.ConnectionStateList.IsValidIndex(ViewerIndex))
+			{
+				Entry.ConnectionStateList.RemoveAt(ViewerIndex, 1, false);
+			}
+		}
+	}
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		APlayerController* PlayerController = Iterator->Get();
+
+		if (!PlayerController || PlayerController->IsLocalController() || !PlayerController->GetNetConnection())
+		{
+			continue;
+		}
+
+		if (ViewerList.ContainsByPredicate([PlayerController](const FHordeReplicationViewer& Viewer) { return Viewer.PlayerController == PlayerController; }))
+		{
+			continue;
+		}
+
+		ViewerList.Emplace(PlayerController);
+	}
+
+	ViewerIndexMap.Reset();
+	for (int32 ViewerIndex = 0; ViewerIndex < ViewerList.Num(); ViewerIndex++)
+	{
+		FHordeReplicationViewer& Viewer = ViewerList[ViewerIndex];
+		ViewerIndexMap.Add(Viewer.PlayerController, ViewerIndex);
+
+		FRotator ViewRotation;
+		Viewer.PlayerController->GetPlayerViewPoint(Viewer.ViewLocation, ViewRotation);
+		Viewer.ViewDirection = ViewRotation.Vector();
+		Viewer.Pawn = Viewer.PlayerController->GetPawn();
+	}
+}
+
+void UHordeReplicationManager::EvaluateEntry(FHordeReplicationEntry& Entry, float CurrentTime)
+{
+	ADungeonCharacter* Character = Entry.Character.Get();
+
+	if (!Character)
+	{
+		return;
+	}
+
+	const AActor* Enemy = nullptr;
+	if (const ACoreAIController* AIController = Cast<ACoreAIController>(Character->GetController()))
+	{
+		if (const UEnemySelectionComponent* EnemySelectionComponent = AIController->GetEnemySelectionComponent())
+		{
+			Enemy = EnemySelectionComponent->GetEnemy();
+		}
+	}
+
+	const bool bRecentlyDamaged = Entry.LastDamageTime >= 0.f && CurrentTime - Entry.LastDamageTime < CombatInvolvementTime;
+	const FVector Location = Character->GetActorLocation();
+
+	float DesiredNetUpdateFrequency = OffscreenNetUpdateFrequency;
+	bool bHasInterest = false;
+
+	Entry.ConnectionStateList.SetNum(ViewerList.Num());
+	for (int32 ViewerIndex = 0; ViewerIndex < ViewerList.Num(); ViewerIndex++)
+	{
+		const FHordeReplicationViewer& Viewer = ViewerList[ViewerIndex];
+		FHordeConnectionState& ConnectionState = Entry.ConnectionStateList[ViewerIndex];
+
+		const FVector ViewOffset = Location - Viewer.ViewLocation;
+		ConnectionState.Distance = ViewOffset.Size();
+		ConnectionState.bInView = ConnectionState.Distance < NearDistance || FVector::DotProduct(ViewOffset, Viewer.ViewDirection) > ViewConeCosine * ConnectionState.Distance;
+		ConnectionState.bInCombat = (Enemy && (Enemy == Viewer.Pawn || Enemy == Viewer.PlayerController))
+			|| (bRecentlyDamaged && Entry.LastDamageInstigator == Viewer.PlayerController);
+
+		const float DistanceAlpha = FMath::Clamp(FMath::GetRangePct(NearDistance, FarDistance, ConnectionState.Distance), 0.f, 1.f);
+
+		float PriorityScale = FMath::Lerp(1.f, MinDistancePriorityScale, DistanceAlpha);
+		float ViewerNetUpdateFrequency = OffscreenNetUpdateFrequency;
+
+		if (ConnectionState.bInView)
+		{
+			ViewerNetUpdateFrequency = FMath::Lerp(VisibleNetUpdateFrequency, OffscreenNetUpdateFrequency, DistanceAlpha);
+		}
+		else
+		{
+			PriorityScale *= OffscreenPriorityScale;
+		}
+
+		if (ConnectionState.bInCombat)
+		{
+			PriorityScale *= CombatPriorityScale;
+			ViewerNetUpdateFrequency = CombatNetUpdateFrequency;
+		}
+
+		ConnectionState.PriorityScale = PriorityScale;
+		DesiredNetUpdateFrequency = FMath::Max(DesiredNetUpdateFrequency, ViewerNetUpdateFrequency);
+		bHasInterest |= ConnectionState.bInView || ConnectionState.bInCombat;
+	}
+
+	//Update rate is shared by every connection so it follows whichever connection cares the most.
+	if (!FMath::IsNearlyEqual(Character->NetUpdateFrequency, DesiredNetUpdateFrequency))
+	{
+		Character->NetUpdateFrequency = DesiredNetUpdateFrequency;
+		Character->MinNetUpdateFrequency = FMath::Min(OffscreenNetUpdateFrequency, DesiredNetUpdateFrequency);
+	}
+
+	Entry.EstimatedBytesPerSecond = float(EstimatedUpdateBytes) * DesiredNetUpdateFrequency;
+
+	const bool bMoving = Character->GetVelocity().SizeSquared() > FMath::Square(IdleSpeedThreshold);
+	if (bMoving || bHasInterest || Enemy || bRecentlyDamaged)
+	{
+		Entry.LastActiveTime = CurrentTime;
+	}
+}
+
+void UHordeReplicationManager::UpdateDormancy(FHordeReplicationEntry& Entry, float CurrentTime)
+{
+	const bool bShouldBeDormant = CurrentTime - Entry.LastActiveTime >= DormancyDelay;
+
+	if (bShouldBeDormant != Entry.bDormant)
+	{
+		SetEntryDormant(Entry, bShouldBeDormant);
+	}
+}
+
+inline bool IsConnectionStateStarving(const FHordeConnectionState& ConnectionState, float CurrentTime, float MaxStarvationTime)
+{
+	return ConnectionState.bPaused && CurrentTime - ConnectionState.PausedTime >= MaxStarvationTime;
+}
+
+void UHordeReplicationManager::ApplyConnectionBudgets(float CurrentTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HordeReplicationBudget);
+	CSV_SCOPED_TIMING_STAT(Nausea, HordeReplicationBudget);
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const float NetTickRate = NetDriver ? float(NetDriver->NetServerMaxTickRate) : 30.f;
+	const float BudgetBytesPerSecond = float(MaxBytesPerConnectionPerFrame) * NetTickRate;
+
+	for (int32 ViewerIndex = 0; ViewerIndex < ViewerList.Num(); ViewerIndex++)
+	{
+		SortedEntryIndexList.Reset();
+		for (int32 EntryIndex = 0; EntryIndex < EntryList.Num(); EntryIndex++)
+		{
+			if (!EntryList[EntryIndex].bDormant && EntryList[EntryIndex].ConnectionStateList.IsValidIndex(ViewerIndex))
+			{
+				SortedEntryIndexList.Add(EntryIndex);
+			}
+		}
+
+		//Starving characters (and those still in their grace period) are budgeted first, everything else by priority.
+		auto IsProtected = [this, ViewerIndex, CurrentTime](int32 EntryIndex)
+		{
+			const FHordeConnectionState& ConnectionState = EntryList[EntryIndex].ConnectionStateList[ViewerIndex];
+			return IsConnectionStateStarving(ConnectionState, CurrentTime, MaxStarvationTime)
+				|| (!ConnectionState.bPaused && ConnectionState.UnpausedTime > 0.f && CurrentTime - ConnectionState.UnpausedTime < StarvationGraceTime);
+		};
+
+		SortedEntryIndexList.Sort([this, ViewerIndex, &IsProtected](int32 A, int32 B)
+		{
+			const bool bProtectedA = IsProtected(A);
+			const bool bProtectedB = IsProtected(B);
+
+			if (bProtectedA != bProtectedB)
+			{
+				return bProtectedA;
+			}
+
+			return EntryList[A].ConnectionStateList[ViewerIndex].PriorityScale > EntryList[B].ConnectionStateList[ViewerIndex].PriorityScale;
+		});
+
+		float SpentBytesPerSecond = 0.f;
+		for (int32 EntryIndex : SortedEntryIndexList)
+		{
+			const FHordeReplicationEntry& Entry = EntryList[EntryIndex];
+			FHordeConnectionState& ConnectionState = EntryList[EntryIndex].ConnectionStateList[ViewerIndex];
+
+			const bool bProtected = IsProtected(EntryIndex);
+			const bool bWithinBudget = SpentBytesPerSecond + Entry.EstimatedBytesPerSecond <= BudgetBytesPerSecond;
+			const bool bShouldPause = !bProtected && !bWithinBudget;
+
+			if (!bShouldPause)
+			{
+				SpentBytesPerSecond += Entry.EstimatedBytesPerSecond;
+			}
+
+			if (bShouldPause == ConnectionState.bPaused)
+			{
+				continue;
+			}
+
+			const bool bWasStarving = IsConnectionStateStarving(ConnectionState, CurrentTime, MaxStarvationTime);
+			ConnectionState.bPaused = bShouldPause;
+
+			if (bShouldPause)
+			{
+				ConnectionState.PausedTime = CurrentTime;
+			}
+			else
+			{
+				//Only characters let through due to starvation get a grace period.
+				ConnectionState.UnpausedTime = bWasStarving ? CurrentTime : 0.f;
+			}
+		}
+	}
+}
+
+void UHordeReplicationManager::SetEntryDormant(FHordeReplicationEntry& Entry, bool bDormant)
+{
+	Entry.bDormant = bDormant;
+
+	ADungeonCharacter* Character = Entry.Character.Get();
+
+	if (!Character)
+	{
+		return;
+	}
+
+	Character->SetNetDormancy(bDormant ? DORM_DormantAll : DORM_Awake);
+
+	if (bDormant)
+	{
+		return;
+	}
+
+	//Woken characters start unpaused everywhere so their first update isn't held back by stale budget state.
+	for (FHordeConnectionState& ConnectionState : Entry.ConnectionStateList)
+	{
+		ConnectionState.bPaused = false;
+	}
+}
+
+const FHordeConnectionState* UHordeReplicationManager::FindConnectionState(const ADungeonCharacter* Character, const AActor* Viewer) const
+{
+	const int32* EntryIndex = EntryIndexMap.Find(Character);
+	const int32* ViewerIndex = EntryIndex ? ViewerIndexMap.Find(Viewer) : nullptr;
+
+	if (!ViewerIndex)
+	{
+		return nullptr;
+	}
+
+	const TArray<FHordeConnectionState>& ConnectionStateList = EntryList[*EntryIndex].ConnectionStateList;
+	return ConnectionStateList.IsValidIndex(*ViewerIndex) ? &ConnectionStateList[*ViewerIndex] : nullptr;
+}
@@ -9,6 +9,9 @@
 #include "GameFramework/PlayerInput.h"
 #include "GameFramework/GameMode.h"
 #include "Components/AudioComponent.h"
+#include "Sound/SoundWave.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "NauseaNetDefines.h"
@@ -193,13 +196,13 @@ EVoiceRequestResponse UVoiceCommandComponent::CanRequestVoiceCommand(const FGame
 		return EVoiceRequestResponse::Muted;
 	}
 
-	if (VoiceTag != FGameplayTag::EmptyTag && !VoiceTag.GetGameplayTagParents().HasTag(UVoiceDataObject::VoiceParent))
+	if (VoiceTag != FGameplayTag::EmptyTag && !UVoiceDataObject::IsVoiceTag(VoiceTag))
 	{
 		//VoiceTag specified is not in the Voice hierarchy and so this is an invalid request.
 		return EVoiceRequestResponse::Invalid;
 	}
 
-	if (!IsNetMode(NM_DedicatedServer) && GetVoiceDataObject()->IsValidVoiceTag(VoiceTag))
+	if (!IsNetMode(NM_DedicatedServer) && !GetVoiceDataObject()->IsValidVoiceTag(VoiceTag))
 	{
 		return EVoiceRequestResponse::Invalid;
 	}
@@ -232,10 +235,10 @@ EVoiceRequestResponse UVoiceCommandComponent::PerformVoiceCommand(const FGamepla
 		return Response;
 	}
 
-	//Push the voice command out to all clients.
+	//Push the voice command out to all players that can hear it.
 	if (GetOwnerRole() == ROLE_Authority)
 	{
-		Multicast_Reliable_BroadcastVoiceCommand(VoiceTag);
+		QueueVoiceBroadcast(VoiceTag);
 	}
 
 	if (IsNetMode(NM_DedicatedServer))
@@ -243,7 +246,7 @@ EVoiceRequestResponse UVoiceCommandComponent::PerformVoiceCommand(const FGamepla
 		return EVoiceRequestResponse::Success;
 	}
 
-	USoundWave* VoiceSoundWave = GetVoiceSoundWave(VoiceTag);
+	const float VoiceDuration = GetVoiceDataObject()->GetVoiceDuration(VoiceTag, GetVoiceRandomFloat());
 	const bool bIsVoiceCommand = UVoiceDataObject::IsVoiceCommand(VoiceTag);
 
 	if (bIsVoiceCommand)
@@ -251,14 +254,15 @@ EVoiceRequestResponse UVoiceCommandComponent::PerformVoiceCommand(const FGamepla
 		PlayRadioVoice(VoiceTag);
 		const FString VoiceTagTitle = GetTitleForVoiceGameplayTag(VoiceTag).ToString();
 
-		//Find and locally send a client message with this radio call.
-		for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		//Locally send a client message with this radio call to each local player.
+		if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
 		{
-			APlayerController* PC = Iterator->Get();
-
-			if (PC && PC->IsLocalPlayerController())
+			for (ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
 			{
-				PC->ClientTeamMessage(GetOwningPlayerState(), VoiceTagTitle, NAME_VoiceCommand, 0.f);
+				if (APlayerController* PC = LocalPlayer ? LocalPlayer->GetPlayerController(GetWorld()) : nullptr)
+				{
+					PC->ClientTeamMessage(GetOwningPlayerState(), VoiceTagTitle, NAME_VoiceCommand, 0.f);
+				}
 			}
 		}
 	}
@@ -273,7 +277,7 @@ EVoiceRequestResponse UVoiceCommandComponent::PerformVoiceCommand(const FGamepla
 
 	CurrentVoiceGameplayTag = VoiceTag;
 
-	GetWorld()->GetTimerManager().SetTimer(VoiceTimerHandle, this, &UVoiceCommandComponent::OnVoicePlaybackCompleted, VoiceSoundWave ? VoiceSoundWave->GetDuration() : 1.f, false);
+	GetWorld()->GetTimerManager().SetTimer(VoiceTimerHandle, this, &UVoiceCommandComponent::OnVoicePlaybackCompleted, VoiceDuration > 0.f ? VoiceDuration : 1.f, false);
 
 	if (bIsVoiceCommand)
 	{
@@ -300,12 +304,12 @@ UVoiceDataObject* UVoiceCommandComponent::GetVoiceDataObject() const
 
 USoundWave* UVoiceCommandComponent::GetVoiceSoundWave(const FGameplayTag& VoiceTag) const
 {
-	if (!LoadedVoiceSoundWaveContainerMap.Contains(VoiceTag))
+	if (!HasValidVoiceDataObject())
 	{
 		return nullptr;
 	}
 
-	return LoadedVoiceSoundWaveContainerMap[VoiceTag]->GetSoundWave(GetVoiceRandomFloat());
+	return GetVoiceDataObject()->GetSoundWave(VoiceTag, GetVoiceRandomFloat());
 }
 
 bool UVoiceCommandComponent::IsVoiceCommandMenuBlockingInput() const
@@ -427,12 +431,110 @@ void UVoiceCommandComponent::Server_Reliable_RequestVoiceCommand_Implementation(
 	PerformVoiceCommand(VoiceTag);
 }
 
-void UVoiceCommandComponent::Multicast_Reliable_BroadcastVoiceCommand_Implementation(const FGameplayTag& VoiceTag)
+void UVoiceCommandComponent::Client_Unreliable_ReceiveVoiceCommand_Implementation(UVoiceCommandComponent* Speaker, const FGameplayTag& VoiceTag, uint8 Sequence)
+{
+	if (!Speaker)
+	{
+		return;
+	}
+
+	Speaker->ReceiveVoiceCommand(VoiceTag, Sequence);
+}
+
+void UVoiceCommandComponent::QueueVoiceBroadcast(const FGameplayTag& VoiceTag)
+{
+	//The sequence is assigned now so that a listen server host plays the same variation clients will once the broadcast goes out.
+	VoiceSequence++;
+	SetVoiceSequence(VoiceSequence);
+
+	const float TimeSinceLastBroadcast = GetWorld()->GetTimeSeconds() - LastBroadcastTime;
+
+	if (LastBroadcastTime < 0.f || TimeSinceLastBroadcast >= MinBroadcastInterval)
+	{
+		BroadcastVoiceCommand(VoiceTag, VoiceSequence);
+		return;
+	}
+
+	PendingBroadcastVoiceTag = VoiceTag;
+	PendingBroadcastSequence = VoiceSequence;
+
+	if (!GetWorld()->GetTimerManager().IsTimerActive(PendingBroadcastTimerHandle))
+	{
+		GetWorld()->GetTimerManager().SetTimer(PendingBroadcastTimerHandle, this, &UVoiceCommandComponent::FlushPendingVoiceBroadcast, MinBroadcastInterval - TimeSinceLastBroadcast, false);
+	}
+}
+
+void UVoiceCommandComponent::FlushPendingVoiceBroadcast()
 {
-	//Server has made a request to play a voice command.
-	//Regardless of who we are or whether we think we can perform this voice command, we need to move the seed forward to keep up with the FRandomStream.
-	GenerateVoiceRandomFloat();
+	if (!PendingBroadcastVoiceTag.IsValid())
+	{
+		return;
+	}
+
+	const FGameplayTag VoiceTag = PendingBroadcastVoiceTag;
+	PendingBroadcastVoiceTag = FGameplayTag::EmptyTag;
+	BroadcastVoiceCommand(VoiceTag, PendingBroadcastSequence);
+}
+
+void UVoiceCommandComponent::BroadcastVoiceCommand(const FGameplayTag& VoiceTag, uint8 Sequence)
+{
+	LastBroadcastTime = GetWorld()->GetTimeSeconds();
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		APlayerController* PC = Iterator->Get();
+
+		//Local players have already played this voice through UVoiceCommandComponent::PerformVoiceCommand.
+		if (!PC || PC->IsLocalController() || !CanPlayerHearVoice(PC, VoiceTag))
+		{
+			continue;
+		}
+
+		ACorePlayerState* ListenerPlayerState = PC->GetPlayerState<ACorePlayerState>();
+		UVoiceCommandComponent* ListenerVoiceCommandComponent = ListenerPlayerState ? ListenerPlayerState->GetVoiceCommandComponent() : nullptr;
+
+		if (!ListenerVoiceCommandComponent)
+		{
+			continue;
+		}
+
+		ListenerVoiceCommandComponent->Client_Unreliable_ReceiveVoiceCommand(this, VoiceTag, Sequence);
+	}
+}
+
+bool UVoiceCommandComponent::CanPlayerHearVoice(const APlayerController* Listener, const FGameplayTag& VoiceTag) const
+{
+	const ACorePlayerState* ListenerPlayerState = Listener->GetPlayerState<ACorePlayerState>();
+
+	if (!ListenerPlayerState)
+	{
+		return false;
+	}
+
+	if (ListenerPlayerState == GetOwningPlayerState())
+	{
+		return true;
+	}
 
+	//Voice commands are radio calls and are heard by the whole team regardless of distance.
+	if (UVoiceDataObject::IsVoiceCommand(VoiceTag) && ListenerPlayerState->GetGenericTeamId() == GetOwningPlayerState()->GetGenericTeamId())
+	{
+		return true;
+	}
+
+	const APawn* SpeakerPawn = GetOwningPawn();
+	const AActor* ListenerViewTarget = Listener->GetViewTarget();
+
+	if (!SpeakerPawn || !ListenerViewTarget)
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(SpeakerPawn->GetActorLocation(), ListenerViewTarget->GetActorLocation()) <= FMath::Square(VoiceAudibleDistance);
+}
+
+void UVoiceCommandComponent::ReceiveVoiceCommand(const FGameplayTag& VoiceTag, uint8 Sequence)
+{
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		return;
@@ -443,13 +545,13 @@ void UVoiceCommandComponent::Multicast_Reliable_BroadcastVoiceCommand_Implementa
 		return;
 	}
 
+	SetVoiceSequence(Sequence);
 	PerformVoiceCommand(VoiceTag);
 }
 
-void UVoiceCommandComponent::GenerateVoiceRandomFloat()
+void UVoiceCommandComponent::SetVoiceSequence(uint8 Sequence)
 {
-	VoiceRandomFloat = RandomVoiceSeed.FRand();
-	MARK_PROPERTY_DIRTY_FROM_NAME(UVoiceCommandComponent, RandomVoiceSeed, this);
+	VoiceRandomFloat = FRandomStream(int32(HashCombine(uint32(RandomVoiceSeed.GetInitialSeed()), uint32(Sequence)))).FRand();
 }
 
 float UVoiceCommandComponent::GetVoiceRandomFloat() const
@@ -567,6 +669,15 @@ static TMap<FGameplayTag, FText> VoiceCommandTextMap;
 static TSet<FGameplayTag> VoiceCommandTagSet;
 static TSet<FGameplayTag> VoiceEventTagSet;
 
+//Everything hot paths need to know about an individual voice tag, resolved once so they never walk the tag hierarchy.
+struct FVoiceTagInfo
+{
+	EVoicePriority Priority = EVoicePriority::Invalid;
+	bool bIsVoiceCommand = false;
+	bool bIsVoiceEvent = false;
+};
+static TMap<FGameplayTag, FVoiceTagInfo> VoiceTagInfoMap;
+
 TArray<FGameplayTag> UVoiceCommandComponent::GetVoiceCommandCategoryList()
 {
 	return VoiceCommandCategoryTagSet.Array();
@@ -660,6 +771,10 @@ UVoiceDataObject::UVoiceDataObject(const FObjectInitializer& ObjectInitializer)
 			VoiceCommandTagSet.Add(ChildTag);
 			VoiceCommandSoundWaveContainerClassMap.Add(ChildTag);
 
+			FVoiceTagInfo& VoiceTagInfo = VoiceTagInfoMap.FindOrAdd(ChildTag);
+			VoiceTagInfo.Priority = EVoicePriority::VoiceCommand;
+			VoiceTagInfo.bIsVoiceCommand = true;
+
 			ChildTagString = ChildTag.ToString();
 			ChildTagString.Split(".", nullptr, &ChildTagString, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
 
@@ -670,11 +785,29 @@ UVoiceDataObject::UVoiceDataObject(const FObjectInitializer& ObjectInitializer)
 
 	for (const FGameplayTag& CategoryTag : VoiceEventCategoryTagSet)
 	{
+		EVoicePriority CategoryPriority = EVoicePriority::Invalid;
+		if (ReactionHighPriorityCategoryTagSet.Contains(CategoryTag))
+		{
+			CategoryPriority = EVoicePriority::ReactionHighPriority;
+		}
+		else if (ReactionCategoryTagSet.Contains(CategoryTag))
+		{
+			CategoryPriority = EVoicePriority::Reaction;
+		}
+		else if (ReactionPassiveCategoryTagSet.Contains(CategoryTag))
+		{
+			CategoryPriority = EVoicePriority::ReactionPassive;
+		}
+
 		FGameplayTagContainer CategoryChildrenTag = UGameplayTagsManager::Get().RequestGameplayTagChildren(CategoryTag);
 		for (const FGameplayTag& ChildTag : CategoryChildrenTag)
 		{
 			VoiceEventTagSet.Add(ChildTag);
 			VoiceEventSoundWaveContainerClassMap.Add(ChildTag);
+
+			FVoiceTagInfo& VoiceTagInfo = VoiceTagInfoMap.FindOrAdd(ChildTag);
+			VoiceTagInfo.Priority = CategoryPriority;
+			VoiceTagInfo.bIsVoiceEvent = true;
 		}
 	}
 
@@ -743,6 +876,29 @@ void UVoiceDataObject::Serialize(FArchive& Ar)
 		return;
 	}
 
+	RebuildSoundWaveContainerMaps();
+
+	Super::Serialize(Ar);
+}
+
+#if WITH_EDITOR
+void UVoiceDataObject::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) || GetNameSafe(GetClass()).StartsWith("REINST"))
+	{
+		return;
+	}
+
+	//Baked once per save here rather than in Serialize, which runs for every saving archive and must not load packages.
+	RebuildSoundWaveContainerMaps();
+	BuildVoiceLineTable(true);
+}
+#endif // WITH_EDITOR
+
+void UVoiceDataObject::RebuildSoundWaveContainerMaps()
+{
 	VoiceCommandSoundWaveContainerMap.Reset();
 	auto AssignToVoiceCommandMap = [this](const FGameplayTag& Tag, USoundWaveContainer* VoiceContainer)
 	{
@@ -768,7 +924,7 @@ void UVoiceDataObject::Serialize(FArchive& Ar)
 	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Direction.MoveUp", true), MoveUp);
 	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Direction.MoveDown", true), MoveDown);
 	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Direction.MoveIn", true), MoveIn);
-	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Direction.MoveDown", true), MoveOut);
+	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Direction.MoveOut", true), MoveOut);
 
 	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Insult.InsultAlly", true), InsultAlly);
 	AssignToVoiceCommandMap(FGameplayTag::RequestGameplayTag("Voice.Insult.InsultEnemy", true), InsultEnemy);
@@ -799,8 +955,6 @@ void UVoiceDataObject::Serialize(FArchive& Ar)
 	AssignToVoiceEventMap(FGameplayTag::RequestGameplayTag("Voice.Status.Burned", true), Burned);
 	AssignToVoiceEventMap(FGameplayTag::RequestGameplayTag("Voice.Status.LowHealth", true), LowHealth);
 	AssignToVoiceEventMap(FGameplayTag::RequestGameplayTag("Voice.Status.NearDeath", true), NearDeath);
-
-	Super::Serialize(Ar);
 }
 
 bool UVoiceDataObject::IsValidVoiceTag(const FGameplayTag& Request) const
@@ -810,38 +964,31 @@ bool UVoiceDataObject::IsValidVoiceTag(const FGameplayTag& Request) const
 		return true;
 	}
 
-	if (!VoiceCommandSoundWaveContainerMap.Contains(Request) && !VoiceEventSoundWaveContainerMap.Contains(Request))
-	{
-		return false;
-	}
-
-	return true;
+	return VoiceLineRangeMap.Contains(Request);
 }
 
-
 USoundWave* UVoiceDataObject::GetSoundWave(const FGameplayTag& Request, float Random) const
 {
-	if (VoiceCommandSoundWaveContainerMap.Contains(Request))
-	{
-		if (!VoiceCommandSoundWaveContainerMap[Request])
-		{
-			return nullptr;
-		}
+	const FVoiceLineEntry* VoiceLine = FindVoiceLine(Request, Random);
+	return VoiceLine ? VoiceLine->SoundWave.Get() : nullptr;
+}
 
-		return VoiceCommandSoundWaveContainerMap[Request]->GetSoundWave(Random);
-	}
+float UVoiceDataObject::GetVoiceDuration(const FGameplayTag& Request, float Random) const
+{
+	const FVoiceLineEntry* VoiceLine = FindVoiceLine(Request, Random);
 
-	if (VoiceEventSoundWaveContainerMap.Contains(Request))
+	if (!VoiceLine)
 	{
-		if (!VoiceEventSoundWaveContainerMap[Request])
-		{
-			return nullptr;
-		}
+		return -1.f;
+	}
 
-		return VoiceEventSoundWaveContainerMap[Request]->GetSoundWave(Random);
+	if (VoiceLine->Duration > 0.f)
+	{
+		return VoiceLine->Duration;
 	}
 
-	return nullptr;
+	const USoundWave* SoundWave = VoiceLine->SoundWave.Get();
+	return SoundWave ? SoundWave->GetDuration() : -1.f;
 }
 
 void UVoiceDataObject::LoadSoundWaveContainers()
@@ -853,28 +1000,35 @@ void UVoiceDataObject::LoadSoundWaveContainers()
 
 	bHasLoadedSoundContainers = true;
 
-	TArray<USoundWaveContainer*> Containers;
-	VoiceCommandSoundWaveContainerMap.GenerateValueArray(Containers);
-	for (USoundWaveContainer* Container : Containers)
+	//Assets saved before the voice line table existed will not have it serialized.
+	if (VoiceLineList.Num() == 0)
 	{
-		if (!Container)
-		{
-			continue;
-		}
-
-		Container->LoadSoundWaveContainer();
+		BuildVoiceLineTable();
 	}
 
-	Containers.Reset();
-	VoiceEventSoundWaveContainerMap.GenerateValueArray(Containers);
-	for (USoundWaveContainer* Container : Containers)
+	TArray<FSoftObjectPath> PriorityVoiceLinePathList;
+	TArray<FSoftObjectPath> VoiceLinePathList;
+	for (const TPair<FGameplayTag, FVoiceLineRange>& Entry : VoiceLineRangeMap)
 	{
-		if (!Container)
+		const bool bIsPriorityVoiceLine = IsVoiceEvent(Entry.Key) && GetPriorityOfVoiceTag(Entry.Key) >= EVoicePriority::Reaction;
+		TArray<FSoftObjectPath>& PathList = bIsPriorityVoiceLine ? PriorityVoiceLinePathList : VoiceLinePathList;
+
+		for (int32 Index = Entry.Value.StartIndex; Index < Entry.Value.StartIndex + Entry.Value.Count; Index++)
 		{
-			continue;
+			PathList.Add(VoiceLineList[Index].SoundWave.ToSoftObjectPath());
 		}
+	}
 
-		Container->LoadSoundWaveContainer();
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+
+	if (PriorityVoiceLinePathList.Num() > 0)
+	{
+		PriorityVoiceLineHandle = StreamableManager.RequestAsyncLoad(MoveTemp(PriorityVoiceLinePathList), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	if (VoiceLinePathList.Num() > 0)
+	{
+		VoiceLineHandle = StreamableManager.RequestAsyncLoad(MoveTemp(VoiceLinePathList), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
 	}
 }
 
@@ -885,156 +1039,139 @@ void UVoiceDataObject::UnloadSoundWaveContainers()
 		return;
 	}
 
-	TArray<USoundWaveContainer*> Containers;
-	VoiceCommandSoundWaveContainerMap.GenerateValueArray(Containers);
-	for (USoundWaveContainer* Container : Containers)
+	auto ReleaseHandle = [](TSharedPtr<FStreamableHandle>& Handle)
 	{
-		if (!Container)
+		if (!Handle.IsValid())
 		{
-			continue;
+			return;
 		}
 
-		Container->UnloadSoundWaveContainer();
-	}
-
-	Containers.Reset();
-	VoiceEventSoundWaveContainerMap.GenerateValueArray(Containers);
-	for (USoundWaveContainer* Container : Containers)
-	{
-		if (!Container)
+		if (Handle->IsLoadingInProgress())
 		{
-			continue;
+			Handle->CancelHandle();
 		}
 
-		Container->UnloadSoundWaveContainer();
-	}
+		Handle.Reset();
+	};
+
+	ReleaseHandle(PriorityVoiceLineHandle);
+	ReleaseHandle(VoiceLineHandle);
 
 	bHasLoadedSoundContainers = false;
 }
 
-
-bool UVoiceDataObject::IsVoiceCommand(const FGameplayTag& VoiceTag)
+void UVoiceDataObject::BuildVoiceLineTable(bool bBakeDurations)
 {
-	return VoiceCommandCategoryTagSet.Contains(VoiceTag.RequestDirectParent());
-}
+	VoiceLineList.Reset();
+	VoiceLineRangeMap.Reset();
 
-bool UVoiceDataObject::IsVoiceEvent(const FGameplayTag& VoiceTag)
-{
-	return VoiceEventCategoryTagSet.Contains(VoiceTag.RequestDirectParent());
-}
+	auto AppendVoiceLines = [this, bBakeDurations](const TMap<FGameplayTag, USoundWaveContainer*>& ContainerMap)
+	{
+		for (const TPair<FGameplayTag, USoundWaveContainer*>& Entry : ContainerMap)
+		{
+			if (!Entry.Key.IsValid() || !Entry.Value)
+			{
+				continue;
+			}
 
-EVoicePriority UVoiceDataObject::GetPriorityOfVoiceTag(const FGameplayTag& VoiceTag)
-{
-	FGameplayTag RequestParentTag = VoiceTag.RequestDirectParent();
+			FVoiceLineRange Range;
+			Range.StartIndex = VoiceLineList.Num();
 
-	if (VoiceCommandCategoryTagSet.Contains(RequestParentTag))
-	{
-		return EVoicePriority::VoiceCommand;
-	}
+			const TArray<TSoftObjectPtr<USoundWave>>& SoundWaveList = Entry.Value->GetSoundWaveList();
+			for (int32 Index = 0; Index < SoundWaveList.Num(); Index++)
+			{
+				const float Weight = Entry.Value->GetSoundWaveWeight(Index);
 
-	if (ReactionHighPriorityCategoryTagSet.Contains(RequestParentTag))
-	{
-		return EVoicePriority::ReactionHighPriority;
-	}
+				if (SoundWaveList[Index].IsNull() || Weight <= 0.f)
+				{
+					continue;
+				}
 
-	if (ReactionCategoryTagSet.Contains(RequestParentTag))
-	{
-		return EVoicePriority::Reaction;
-	}
-	
-	if (ReactionPassiveCategoryTagSet.Contains(RequestParentTag))
-	{
-		return EVoicePriority::ReactionPassive;
-	}
+				Range.TotalWeight += Weight;
 
-	return EVoicePriority::Invalid;
-}
+				FVoiceLineEntry& VoiceLine = VoiceLineList.AddDefaulted_GetRef();
+				VoiceLine.SoundWave = SoundWaveList[Index];
+				VoiceLine.CumulativeWeight = Range.TotalWeight;
 
-USoundWaveContainer::USoundWaveContainer(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer)
-{
+				//Durations are baked in when saving in the editor. Otherwise only already loaded waves can provide one.
+#if WITH_EDITOR
+				const USoundWave* SoundWave = bBakeDurations ? SoundWaveList[Index].LoadSynchronous() : SoundWaveList[Index].Get();
+#else
+				const USoundWave* SoundWave = SoundWaveList[Index].Get();
+#endif // WITH_EDITOR
+				VoiceLine.Duration = SoundWave ? SoundWave->GetDuration() : -1.f;
+			}
 
-}
+			Range.Count = VoiceLineList.Num() - Range.StartIndex;
 
-USoundWave* USoundWaveContainer::GetSoundWave(float Random) const
-{
-	if (LoadedSoundWaveList.Num() == 0)
-	{
-		return nullptr;
-	}
+			if (Range.Count > 0)
+			{
+				VoiceLineRangeMap.Add(Entry.Key, Range);
+			}
+		}
+	};
 
-	return LoadedSoundWaveList[FMath::RoundToInt(float(LoadedSoundWaveList.Num() - 1) * Random)];
+	AppendVoiceLines(VoiceCommandSoundWaveContainerMap);
+	AppendVoiceLines(VoiceEventSoundWaveContainerMap);
 }
 
-bool USoundWaveContainer::LoadSoundWaveContainer()
+const FVoiceLineEntry* UVoiceDataObject::FindVoiceLine(const FGameplayTag& Request, float Random) const
 {
-	UAssetManager* AssetManager = UAssetManager::GetIfValid();
+	const FVoiceLineRange* Range = VoiceLineRangeMap.Find(Request);
 
-	if (!AssetManager)
+	if (!Range || Range->Count <= 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("USoundWaveContainer::LoadSoundWaveList failed to load map sound wave list due to missing asset manager."));
-		return false;
+		return nullptr;
 	}
 
-	TArray<FSoftObjectPath> SoundSoftObjectPathList;
-	for (const TSoftObjectPtr<USoundWave>& SoundWaveSoftObject : SoundWaveList)
+	//Find the first entry whose cumulative weight reaches the target.
+	const float TargetWeight = FMath::Clamp(Random, 0.f, 1.f) * Range->TotalWeight;
+	int32 LowIndex = Range->StartIndex;
+	int32 HighIndex = Range->StartIndex + Range->Count - 1;
+	while (LowIndex < HighIndex)
 	{
-		SoundSoftObjectPathList.Add(SoundWaveSoftObject.ToSoftObjectPath());
-	}
+		const int32 MidIndex = (LowIndex + HighIndex) / 2;
 
-	FStreamableManager& StreamableManager = AssetManager->GetStreamableManager();
-	StreamableHandle = StreamableManager.RequestAsyncLoad(SoundSoftObjectPathList);
-
-	if (!StreamableHandle.IsValid())
-	{
-		return false;
-	}
-
-	TWeakObjectPtr<USoundWaveContainer> WeakThis = TWeakObjectPtr<USoundWaveContainer>(this);
-
-	if (StreamableHandle->HasLoadCompleted())
-	{
-		LoadComplete();
-		return true;
-	}
-
-	auto StreamClassCompleteDelegate = [WeakThis] {
-		if (!WeakThis.IsValid())
+		if (VoiceLineList[MidIndex].CumulativeWeight < TargetWeight)
 		{
-			return;
+			LowIndex = MidIndex + 1;
+		}
+		else
+		{
+			HighIndex = MidIndex;
 		}
+	}
 
-		WeakThis->LoadComplete();
-	};
+	return &VoiceLineList[LowIndex];
+}
 
-	StreamableHandle->BindCompleteDelegate(FStreamableDelegate::CreateWeakLambda(this, StreamClassCompleteDelegate));
-	return true;
+bool UVoiceDataObject::IsVoiceCommand(const FGameplayTag& VoiceTag)
+{
+	const FVoiceTagInfo* VoiceTagInfo = VoiceTagInfoMap.Find(VoiceTag);
+	return VoiceTagInfo && VoiceTagInfo->bIsVoiceCommand;
 }
 
-void USoundWaveContainer::LoadComplete()
+bool UVoiceDataObject::IsVoiceEvent(const FGameplayTag& VoiceTag)
 {
-	LoadedSoundWaveList.Reserve(SoundWaveList.Num());
-	for (const TSoftObjectPtr<USoundWave>& SoundWaveSoftObject : SoundWaveList)
-	{
-		LoadedSoundWaveList.Add(SoundWaveSoftObject.Get());
-	}
+	const FVoiceTagInfo* VoiceTagInfo = VoiceTagInfoMap.Find(VoiceTag);
+	return VoiceTagInfo && VoiceTagInfo->bIsVoiceEvent;
 }
 
-bool USoundWaveContainer::UnloadSoundWaveContainer()
+bool UVoiceDataObject::IsVoiceTag(const FGameplayTag& VoiceTag)
 {
-	LoadedSoundWaveList.Empty();
+	return VoiceTagInfoMap.Contains(VoiceTag);
+}
 
-	if (StreamableHandle.IsValid())
-	{
-		if (StreamableHandle->IsLoadingInProgress())
-		{
-			StreamableHandle->CancelHandle();
-		}
+EVoicePriority UVoiceDataObject::GetPriorityOfVoiceTag(const FGameplayTag& VoiceTag)
+{
+	const FVoiceTagInfo* VoiceTagInfo = VoiceTagInfoMap.Find(VoiceTag);
+	return VoiceTagInfo ? VoiceTagInfo->Priority : EVoicePriority::Invalid;
+}
 
-		StreamableHandle.Reset();
-	}
+USoundWaveContainer::USoundWaveContainer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
 
-	return true;
 }
 
 /*
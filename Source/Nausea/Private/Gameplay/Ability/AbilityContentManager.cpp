@@ -0,0 +1,374 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "Gameplay/Ability/AbilityContentManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "GameFramework/Pawn.h"
+#include "System/CoreGameState.h"
+#include "Gameplay/AbilityComponent.h"
+#include "AI/RoutineManagerComponent.h"
+#include "AI/RoutineManager/Routine.h"
+
+DEFINE_LOG_CATEGORY(LogAbilityContent);
+
+UAbilityContentManager::UAbilityContentManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UAbilityContentManager::BeginDestroy()
+{
+	for (TPair<TSubclassOf<UAbilityInfo>, FAbilityContentEntry>& Entry : AbilityContentMap)
+	{
+		if (Entry.Value.Handle.IsValid())
+		{
+			Entry.Value.Handle->CancelHandle();
+		}
+	}
+
+	AbilityContentMap.Empty();
+	QueuedAbilityList.Empty();
+	InFlightRequestCount = 0;
+
+	Super::BeginDestroy();
+}
+
+inline UAbilityContentManager* GetAbilityContentManager(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ACoreGameState* CoreGameState = World->GetGameState<ACoreGameState>();
+
+	if (!CoreGameState)
+	{
+		return nullptr;
+	}
+
+	return CoreGameState->GetAbilityContentManager();
+}
+
+//Components added in blueprint are not present on the class default object and need to be found through the construction script.
+template<class TComponentClass>
+inline const TComponentClass* FindDefaultComponentTemplate(TSubclassOf<AActor> ActorClass)
+{
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	const TComponentClass* ComponentTemplate = ActorClass->GetDefaultObject<AActor>()->FindComponentByClass<TComponentClass>();
+
+	for (UClass* Class = ActorClass; !ComponentTemplate && Class; Class = Class->GetSuperClass())
+	{
+		const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Class);
+
+		if (!BlueprintClass || !BlueprintClass->SimpleConstructionScript)
+		{
+			continue;
+		}
+
+		for (const USCS_Node* Node : BlueprintClass->SimpleConstructionScript->GetAllNodes())
+		{
+			ComponentTemplate = Node ? Cast<TComponentClass>(Node->ComponentTemplate) : nullptr;
+
+			if (ComponentTemplate)
+			{
+				break;
+			}
+		}
+	}
+
+	return ComponentTemplate;
+}
+
+int32 UAbilityContentManager::PreloadCharacterAbilities(const UObject* WorldContextObject, TSubclassOf<AActor> CharacterClass)
+{
+	UAbilityContentManager* AbilityContentManager = GetAbilityContentManager(WorldContextObject);
+
+	if (!AbilityContentManager)
+	{
+		return 0;
+	}
+
+	TArray<TSubclassOf<UAbilityInfo>> AbilityClassList;
+	GetCharacterAbilityClassList(CharacterClass, AbilityClassList);
+
+	for (TSubclassOf<UAbilityInfo> AbilityClass : AbilityClassList)
+	{
+		AbilityContentManager->FindOrQueueEntry(AbilityClass, false);
+	}
+
+	AbilityContentManager->DispatchQueuedRequests();
+	return AbilityClassList.Num();
+}
+
+bool UAbilityContentManager::PreloadAbility(const UObject* WorldContextObject, TSubclassOf<UAbilityInfo> AbilityClass)
+{
+	if (!AbilityClass)
+	{
+		return false;
+	}
+
+	UAbilityContentManager* AbilityContentManager = GetAbilityContentManager(WorldContextObject);
+
+	if (!AbilityContentManager)
+	{
+		return false;
+	}
+
+	AbilityContentManager->FindOrQueueEntry(AbilityClass, false);
+	AbilityContentManager->DispatchQueuedRequests();
+	return true;
+}
+
+bool UAbilityContentManager::RequestAbilityContent(UAbilityComponent* AbilityComponent, TSubclassOf<UAbilityInfo> AbilityClass)
+{
+	if (!AbilityComponent || !AbilityClass)
+	{
+		return false;
+	}
+
+	UAbilityContentManager* AbilityContentManager = GetAbilityContentManager(AbilityComponent);
+
+	if (!AbilityContentManager)
+	{
+		return false;
+	}
+
+	FAbilityContentEntry& Entry = AbilityContentManager->FindOrQueueEntry(AbilityClass, true);
+
+	if (Entry.State == EAbilityContentState::Loaded)
+	{
+		AbilityComponent->OnAbilityContentLoaded(AbilityClass);
+		return true;
+	}
+
+	Entry.NotReadyCount++;
+	Entry.PendingComponentList.AddUnique(AbilityComponent);
+	UE_LOG(LogAbilityContent, Log, TEXT("Ability %s was initialized on %s while its content was still %s."),
+		*GetNameSafe(AbilityClass), *AbilityComponent->GetPathName(), Entry.State == EAbilityContentState::Queued ? TEXT("queued") : TEXT("loading"));
+
+	AbilityContentManager->DispatchQueuedRequests();
+	return true;
+}
+
+void UAbilityContentManager::GetAbilityContentAssetList(TSubclassOf<UAbilityInfo> AbilityClass, TArray<FSoftObjectPath>& AssetList)
+{
+	const UAbilityInfo* AbilityCDO = AbilityClass.GetDefaultObject();
+
+	if (!AbilityCDO)
+	{
+		return;
+	}
+
+	//Decal materials are hard references of the decal class so they come in with it.
+	const FSoftObjectPath ContentPathList[] = {
+		AbilityCDO->GetAbilityDecalClass().ToSoftObjectPath(),
+		AbilityCDO->GetAbilityCastAnimMontage().ToSoftObjectPath(),
+		AbilityCDO->GetAbilityActivationAnimMontage().ToSoftObjectPath() };
+
+	for (const FSoftObjectPath& ContentPath : ContentPathList)
+	{
+		if (!ContentPath.IsNull())
+		{
+			AssetList.AddUnique(ContentPath);
+		}
+	}
+}
+
+void UAbilityContentManager::GetCharacterAbilityClassList(TSubclassOf<AActor> CharacterClass, TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList)
+{
+	if (!CharacterClass)
+	{
+		return;
+	}
+
+	if (const UAbilityComponent* AbilityComponentTemplate = FindDefaultComponentTemplate<UAbilityComponent>(CharacterClass))
+	{
+		for (TSubclassOf<UAbilityInfo> AbilityClass : AbilityComponentTemplate->GetAbilityClassList())
+		{
+			if (AbilityClass)
+			{
+				AbilityClassList.AddUnique(AbilityClass);
+			}
+		}
+	}
+
+	const APawn* PawnCDO = Cast<APawn>(CharacterClass->GetDefaultObject());
+
+	if (!PawnCDO || !PawnCDO->AIControllerClass)
+	{
+		return;
+	}
+
+	const URoutineManagerComponent* RoutineManagerTemplate = FindDefaultComponentTemplate<URoutineManagerComponent>(PawnCDO->AIControllerClass.Get());
+
+	if (!RoutineManagerTemplate || !RoutineManagerTemplate->GetDefaultRoutineClass())
+	{
+		return;
+	}
+
+	RoutineManagerTemplate->GetDefaultRoutineClass().GetDefaultObject()->AppendAbilityClassList(AbilityClassList);
+}
+
+bool UAbilityContentManager::IsAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass) const
+{
+	const FAbilityContentEntry* Entry = AbilityContentMap.Find(AbilityClass);
+	return Entry && Entry->State == EAbilityContentState::Loaded;
+}
+
+float UAbilityContentManager::GetAbilityLoadLatency(TSubclassOf<UAbilityInfo> AbilityClass) const
+{
+	const FAbilityContentEntry* Entry = AbilityContentMap.Find(AbilityClass);
+
+	if (!Entry || Entry->State != EAbilityContentState::Loaded)
+	{
+		return -1.f;
+	}
+
+	return float(Entry->CompleteTime - Entry->RequestTime);
+}
+
+int32 UAbilityContentManager::GetAbilityNotReadyCount(TSubclassOf<UAbilityInfo> AbilityClass) const
+{
+	const FAbilityContentEntry* Entry = AbilityContentMap.Find(AbilityClass);
+	return Entry ? Entry->NotReadyCount : 0;
+}
+
+FAbilityContentEntry& UAbilityContentManager::FindOrQueueEntry(TSubclassOf<UAbilityInfo> AbilityClass, bool bHighPriority)
+{
+	auto GetHighPriorityInsertIndex = [this]()
+	{
+		int32 InsertIndex = 0;
+		while (InsertIndex < QueuedAbilityList.Num() && AbilityContentMap.FindChecked(QueuedAbilityList[InsertIndex]).bHighPriority)
+		{
+			InsertIndex++;
+		}
+		return InsertIndex;
+	};
+
+	if (FAbilityContentEntry* ExistingEntry = AbilityContentMap.Find(AbilityClass))
+	{
+		//A component needs this ability now so move it ahead of any preloads still waiting on a request slot.
+		if (bHighPriority && !ExistingEntry->bHighPriority && ExistingEntry->State == EAbilityContentState::Queued)
+		{
+			QueuedAbilityList.Remove(AbilityClass);
+			QueuedAbilityList.Insert(AbilityClass, GetHighPriorityInsertIndex());
+			ExistingEntry->bHighPriority = true;
+		}
+
+		return *ExistingEntry;
+	}
+
+	const int32 InsertIndex = bHighPriority ? GetHighPriorityInsertIndex() : QueuedAbilityList.Num();
+
+	FAbilityContentEntry& Entry = AbilityContentMap.Add(AbilityClass);
+	Entry.RequestTime = FPlatformTime::Seconds();
+	Entry.bHighPriority = bHighPriority;
+	QueuedAbilityList.Insert(AbilityClass, InsertIndex);
+	return Entry;
+}
+
+void UAbilityContentManager::DispatchQueuedRequests()
+{
+	const int32 MaxRequests = FMath::Max(MaxInFlightRequests, 1);
+
+	while (QueuedAbilityList.Num() > 0 && InFlightRequestCount < MaxRequests)
+	{
+		const TSubclassOf<UAbilityInfo> AbilityClass = QueuedAbilityList[0];
+		QueuedAbilityList.RemoveAt(0, 1, false);
+
+		FAbilityContentEntry* Entry = AbilityContentMap.Find(AbilityClass);
+
+		if (!Entry || Entry->State != EAbilityContentState::Queued)
+		{
+			continue;
+		}
+
+		DispatchRequest(AbilityClass, *Entry);
+	}
+}
+
+bool UAbilityContentManager::DispatchRequest(TSubclassOf<UAbilityInfo> AbilityClass, FAbilityContentEntry& Entry)
+{
+	Entry.DispatchTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> AssetList;
+	GetAbilityContentAssetList(AbilityClass, AssetList);
+
+	if (AssetList.Num() == 0)
+	{
+		CompleteEntry(AbilityClass, Entry);
+		return false;
+	}
+
+	//Marked as in flight before the request is made in case the streamable manager completes it immediately.
+	Entry.State = EAbilityContentState::Loading;
+	InFlightRequestCount++;
+
+	const TAsyncLoadPriority Priority = Entry.bHighPriority ? FStreamableManager::AsyncLoadHighPriority : FStreamableManager::DefaultAsyncLoadPriority;
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetList),
+		FStreamableDelegate::CreateUObject(this, &UAbilityContentManager::OnAbilityContentLoaded, AbilityClass), Priority);
+
+	//Entry may have been relocated if the request completed immediately and notified a component that queued more content.
+	FAbilityContentEntry& RequestEntry = AbilityContentMap.FindChecked(AbilityClass);
+
+	if (!Handle.IsValid())
+	{
+		if (RequestEntry.State == EAbilityContentState::Loading)
+		{
+			InFlightRequestCount = FMath::Max(InFlightRequestCount - 1, 0);
+			CompleteEntry(AbilityClass, RequestEntry);
+		}
+
+		return false;
+	}
+
+	RequestEntry.Handle = Handle;
+	return true;
+}
+
+void UAbilityContentManager::OnAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass)
+{
+	FAbilityContentEntry* Entry = AbilityContentMap.Find(AbilityClass);
+
+	if (!Entry || Entry->State != EAbilityContentState::Loading)
+	{
+		return;
+	}
+
+	InFlightRequestCount = FMath::Max(InFlightRequestCount - 1, 0);
+	CompleteEntry(AbilityClass, *Entry);
+	DispatchQueuedRequests();
+}
+
+void UAbilityContentManager::CompleteEntry(TSubclassOf<UAbilityInfo> AbilityClass, FAbilityContentEntry& Entry)
+{
+	Entry.State = EAbilityContentState::Loaded;
+	Entry.CompleteTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogAbilityContent, Log, TEXT("Ability %s content resident %.3fs after request (%.3fs queued, %i components waited on it)."),
+		*GetNameSafe(AbilityClass), Entry.CompleteTime - Entry.RequestTime, Entry.DispatchTime - Entry.RequestTime, Entry.NotReadyCount);
+
+	//Notifying a component can queue more content so move the pending list out before walking it.
+	const TArray<TWeakObjectPtr<UAbilityComponent>> PendingComponentList = MoveTemp(Entry.PendingComponentList);
+	Entry.PendingComponentList.Reset();
+
+	for (const TWeakObjectPtr<UAbilityComponent>& AbilityComponent : PendingComponentList)
+	{
+		if (AbilityComponent.IsValid())
+		{
+			AbilityComponent->OnAbilityContentLoaded(AbilityClass);
+		}
+	}
+}
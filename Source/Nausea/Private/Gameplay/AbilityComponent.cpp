@@ -8,6 +8,7 @@
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
 #include "Gameplay/Ability/AbilityDecalComponent.h"
+#include "Gameplay/Ability/AbilityContentManager.h"
 #include "Character/CoreCharacter.h"
 #include "Gameplay/StatusComponent.h"
 #include "Gameplay/Ability/AbilityAction.h"
@@ -401,6 +402,31 @@ void UAbilityComponent::OnAbilitySoftObjectLoadComplete(UObject* Object)
 	LoadedObjectSet.Add(Object);
 }
 
+void UAbilityComponent::OnAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass)
+{
+	const UAbilityInfo* AbilityCDO = AbilityClass.GetDefaultObject();
+
+	if (!AbilityCDO)
+	{
+		return;
+	}
+
+	if (UClass* DecalClass = AbilityCDO->GetAbilityDecalClass().Get())
+	{
+		LoadedClassSet.Add(DecalClass);
+	}
+
+	if (UAnimMontage* CastMontage = AbilityCDO->GetAbilityCastAnimMontage().Get())
+	{
+		LoadedObjectSet.Add(CastMontage);
+	}
+
+	if (UAnimMontage* ActivationMontage = AbilityCDO->GetAbilityActivationAnimMontage().Get())
+	{
+		LoadedObjectSet.Add(ActivationMontage);
+	}
+}
+
 bool UAbilityComponent::IsHandleValid(FAbilityInstanceHandle InstanceHandle) const
 {
 	for (const FAbilityInstanceData& AbilityInstanceData : *AbilityInstanceDataContainer)
@@ -1130,6 +1156,13 @@ UActionBrainDataObject* UAbilityInfo::CreateTargetActionBrainDataObject(UObject*
 void UAbilityInfo::AbilityInitializedOnComponent(UAbilityComponent* AbilityComponent) const
 {
 	check(AbilityComponent);
+
+	//Content is shared between every component using this ability and is ideally already resident from a wave preload.
+	if (UAbilityContentManager::RequestAbilityContent(AbilityComponent, GetClass()))
+	{
+		return;
+	}
+
 	AbilityComponent->AsyncLoadAbilityObjectClass(GetAbilityDecalClass());
 	AbilityComponent->AsyncLoadAbilityObject(GetAbilityCastAnimMontage());
 	AbilityComponent->AsyncLoadAbilityObject(GetAbilityActivationAnimMontage());
@@ -3,6 +3,7 @@
 
 #include "Gameplay/CoreDamageType.h"
 #include "GenericTeamAgentInterface.h"
+#include "Gameplay/StatusEffect/StatusEffectBase.h"
 
 UCoreDamageType::UCoreDamageType(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -10,6 +11,58 @@ UCoreDamageType::UCoreDamageType(const FObjectInitializer& ObjectInitializer)
 
 }
 
+const TArray<FStatusEffectPowerEntry>& UCoreDamageType::GetStatusEffectList() const
+{
+	if (bInitializedStatusEffectLists)
+	{
+		return StatusEffectList;
+	}
+
+	const_cast<UCoreDamageType*>(this)->InitializeStatusEffectLists();
+	return StatusEffectList;
+}
+
+const TArray<FGenericStatusEffectPowerEntry>& UCoreDamageType::GetGenericStatusEffectList() const
+{
+	if (bInitializedStatusEffectLists)
+	{
+		return GenericStatusEffectList;
+	}
+
+	const_cast<UCoreDamageType*>(this)->InitializeStatusEffectLists();
+	return GenericStatusEffectList;
+}
+
+void UCoreDamageType::InitializeStatusEffectLists()
+{
+	StatusEffectList.Reset(StatusEffectMap.Num());
+	for (const TPair<TSoftClassPtr<UStatusEffectBase>, float>& StatusEntry : StatusEffectMap)
+	{
+		if (StatusEntry.Key.IsNull())
+		{
+			continue;
+		}
+
+		if (TSubclassOf<UStatusEffectBase> StatusEffectClass = StatusEntry.Key.LoadSynchronous())
+		{
+			StatusEffectList.Emplace(StatusEffectClass, StatusEntry.Value);
+		}
+	}
+
+	GenericStatusEffectList.Reset(GenericStatusEffectMap.Num());
+	for (const TPair<EStatusType, float>& GenericStatusEntry : GenericStatusEffectMap)
+	{
+		if (GenericStatusEntry.Key == EStatusType::Invalid || GenericStatusEntry.Key >= EStatusType::MAX)
+		{
+			continue;
+		}
+
+		GenericStatusEffectList.Emplace(GenericStatusEntry.Key, GenericStatusEntry.Value);
+	}
+
+	bInitializedStatusEffectLists = true;
+}
+
 const TArray<EDamageHitDescriptor>& UCoreDamageType::GetDamageHitDescriptorList() const
 {
 	if (bInitializedTypeLists)
@@ -132,4 +185,4 @@ EHitReactionStrength UCoreDamageType::GetHitReactionStrength(const FHitEvent& Hi
 	}
 
 	return EHitReactionStrength(FMath::Min(FMath::FloorToInt(HitReactionCurve->GetFloatValue(DamageAmount)), int32(EHitReactionStrength::MAX) - 1));
-}
\ No newline at end of file
+}
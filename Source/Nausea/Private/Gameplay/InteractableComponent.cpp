@@ -5,6 +5,7 @@
 #include "NauseaNetDefines.h"
 #include "Gameplay/PawnInteractionComponent.h"
 #include "Gameplay/InteractableInterface.h"
+#include "System/CoreSingleton.h"
 
 UInteractableComponent::UInteractableComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -19,11 +20,106 @@ void UInteractableComponent::GetLifetimeReplicatedProps(TArray< FLifetimePropert
 	DOREPLIFETIME_WITH_PARAMS_FAST(UInteractableComponent, PendingInteractionInstigatorList, PushReplicationParams::Default);
 }
 
+//Extents of every registered interactable, per world, so that an oversized interactable only pads queries in its own world and only while it is registered.
+struct FWorldInteractableExtentList
+{
+	TMap<TObjectKey<UInteractableComponent>, float> ExtentMap;
+	float LargestExtent = 0.f;
+};
+static TMap<TObjectKey<UWorld>, FWorldInteractableExtentList> WorldInteractableExtentMap;
+
 void UInteractableComponent::BeginPlay()
 {
 	InitializeInteractableComponent();
 
 	Super::BeginPlay();
+
+	if (AActor* Owner = GetOwner())
+	{
+		const FVector OwnerLocation = Owner->GetActorLocation();
+		const FBox OwnerBounds = Owner->GetComponentsBoundingBox();
+
+		if (OwnerBounds.IsValid)
+		{
+			const FVector MaxOffset(FMath::Max(FMath::Abs(OwnerBounds.Min.X - OwnerLocation.X), FMath::Abs(OwnerBounds.Max.X - OwnerLocation.X)),
+				FMath::Max(FMath::Abs(OwnerBounds.Min.Y - OwnerLocation.Y), FMath::Abs(OwnerBounds.Max.Y - OwnerLocation.Y)),
+				FMath::Max(FMath::Abs(OwnerBounds.Min.Z - OwnerLocation.Z), FMath::Abs(OwnerBounds.Max.Z - OwnerLocation.Z)));
+			InteractableExtent = MaxOffset.Size();
+		}
+
+		if (UWorld* World = GetWorld())
+		{
+			FWorldInteractableExtentList& ExtentList = WorldInteractableExtentMap.FindOrAdd(World);
+			ExtentList.ExtentMap.Add(this, InteractableExtent);
+			ExtentList.LargestExtent = FMath::Max(ExtentList.LargestExtent, InteractableExtent);
+		}
+
+		UCoreSingleton::RegisterActorWithTag(this, Owner, GetInteractableTagContainer());
+		bRegisteredInteractable = true;
+	}
+}
+
+void UInteractableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//Owners with several interactable components stay registered until the last one leaves play.
+	if (bRegisteredInteractable && GetOwner())
+	{
+		bRegisteredInteractable = false;
+
+		bool bHasOtherRegisteredComponent = false;
+		GetOwner()->ForEachComponent<UInteractableComponent>(false, [this, &bHasOtherRegisteredComponent](const UInteractableComponent* Component)
+		{
+			bHasOtherRegisteredComponent |= Component != this && Component->IsRegisteredInteractable();
+		});
+
+		if (!bHasOtherRegisteredComponent)
+		{
+			UCoreSingleton::UnregisterActorWithTag(this, GetOwner(), GetInteractableTagContainer());
+		}
+
+		const TObjectKey<UWorld> WorldKey(GetWorld());
+		if (FWorldInteractableExtentList* ExtentList = WorldInteractableExtentMap.Find(WorldKey))
+		{
+			ExtentList->ExtentMap.Remove(this);
+
+			if (ExtentList->ExtentMap.Num() == 0)
+			{
+				WorldInteractableExtentMap.Remove(WorldKey);
+			}
+			else if (InteractableExtent >= ExtentList->LargestExtent)
+			{
+				ExtentList->LargestExtent = 0.f;
+				for (const TPair<TObjectKey<UInteractableComponent>, float>& Entry : ExtentList->ExtentMap)
+				{
+					ExtentList->LargestExtent = FMath::Max(ExtentList->LargestExtent, Entry.Value);
+				}
+			}
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float UInteractableComponent::GetDistanceToInteractable(const FVector& Location) const
+{
+	if (!GetOwner())
+	{
+		return BIG_NUMBER;
+	}
+
+	return FMath::Max(FVector::Dist(Location, GetOwner()->GetActorLocation()) - InteractableExtent, 0.f);
+}
+
+float UInteractableComponent::GetLargestInteractableExtent(const UWorld* World)
+{
+	const FWorldInteractableExtentList* ExtentList = WorldInteractableExtentMap.Find(World);
+	return ExtentList ? ExtentList->LargestExtent : 0.f;
+}
+
+const FGameplayTagContainer& UInteractableComponent::GetInteractableTagContainer()
+{
+	static const FGameplayTagContainer InteractableTagContainer = FGameplayTagContainer(FGameplayTag::RequestGameplayTag("Interactable"));
+	return InteractableTagContainer;
 }
 
 void UInteractableComponent::InitializeInteractableComponent()
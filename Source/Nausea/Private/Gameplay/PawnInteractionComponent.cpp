@@ -13,6 +13,7 @@
 #include "Gameplay/InteractableInterface.h"
 #include "Player/CameraModifier/InteractionCameraModifier.h"
 #include "Gameplay/StatusComponent.h"
+#include "System/CoreSingleton.h"
 
 UPawnInteractionComponent::UPawnInteractionComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -39,61 +40,30 @@ void UPawnInteractionComponent::TickComponent(float DeltaTime, enum ELevelTick T
 
 	if (PendingInteractableComponent.IsValid())
 	{
+		ForceNextInteractionScan();
 		return;
 	}
 
 	if (HoveredWidgetComponent.IsValid())
 	{
+		ForceNextInteractionScan();
 		return;
 	}
 
-	FCollisionQueryParams CQP = InteractionQueryParams;
-	CQP.AddIgnoredActor(GetOwner());
-
-	TArray<FHitResult> HitResultList;
 	const FVector InteractionLocation = GetInteractionLocation();
 	const FVector InteractionDirection = GetInteractionDirection();
-	const FVector InteractionEndLocation = InteractionLocation + (InteractionDirection * InteractionDistance);
-	GetWorld()->SweepMultiByChannel(HitResultList, InteractionLocation, InteractionEndLocation, FQuat::Identity, ECC_InteractionTrace, FCollisionShape::MakeSphere(InteractionExtent), CQP);
 
-	for (const FHitResult& HitResult : HitResultList)
+	if (LastCandidateRefreshTime < 0.f || GetWorld()->GetTimeSeconds() - LastCandidateRefreshTime >= CandidateRefreshInterval)
 	{
-		TScriptInterface<IInteractableInterface> HitInterface(HitResult.GetActor());
-		
-		if (!UInteractableInterfaceStatics::CanInteract(HitInterface, this, InteractionLocation, InteractionDirection))
-		{
-			continue;
-		}
-
-		UInteractableComponent* InteractableComponent = UInteractableInterfaceStatics::GetInteractableComponent(HitInterface);
-
-		if (InteractableComponent)
-		{
-			SetCurrentLookAtActor(nullptr);
-			SetCurrentInteractionTarget(InteractableComponent);
-			return;
-		}
+		RefreshInteractionCandidates(InteractionLocation);
 	}
 
-	SetCurrentInteractionTarget(nullptr);
-
-	for (const FHitResult& HitResult : HitResultList)
+	if (!ShouldPerformInteractionScan(InteractionLocation, InteractionDirection))
 	{
-		TScriptInterface<IStatusInterface> HitInterface(HitResult.GetActor());
-
-		if (UStatusComponent* HitStatusComponent = UStatusInterfaceStatics::GetStatusComponent(HitInterface))
-		{
-			if (!HitStatusComponent->CanDisplayStatus() || HitStatusComponent->IsDead())
-			{
-				continue;
-			}
-
-			SetCurrentLookAtActor(HitResult.GetActor());
-			return;
-		}
+		return;
 	}
 
-	SetCurrentLookAtActor(nullptr);
+	PerformInteractionScan(InteractionLocation, InteractionDirection);
 }
 
 void UPawnInteractionComponent::SetupInputComponent(UInputComponent* InputComponent)
@@ -342,6 +312,11 @@ bool UPawnInteractionComponent::Server_Reliable_Interact_Validate(UInteractableC
 
 void UPawnInteractionComponent::Server_Reliable_Interact_Implementation(UInteractableComponent* Target, const FVector& Location, const FVector& Direction)
 {
+	if (!IsValidInteractionRequest(Target, Location))
+	{
+		return;
+	}
+
 	Interact(Target, Location, Direction);
 }
 
@@ -352,6 +327,12 @@ bool UPawnInteractionComponent::Server_Reliable_StartPendingInteract_Validate(UI
 
 void UPawnInteractionComponent::Server_Reliable_StartPendingInteract_Implementation(UInteractableComponent* Target, const FVector& Location, const FVector& Direction)
 {
+	if (!IsValidInteractionRequest(Target, Location))
+	{
+		Client_Reliable_InterruptedPendingInteraction(Target);
+		return;
+	}
+
 	Interact(Target, Location, Direction);
 }
 
@@ -441,6 +422,136 @@ void UPawnInteractionComponent::SetCurrentLookAtActor(AActor* Actor)
 	OnCurrentLookAtActorUpdate.Broadcast(this, CurrentLookAtActor.Get());
 }
 
+bool UPawnInteractionComponent::ShouldPerformInteractionScan(const FVector& InteractionLocation, const FVector& InteractionDirection) const
+{
+	if (LastScanTime < 0.f)
+	{
+		return true;
+	}
+
+	const float TimeSinceLastScan = GetWorld()->GetTimeSeconds() - LastScanTime;
+
+	if (TimeSinceLastScan >= ScanMaxInterval)
+	{
+		return true;
+	}
+
+	if (TimeSinceLastScan < ScanMinInterval)
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(InteractionLocation, LastScanLocation) > FMath::Square(ScanLocationThreshold))
+	{
+		return true;
+	}
+
+	return FVector::DotProduct(InteractionDirection, LastScanDirection) < FMath::Cos(FMath::DegreesToRadians(ScanRotationThreshold));
+}
+
+void UPawnInteractionComponent::PerformInteractionScan(const FVector& InteractionLocation, const FVector& InteractionDirection)
+{
+	const float WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	LastScanTime = WorldTimeSeconds;
+	LastScanLocation = InteractionLocation;
+	LastScanDirection = InteractionDirection;
+
+	FCollisionQueryParams CQP = InteractionQueryParams;
+	CQP.AddIgnoredActor(GetOwner());
+
+	ScanHitResultList.Reset();
+	const FVector InteractionEndLocation = InteractionLocation + (InteractionDirection * InteractionDistance);
+	GetWorld()->SweepMultiByChannel(ScanHitResultList, InteractionLocation, InteractionEndLocation, FQuat::Identity, ECC_InteractionTrace, FCollisionShape::MakeSphere(InteractionExtent), CQP);
+
+	//Interactables take priority over look at actors so the first status actor hit is only used if no interactable was.
+	AActor* LookAtActor = nullptr;
+	for (const FHitResult& HitResult : ScanHitResultList)
+	{
+		AActor* HitActor = HitResult.GetActor();
+
+		if (!HitActor)
+		{
+			continue;
+		}
+
+		TScriptInterface<IInteractableInterface> HitInterface(HitActor);
+		UInteractableComponent* InteractableComponent = UInteractableInterfaceStatics::GetInteractableComponent(HitInterface);
+
+		if (InteractableComponent && InteractionCandidateSet.Contains(InteractableComponent)
+			&& UInteractableInterfaceStatics::CanInteract(HitInterface, this, InteractionLocation, InteractionDirection))
+		{
+			CurrentInteractionTargetLastSeenTime = WorldTimeSeconds;
+			SetCurrentLookAtActor(nullptr);
+			SetCurrentInteractionTarget(InteractableComponent);
+			return;
+		}
+
+		if (LookAtActor)
+		{
+			continue;
+		}
+
+		TScriptInterface<IStatusInterface> HitStatusInterface(HitActor);
+
+		if (UStatusComponent* HitStatusComponent = UStatusInterfaceStatics::GetStatusComponent(HitStatusInterface))
+		{
+			if (HitStatusComponent->CanDisplayStatus() && !HitStatusComponent->IsDead())
+			{
+				LookAtActor = HitActor;
+			}
+		}
+	}
+
+	//Hold on to the current target for a short while so that it does not flicker when the sweep grazes its edge.
+	UInteractableComponent* InteractionTarget = CurrentInteractionTarget.Get();
+	if (InteractionTarget && WorldTimeSeconds - CurrentInteractionTargetLastSeenTime < TargetLossGraceTime
+		&& InteractionTarget->CanInteract(this, InteractionLocation, InteractionDirection) < EInteractionResponse::Failed)
+	{
+		return;
+	}
+
+	SetCurrentInteractionTarget(nullptr);
+	SetCurrentLookAtActor(LookAtActor);
+}
+
+void UPawnInteractionComponent::RefreshInteractionCandidates(const FVector& InteractionLocation)
+{
+	LastCandidateRefreshTime = GetWorld()->GetTimeSeconds();
+
+	//The registry is queried by owner origin, so pad it by the largest interactable extent and then filter each interactable by its own extent.
+	const float CandidateRadius = InteractionDistance + CandidateRadiusPadding;
+	UCoreSingleton::GetActorsWithTagInRadius(this, CandidateActorList, UInteractableComponent::GetInteractableTagContainer(), InteractionLocation, CandidateRadius + UInteractableComponent::GetLargestInteractableExtent(GetWorld()));
+
+	InteractionCandidateSet.Reset();
+	for (AActor* CandidateActor : CandidateActorList)
+	{
+		CandidateActor->ForEachComponent<UInteractableComponent>(false, [this, &InteractionLocation, CandidateRadius](UInteractableComponent* InteractableComponent)
+		{
+			if (InteractableComponent->IsRegisteredInteractable() && InteractableComponent->GetDistanceToInteractable(InteractionLocation) <= CandidateRadius)
+			{
+				InteractionCandidateSet.Add(InteractableComponent);
+			}
+		});
+	}
+
+	CandidateActorList.Reset();
+}
+
+bool UPawnInteractionComponent::IsValidInteractionRequest(const UInteractableComponent* Target, const FVector& Location) const
+{
+	if (!Target || !Target->IsRegisteredInteractable() || !Target->GetOwner() || !GetOwningCharacter())
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(Location, GetInteractionLocation()) > FMath::Square(ServerInteractionLocationTolerance))
+	{
+		return false;
+	}
+
+	return Target->GetDistanceToInteractable(Location) <= InteractionDistance + CandidateRadiusPadding;
+}
+
 void UPawnInteractionComponent::OnHoveredWidgetChanged(UWidgetComponent* WidgetComponent, UWidgetComponent* PreviousWidgetComponent)
 {
 	if (WidgetComponent)
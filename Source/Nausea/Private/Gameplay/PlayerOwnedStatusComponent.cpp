@@ -137,11 +137,13 @@ void UPlayerOwnedStatusComponent::OnPlayerClassChanged(ACorePlayerState* OwningC
 
 	//Apply player class bonuses.
 	float ModifiedMaxHealth = Health.DefaultMaxValue;
+	ModifiedMaxHealth *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::MaxHealth, nullptr);
 	PlayerClassComponent->OnProcessOwnedActorMaxHealth.Broadcast(GetOwner(), ModifiedMaxHealth);
 	SetMaxHealth(ModifiedMaxHealth);
 
 	float ModifiedMaxArmour = Armour.DefaultMaxValue;
-	PlayerClassComponent->OnProcessOwnedActorMaxHealth.Broadcast(GetOwner(), ModifiedMaxArmour);
+	ModifiedMaxArmour *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::MaxArmour, nullptr);
+	PlayerClassComponent->OnProcessOwnedActorMaxArmour.Broadcast(GetOwner(), ModifiedMaxArmour);
 	SetMaxArmour(ModifiedMaxArmour);
 
 	TWeakObjectPtr<UPlayerClassComponent> WeakPlayerClassComponent = PlayerClassComponent;
@@ -149,6 +151,7 @@ void UPlayerOwnedStatusComponent::OnPlayerClassChanged(ACorePlayerState* OwningC
 	{
 		if (WeakPlayerClassComponent.IsValid())
 		{
+			WeakPlayerClassComponent->ApplyPassiveSkillDamageModifiers(ESimplePassiveSkill::DamageTaken, StatusComponent, DamageAmount, DamageEvent);
 			WeakPlayerClassComponent->OnProcessDamageTaken.Broadcast(StatusComponent, DamageAmount, DamageEvent, PlayerState);
 		}
 	});
@@ -157,6 +160,7 @@ void UPlayerOwnedStatusComponent::OnPlayerClassChanged(ACorePlayerState* OwningC
 	{
 		if (WeakPlayerClassComponent.IsValid())
 		{
+			WeakPlayerClassComponent->ApplyPassiveSkillDamageModifiers(ESimplePassiveSkill::DamageDealt, StatusComponent, DamageAmount, DamageEvent);
 			WeakPlayerClassComponent->OnProcessDamageDealt.Broadcast(StatusComponent, DamageAmount, DamageEvent, PlayerState);
 		}
 	});
@@ -4,6 +4,9 @@
 #include "Gameplay/StatusComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/ActorChannel.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
 #include "Perception/AIPerceptionSystem.h"
 #include "Perception/AISense_Damage.h"
 #include "NauseaHelpers.h"
@@ -31,6 +34,96 @@ FStatStruct InvalidStat = FStatStruct(-1.f, -1.f);
 FPartStatStruct InvalidPartStat = FPartStatStruct(-1.f, -1.f);
 uint64 FHitEvent::IDCounter = 0;
 
+bool FHitEvent::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	UObject* DamageTypeObject = DamageType.Get();
+	bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), DamageTypeObject);
+
+	uint8 bHasHitDirection = Ar.IsSaving() ? uint8(HitDirection != FAISystem::InvalidDirection) : 0;
+	uint8 bHasHitLocation = Ar.IsSaving() ? uint8(RelativeHitLocation != FAISystem::InvalidLocation) : 0;
+	Ar.SerializeBits(&bHasHitDirection, 1);
+	Ar.SerializeBits(&bHasHitLocation, 1);
+
+	//Damage is only used to pick hit reaction strength so tenths are more than enough precision.
+	uint32 PackedDamage = Ar.IsSaving() ? uint32(FMath::RoundToInt(FMath::Clamp(Damage, 0.f, MaxNetDamage) * 10.f)) : 0;
+	Ar.SerializeIntPacked(PackedDamage);
+
+	//Direction is only used to pick a hit reaction direction. 8 bits of yaw and 6 bits of pitch is plenty.
+	if (bHasHitDirection)
+	{
+		uint32 PackedYaw = 0;
+		uint32 PackedPitch = 0;
+
+		if (Ar.IsSaving())
+		{
+			const FRotator Rotation = FVector(HitDirection).Rotation();
+			PackedYaw = FRotator::CompressAxisToByte(Rotation.Yaw);
+			PackedPitch = uint32(FMath::RoundToInt(((FRotator::NormalizeAxis(Rotation.Pitch) + 90.f) / 180.f) * 63.f));
+		}
+
+		Ar.SerializeInt(PackedYaw, 256);
+		Ar.SerializeInt(PackedPitch, 64);
+
+		if (Ar.IsLoading())
+		{
+			const FRotator Rotation = FRotator((float(PackedPitch) / 63.f) * 180.f - 90.f, FRotator::DecompressAxisFromByte(uint8(PackedYaw)), 0.f);
+			HitDirection = Rotation.Vector();
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		HitDirection = FAISystem::InvalidDirection;
+	}
+
+	//Relative offsets are small so this usually costs a handful of bits per component.
+	if (bHasHitLocation)
+	{
+		bOutSuccess &= SerializePackedVector<1, 16>(RelativeHitLocation, Ar);
+	}
+	else if (Ar.IsLoading())
+	{
+		RelativeHitLocation = FAISystem::InvalidLocation;
+	}
+
+	uint16 RandomSeed = Ar.IsSaving() ? uint16(Random.GetInitialSeed()) : 0;
+	Ar << RandomSeed;
+
+	if (Ar.IsLoading())
+	{
+		DamageType = Cast<UClass>(DamageTypeObject);
+		Damage = float(PackedDamage) / 10.f;
+		Random.Initialize(int32(RandomSeed));
+		HitLocation = FAISystem::InvalidLocation;
+		WorldTime = -1.f;
+	}
+
+	return true;
+}
+
+void FHitEvent::SetOwnerLocation(const FVector& OwnerLocation)
+{
+	if (HitLocation == FAISystem::InvalidLocation)
+	{
+		RelativeHitLocation = FAISystem::InvalidLocation;
+		return;
+	}
+
+	RelativeHitLocation = HitLocation - OwnerLocation;
+}
+
+void FHitEvent::ResolveHitLocation(const FVector& OwnerLocation)
+{
+	if (RelativeHitLocation == FAISystem::InvalidLocation)
+	{
+		HitLocation = FAISystem::InvalidLocation;
+		return;
+	}
+
+	HitLocation = OwnerLocation + RelativeHitLocation;
+}
+
 void FPartStatContainer::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
 {
 	if (!OwningStatusComponent)
@@ -64,8 +157,11 @@ void FHitEventContainer::PostReplicatedAdd(const TArrayView<int32>& AddedIndices
 		return;
 	}
 
+	const FVector OwnerLocation = OwningStatusComponent->GetOwner() ? OwningStatusComponent->GetOwner()->GetActorLocation() : FVector::ZeroVector;
+
 	for (const int32& Index : AddedIndices)
 	{
+		InstanceList[Index].ResolveHitLocation(OwnerLocation);
 		OwningStatusComponent->PlayHitEffect(InstanceList[Index]);
 	}
 }
@@ -309,12 +405,22 @@ FPartStatStruct& UStatusComponent::GetPartHealthForBone(const FName& BoneName)
 
 int32 UStatusComponent::GetPartHealthIndexForBone(const FName& BoneName) const
 {
-	if (BoneName != NAME_None && BonePartIndexMap.Contains(BoneName))
+	if (BoneName == NAME_None || !BonePartLookup.IsValid())
 	{
-		return BonePartIndexMap[BoneName];
+		return INDEX_NONE;
 	}
 
-	return INDEX_NONE;
+	return BonePartLookup->GetPartIndex(BoneName);
+}
+
+int32 UStatusComponent::GetPartHealthIndexForHit(const FHitResult& HitResult) const
+{
+	if (HitResult.BoneName == NAME_None || !BonePartLookup.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	return BonePartLookup->GetPartIndexForHit(HitResult);
 }
 
 void UStatusComponent::OnReceivedPartHealthUpdate(const FPartStatStruct& PartStat)
@@ -651,7 +757,7 @@ void UStatusComponent::TakeDamage(AActor* Actor, float& DamageAmount, FDamageEve
 	});
 
 	const FVector DamageDirection = GetDamageDirection(PerceptionInfo);
-	GenerateHitEvent(FHitEvent(TSubclassOf<UCoreDamageType>(DamageEvent.DamageTypeClass), DamageAmount, DamageDirection, PerceptionInfo.HitLocation, GetWorld()->GetTimeSeconds(), FRandomStream(FMath::Rand())));
+	GenerateHitEvent(FHitEvent(TSubclassOf<UCoreDamageType>(DamageEvent.DamageTypeClass), DamageAmount, DamageDirection, PerceptionInfo.HitLocation, GetWorld()->GetTimeSeconds(), FRandomStream(FMath::Rand() & MAX_uint16)));
 
 	SetHealth(Health - DamageAmount);
 
@@ -684,7 +790,8 @@ void UStatusComponent::HandlePointDamage(AActor* Actor, float& DamageAmount, FPo
 {
 	K2_HandlePointDamage(Actor, DamageAmount, DamageAmount, PointDamageEvent, EventInstigator, DamageCauser);
 
-	FPartStatStruct& HitPart = GetPartHealthForBone(PointDamageEvent.HitInfo.BoneName);
+	const int32 HitPartIndex = GetPartHealthIndexForHit(PointDamageEvent.HitInfo);
+	FPartStatStruct& HitPart = HitPartIndex != INDEX_NONE ? PartHealthList[HitPartIndex] : InvalidPartStat;
 
 	if (!HitPart.IsValid())
 	{
@@ -828,36 +935,21 @@ void UStatusComponent::HandleDamageTypeStatus(float Damage, struct FDamageEvent
 		return;
 	}
 
-	const TMap<EStatusType, float>& DamageTypeGenericStatusEffectMap = CoreDamageType->GetGenericStatusEffectMap();
-
-	for (const TPair<EStatusType, float>& GenericStatusEffect : DamageTypeGenericStatusEffectMap)
+	for (const FGenericStatusEffectPowerEntry& GenericStatusEffect : CoreDamageType->GetGenericStatusEffectList())
 	{
-		if (!GenericStatusEffectMap.Contains(GenericStatusEffect.Key))
+		const uint8 StatusTypeIndex = uint8(GenericStatusEffect.StatusType);
+
+		if (!GenericStatusEffectClassList.IsValidIndex(StatusTypeIndex) || !GenericStatusEffectClassList[StatusTypeIndex])
 		{
 			continue;
 		}
-		
-		float EffectPower = GenericStatusEffect.Value * EffectPowerMultiplier;
-		if (GenericStatusEffectMultiplierMap.Contains(GenericStatusEffect.Key))
-		{
-			EffectPower *= GenericStatusEffectMultiplierMap[GenericStatusEffect.Key];
-		}
 
-		AddStatusEffect(GenericStatusEffectMap[GenericStatusEffect.Key], DamageEvent, EventInstigator, EffectPower);
+		AddStatusEffect(GenericStatusEffectClassList[StatusTypeIndex], DamageEvent, EventInstigator, GenericStatusEffect.Power * EffectPowerMultiplier * GenericStatusEffectMultiplierList[StatusTypeIndex]);
 	}
 
-	const TMap<TSoftClassPtr<UStatusEffectBase>, float>& DamageTypeStatusEffectMap = CoreDamageType->GetStatusEffectMap();
-
-	for (const TPair<TSoftClassPtr<UStatusEffectBase>, float>& StatusEntry : DamageTypeStatusEffectMap)
+	for (const FStatusEffectPowerEntry& StatusEffect : CoreDamageType->GetStatusEffectList())
 	{
-		TSubclassOf<UStatusEffectBase> StatusEffectClass = StatusEntry.Key.LoadSynchronous();
-
-		if (!StatusEffectClass)
-		{
-			continue;
-		}
-
-		AddStatusEffect(StatusEntry.Key.Get(), DamageEvent, EventInstigator, StatusEntry.Value * EffectPowerMultiplier);
+		AddStatusEffect(StatusEffect.StatusEffectClass, DamageEvent, EventInstigator, StatusEffect.Power * EffectPowerMultiplier);
 	}
 }
 
@@ -954,6 +1046,7 @@ inline FDamageLogEvent UStatusComponent::PopDamageLog(float DamageDealt)
 void UStatusComponent::GenerateHitEvent(FHitEvent&& InHitEvent)
 {
 	FHitEvent& HitEvent = HitEventList->Add_GetRef(MoveTemp(InHitEvent));
+	HitEvent.SetOwnerLocation(GetOwner()->GetActorLocation());
 	HitEventList.MarkItemDirty(HitEvent);
 
 	FTimerHandle DummyHandle;
@@ -1132,24 +1225,24 @@ void UStatusComponentConfigObject::ConfigureStatusComponent(UStatusComponent* St
 	MARK_PROPERTY_DIRTY_FROM_NAME(UStatusComponent, PartHealthList, StatusComponent);
 
 	TArray<FPartStatStruct>& StatusComponentPartHealthList = *StatusComponent->PartHealthList;
-	TMap<FName, int32>& StatusComponentBonePartIndexMap = StatusComponent->BonePartIndexMap;
 
-	for (int32 Index = StatusComponentPartHealthList.Num() - 1; Index >= 0; Index--)
+	for (FPartStatStruct& PartHealth : StatusComponentPartHealthList)
 	{
-		StatusComponentPartHealthList[Index].StatStruct.Initialize();
-
-		const TArray<FName>& BoneList = StatusComponentPartHealthList[Index].BoneList;
-		for (const FName& BoneName : BoneList)
-		{
-			int32& BoneIndex = StatusComponentBonePartIndexMap.Add(BoneName);
-			BoneIndex = Index;
-		}
+		PartHealth.StatStruct.Initialize();
+	}
 
-		//Add PartName to the map as well.
-		int32& BoneIndex = StatusComponentBonePartIndexMap.Add(StatusComponentPartHealthList[Index].PartName);
-		BoneIndex = Index;
+	USkeletalMeshComponent* MeshComponent = nullptr;
+	if (ACharacter* Character = Cast<ACharacter>(StatusComponent->GetOwner()))
+	{
+		MeshComponent = Character->GetMesh();
+	}
+	else if (AActor* Owner = StatusComponent->GetOwner())
+	{
+		MeshComponent = Owner->FindComponentByClass<USkeletalMeshComponent>();
 	}
 
+	StatusComponent->BonePartLookup = GetBonePartLookup(MeshComponent);
+
 	if (bHealthScalingEffectsPartHealth)
 	{
 		for (FPartStatStruct& PartHealth : StatusComponentPartHealthList)
@@ -1170,14 +1263,140 @@ void UStatusComponentConfigObject::ConfigureStatusComponent(UStatusComponent* St
 	}
 	StatusComponent->PartHealthList.MarkArrayDirty();
 	
-	TMap<EStatusType, TSubclassOf<UStatusEffectBase>>& StatusComponentGenericStatusEffectMap = StatusComponent->GenericStatusEffectMap;
-	StatusComponentGenericStatusEffectMap = GenericStatusEffectMap;
+	TArray<TSubclassOf<UStatusEffectBase>>& StatusComponentGenericStatusEffectClassList = StatusComponent->GenericStatusEffectClassList;
+	StatusComponentGenericStatusEffectClassList.Reset();
+	StatusComponentGenericStatusEffectClassList.SetNumZeroed(uint8(EStatusType::MAX));
 
-	TMap<EStatusType, float>& StatusComponentGenericStatusEffectMultiplierMap = StatusComponent->GenericStatusEffectMultiplierMap;
-	StatusComponentGenericStatusEffectMultiplierMap = GenericStatusEffectMultiplierMap;
+	for (const TPair<EStatusType, TSubclassOf<UStatusEffectBase>>& GenericStatusEffectEntry : GenericStatusEffectMap)
+	{
+		if (!StatusComponentGenericStatusEffectClassList.IsValidIndex(uint8(GenericStatusEffectEntry.Key)))
+		{
+			continue;
+		}
+
+		StatusComponentGenericStatusEffectClassList[uint8(GenericStatusEffectEntry.Key)] = GenericStatusEffectEntry.Value;
+	}
 
-	for (TPair<EStatusType, float>& EffectMultiplierEntry : StatusComponentGenericStatusEffectMultiplierMap)
+	//Status types without a configured multiplier apply at full power (and are not affected by status scaling).
+	TArray<float>& StatusComponentGenericStatusEffectMultiplierList = StatusComponent->GenericStatusEffectMultiplierList;
+	StatusComponentGenericStatusEffectMultiplierList.Init(1.f, uint8(EStatusType::MAX));
+
+	for (const TPair<EStatusType, float>& EffectMultiplierEntry : GenericStatusEffectMultiplierMap)
 	{
-		EffectMultiplierEntry.Value *= StatusScale;
+		if (!StatusComponentGenericStatusEffectMultiplierList.IsValidIndex(uint8(EffectMultiplierEntry.Key)))
+		{
+			continue;
+		}
+
+		StatusComponentGenericStatusEffectMultiplierList[uint8(EffectMultiplierEntry.Key)] = EffectMultiplierEntry.Value * StatusScale;
 	}
-}
\ No newline at end of file
+}
+
+TSharedPtr<const FBonePartLookup> UStatusComponentConfigObject::GetBonePartLookup(const USkeletalMeshComponent* MeshComponent) const
+{
+	if (!NameBonePartLookup.IsValid())
+	{
+		TSharedPtr<FBonePartLookup> NewNameBonePartLookup = MakeShareable(new FBonePartLookup());
+
+		//Iterate backwards so that the earliest part claiming a bone wins.
+		for (int32 Index = PartHealthList.Num() - 1; Index >= 0; Index--)
+		{
+			for (const FName& BoneName : PartHealthList[Index].BoneList)
+			{
+				NewNameBonePartLookup->NamePartIndexMap.Add(BoneName, Index);
+			}
+
+			//Add PartName to the map as well.
+			NewNameBonePartLookup->NamePartIndexMap.Add(PartHealthList[Index].PartName, Index);
+		}
+
+		NameBonePartLookup = NewNameBonePartLookup;
+	}
+
+	const USkeletalMesh* SkeletalMesh = MeshComponent ? MeshComponent->SkeletalMesh : nullptr;
+
+	if (!SkeletalMesh || NameBonePartLookup->NamePartIndexMap.Num() == 0)
+	{
+		return NameBonePartLookup;
+	}
+
+	if (const TSharedPtr<const FBonePartLookup>* CachedBonePartLookup = BonePartLookupCache.Find(SkeletalMesh))
+	{
+		return *CachedBonePartLookup;
+	}
+
+	//Clear out entries for meshes that have since been unloaded.
+	for (auto Iterator = BonePartLookupCache.CreateIterator(); Iterator; ++Iterator)
+	{
+		if (!Iterator.Key().IsValid())
+		{
+			Iterator.RemoveCurrent();
+		}
+	}
+
+	TSharedPtr<FBonePartLookup> NewBonePartLookup = MakeShareable(new FBonePartLookup(*NameBonePartLookup));
+	NewBonePartLookup->SkeletalMesh = SkeletalMesh;
+
+	const int32 NumBones = MeshComponent->GetNumBones();
+	NewBonePartLookup->BonePartIndexList.Init(INDEX_NONE, NumBones);
+
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		if (const int32* PartIndex = NewBonePartLookup->NamePartIndexMap.Find(MeshComponent->GetBoneName(BoneIndex)))
+		{
+			NewBonePartLookup->BonePartIndexList[BoneIndex] = *PartIndex;
+		}
+	}
+
+	//Body setups are looked up by the bone they are attached to. Hits against a component with a different physics asset fall back to the name map.
+	if (const UPhysicsAsset* PhysicsAsset = MeshComponent->GetPhysicsAsset())
+	{
+		NewBonePartLookup->PhysicsAsset = PhysicsAsset;
+		NewBonePartLookup->BodyPartIndexList.Init(INDEX_NONE, PhysicsAsset->SkeletalBodySetups.Num());
+
+		for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->SkeletalBodySetups.Num(); BodyIndex++)
+		{
+			const USkeletalBodySetup* BodySetup = PhysicsAsset->SkeletalBodySetups[BodyIndex];
+
+			if (!BodySetup)
+			{
+				continue;
+			}
+
+			if (const int32* PartIndex = NewBonePartLookup->NamePartIndexMap.Find(BodySetup->BoneName))
+			{
+				NewBonePartLookup->BodyPartIndexList[BodyIndex] = *PartIndex;
+			}
+		}
+	}
+
+	BonePartLookupCache.Add(SkeletalMesh, NewBonePartLookup);
+	return NewBonePartLookup;
+}
+
+#if WITH_EDITOR
+void UStatusComponentConfigObject::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UStatusComponentConfigObject, PartHealthList)
+		|| (PropertyChangedEvent.MemberProperty && PropertyChangedEvent.MemberProperty->GetFName() == GET_MEMBER_NAME_CHECKED(UStatusComponentConfigObject, PartHealthList)))
+	{
+		NameBonePartLookup.Reset();
+		BonePartLookupCache.Empty();
+	}
+}
+#endif //WITH_EDITOR
+
+int32 FBonePartLookup::GetPartIndexForHit(const FHitResult& HitResult) const
+{
+	const USkeletalMeshComponent* MeshComponent = Cast<USkeletalMeshComponent>(HitResult.GetComponent());
+
+	if (MeshComponent && BodyPartIndexList.IsValidIndex(HitResult.Item)
+		&& MeshComponent->SkeletalMesh == SkeletalMesh.Get() && MeshComponent->GetPhysicsAsset() == PhysicsAsset.Get())
+	{
+		return BodyPartIndexList[HitResult.Item];
+	}
+
+	return GetPartIndex(HitResult.BoneName);
+}
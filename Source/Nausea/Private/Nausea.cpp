@@ -13,6 +13,9 @@
 //LOG CATEGORIES
 DEFINE_LOG_CATEGORY(LogUI);
 
+//CSV CATEGORIES
+CSV_DEFINE_CATEGORY_MODULE(NAUSEA_API, Nausea, true);
+
 IMPLEMENT_PRIMARY_GAME_MODULE(FNauseaModule, Nausea, "Nausea");
 
 void FNauseaModule::StartupModule()
@@ -91,20 +91,7 @@ UMissionComponent* UMissionComponent::InitializeMission(UMissionComponent* Missi
 
 float UMissionComponent::GetMissionProgress() const
 {
-	float ProgressSum = 0.f;
-	int32 ObjectiveCount = 0;
-	for (UObjective* Objective : ObjectiveList)
-	{
-		if (!Objective || !Objective->ShouldContributeToProgress())
-		{
-			continue;
-		}
-
-		ProgressSum += Objective->GetObjecitveProgress();
-		ObjectiveCount++;
-	}
-
-	return ObjectiveCount != 0 ? (ProgressSum / float(ObjectiveCount)) : 0.f;
+	return ProgressObjectiveCount != 0 ? (ProgressSum / float(ProgressObjectiveCount)) : 0.f;
 }
 
 const FText& UMissionComponent::GetMissionTitle() const
@@ -328,6 +315,7 @@ void UMissionComponent::OnRep_ObjectiveList()
 
 	ObjectiveList.Remove(nullptr);
 	PreviousObjectiveList = ObjectiveList;
+	RebuildObjectiveAggregates();
 	OnMissionObjectivesChanged.Broadcast(this, ObjectiveList);
 }
 
@@ -359,8 +347,78 @@ void UMissionComponent::UnbindToObjective(UObjective* Objective)
 	Objective->OnObjectiveProgressChanged.RemoveDynamic(this, &UMissionComponent::ObjectiveProgressChanged);
 }
 
+void UMissionComponent::RebuildObjectiveAggregates()
+{
+	ObjectiveIndexMap.Reset();
+	CachedObjectiveStateList.Reset(ObjectiveList.Num());
+	CachedObjectiveProgressList.Reset(ObjectiveList.Num());
+	RequiredObjectiveCount = 0;
+	CompletedRequiredObjectiveCount = 0;
+	ProgressObjectiveCount = 0;
+	ProgressSum = 0.f;
+
+	for (int32 Index = 0; Index < ObjectiveList.Num(); Index++)
+	{
+		UObjective* Objective = ObjectiveList[Index];
+		ObjectiveIndexMap.Add(Objective, Index);
+		CachedObjectiveStateList.Add(Objective->GetObjecitveState());
+		CachedObjectiveProgressList.Add(Objective->GetObjecitveProgress());
+
+		if (!Objective->IsOptionalObjective())
+		{
+			RequiredObjectiveCount++;
+			CompletedRequiredObjectiveCount += Objective->GetObjecitveState() == EObjectiveState::Completed ? 1 : 0;
+		}
+
+		if (Objective->ShouldContributeToProgress())
+		{
+			ProgressObjectiveCount++;
+			ProgressSum += Objective->GetObjecitveProgress();
+		}
+	}
+}
+
+void UMissionComponent::UpdateObjectiveAggregates(UObjective* Objective)
+{
+	const int32* IndexPtr = Objective ? ObjectiveIndexMap.Find(Objective) : nullptr;
+
+	if (!IndexPtr)
+	{
+		return;
+	}
+
+	const int32 Index = *IndexPtr;
+
+	const EObjectiveState PreviousState = CachedObjectiveStateList[Index];
+	const EObjectiveState State = Objective->GetObjecitveState();
+	CachedObjectiveStateList[Index] = State;
+
+	if (!Objective->IsOptionalObjective() && PreviousState != State)
+	{
+		if (PreviousState == EObjectiveState::Completed)
+		{
+			CompletedRequiredObjectiveCount--;
+		}
+		else if (State == EObjectiveState::Completed)
+		{
+			CompletedRequiredObjectiveCount++;
+		}
+	}
+
+	const float PreviousProgress = CachedObjectiveProgressList[Index];
+	const float Progress = Objective->GetObjecitveProgress();
+	CachedObjectiveProgressList[Index] = Progress;
+
+	if (Objective->ShouldContributeToProgress())
+	{
+		ProgressSum = FMath::Max(ProgressSum + (Progress - PreviousProgress), 0.f);
+	}
+}
+
 void UMissionComponent::ObjectiveStateChanged(UObjective* Objective, EObjectiveState State)
 {
+	UpdateObjectiveAggregates(Objective);
+
 	K2_ObjectiveStateChanged(Objective, State);
 	OnMissionObjectiveStateChanged.Broadcast(this, Objective, State);
 
@@ -378,17 +436,7 @@ void UMissionComponent::ObjectiveStateChanged(UObjective* Objective, EObjectiveS
 			SetMissionStatus(EMissionStatus::Failed);
 			break;
 		case EObjectiveState::Completed:
-			bool bAllObjectivesComplete = true;
-			for (UObjective* MissionObjective : ObjectiveList)
-			{
-				if (!MissionObjective->IsOptionalObjective() && MissionObjective->GetObjecitveState() != EObjectiveState::Completed)
-				{
-					bAllObjectivesComplete = false;
-					break;
-				}
-			}
-
-			if (bAllObjectivesComplete)
+			if (CompletedRequiredObjectiveCount >= RequiredObjectiveCount)
 			{
 				SetMissionStatus(EMissionStatus::Completed);
 			}
@@ -399,6 +447,8 @@ void UMissionComponent::ObjectiveStateChanged(UObjective* Objective, EObjectiveS
 
 void UMissionComponent::ObjectiveProgressChanged(UObjective* Objective, float Progress)
 {
+	UpdateObjectiveAggregates(Objective);
+
 	K2_ObjectiveProgressChanged(Objective, Progress);
 
 	OnMissionProgressChanged.Broadcast(this, GetMissionProgress());
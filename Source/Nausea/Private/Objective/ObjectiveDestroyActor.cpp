@@ -40,7 +40,7 @@ FString UObjectiveDestroyActor::DescribeObjectiveToGameplayDebugger() const
 {
 	if (GetObjecitveState() == EObjectiveState::Active)
 	{
-		return FString::Printf(TEXT("%s {white}%i / %i"), *GetName(), RemainingActorList.Num(), ActorList.Num());
+		return FString::Printf(TEXT("%s {white}%i / %i"), *GetName(), RemainingActorSet.Num(), StartingActorCount);
 	}
 
 	return GetName();
@@ -67,7 +67,9 @@ UObjectiveDestroyActor* UObjectiveDestroyActor::CreateDestroyActorObjective(UObj
 void UObjectiveDestroyActor::BindObjectiveEvents()
 {
 	ActorList.Remove(nullptr);
-	RemainingActorList = ActorList;
+
+	RemainingActorSet.Reset();
+	RemainingActorSet.Reserve(ActorList.Num());
 
 	for (TWeakObjectPtr<AActor> Actor : ActorList)
 	{
@@ -82,8 +84,10 @@ void UObjectiveDestroyActor::BindObjectiveEvents()
 		}
 
 		Actor->OnDestroyed.AddDynamic(this, &UObjectiveDestroyActor::CharacterDestroyed);
+		RemainingActorSet.Add(Actor.Get());
 	}
 
+	StartingActorCount = ActorList.Num();
 	UpdateObjectiveProgress();
 }
 
@@ -91,47 +95,70 @@ void UObjectiveDestroyActor::UnBindObjectiveEvents()
 {
 	ActorList.Remove(nullptr);
 
-	for (TWeakObjectPtr<AActor> Actor : ActorList)
+	//Only actors that are still remaining are bound to.
+	for (const TObjectKey<AActor>& ActorKey : RemainingActorSet)
 	{
-		if (!Actor.IsValid())
+		AActor* Actor = ActorKey.ResolveObjectPtr();
+
+		if (!Actor)
 		{
 			continue;
 		}
 
-		if (UStatusComponent* StatusComponent = UStatusInterfaceStatics::GetStatusComponent(Actor.Get()))
+		if (UStatusComponent* StatusComponent = UStatusInterfaceStatics::GetStatusComponent(Actor))
 		{
 			StatusComponent->OnDied.RemoveDynamic(this, &UObjectiveDestroyActor::OnActorDied);
 		}
 
 		Actor->OnDestroyed.RemoveDynamic(this, &UObjectiveDestroyActor::CharacterDestroyed);
 	}
+
+	RemainingActorSet.Reset();
 }
 
 void UObjectiveDestroyActor::CharacterDestroyed(AActor* Character)
 {
-	if (UStatusComponent* StatusComponent = UStatusInterfaceStatics::GetStatusComponent(Character))
+	RemoveRemainingActor(Character);
+}
+
+void UObjectiveDestroyActor::OnActorDied(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	if (!Component)
 	{
-		OnActorDied(StatusComponent, 0.f, FDamageEvent(), nullptr, nullptr);
+		return;
 	}
+
+	RemoveRemainingActor(Component->GetOwner());
 }
 
-void UObjectiveDestroyActor::OnActorDied(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+void UObjectiveDestroyActor::RemoveRemainingActor(AActor* Actor)
 {
-	if (ActorList.Num() == 0)
+	if (!Actor || RemainingActorSet.Remove(Actor) == 0)
 	{
-		SetObjectiveProgress(0.f);
 		return;
 	}
 
-	RemainingActorList.Remove(Component->GetOwner());
+	if (UStatusComponent* StatusComponent = UStatusInterfaceStatics::GetStatusComponent(Actor))
+	{
+		StatusComponent->OnDied.RemoveDynamic(this, &UObjectiveDestroyActor::OnActorDied);
+	}
+
+	Actor->OnDestroyed.RemoveDynamic(this, &UObjectiveDestroyActor::CharacterDestroyed);
+
 	UpdateObjectiveProgress();
 }
 
 void UObjectiveDestroyActor::UpdateObjectiveProgress()
 {
-	SetObjectiveProgress(float(ActorList.Num() - RemainingActorList.Num()) / float(ActorList.Num()));
+	if (StartingActorCount <= 0)
+	{
+		SetObjectiveProgress(0.f);
+		return;
+	}
+
+	SetObjectiveProgress(float(StartingActorCount - RemainingActorSet.Num()) / float(StartingActorCount));
 
-	if (GetObjecitveProgress() == 1.f)
+	if (RemainingActorSet.Num() == 0)
 	{
 		Complete();
 	}
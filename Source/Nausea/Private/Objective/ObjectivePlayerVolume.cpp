@@ -12,7 +12,7 @@
 UObjectivePlayerVolume::UObjectivePlayerVolume(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-
+	OverlappingCharacters.SetOwningObjective(this);
 }
 
 void UObjectivePlayerVolume::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -96,7 +96,7 @@ float UObjectivePlayerVolume::GetPercentCharactersInObjective() const
 		return 0.f;
 	}
 
-	return float(OverlappingCharacters.Num()) / float(NumPlayers);
+	return float(OverlappingCharacterView.Num()) / float(NumPlayers);
 }
 
 int32 UObjectivePlayerVolume::GetNumberOfConsideredCharacters() const
@@ -111,27 +111,23 @@ int32 UObjectivePlayerVolume::GetNumberOfConsideredCharacters() const
 
 int32 UObjectivePlayerVolume::GetNumberOfOverlappingCharacters() const
 {
-	return OverlappingCharacters.Num();
+	return OverlappingCharacterView.Num();
 }
 
-TArray<ACoreCharacter*> UObjectivePlayerVolume::GetOverlappingCharacters() const
+bool UObjectivePlayerVolume::IsCharacterOverlapping(const ACoreCharacter* Character) const
 {
-	TArray<ACoreCharacter*> OutArray;
-	OutArray.Reserve(OverlappingCharacters.Num());
-
-	for (const TWeakObjectPtr<ACoreCharacter>& Character : OverlappingCharacters)
+	if (!Character)
 	{
-		if (!Character.IsValid())
-		{
-			continue;
-		}
-
-		OutArray.Add(Character.Get());
+		return false;
 	}
 
-	OutArray.Shrink();
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		const FObjectiveCharacterOverlapState* OverlapState = CharacterOverlapStateMap.Find(Character);
+		return OverlapState && OverlapState->ListIndex != INDEX_NONE;
+	}
 
-	return OutArray;
+	return OverlappingCharacterView.Contains(Character);
 }
 
 void UObjectivePlayerVolume::BindObjectiveEvents()
@@ -170,10 +166,46 @@ void UObjectivePlayerVolume::UnBindObjectiveEvents()
 		Actor->OnActorEndOverlap.RemoveDynamic(this, &UObjectivePlayerVolume::OnOverlapEnd);
 	}
 
-	TArray<TWeakObjectPtr<ACoreCharacter>> PreviousOverlappingCharacters = OverlappingCharacters;
-	OverlappingCharacters.Empty();
-	OnRep_OverlappingCharacters(PreviousOverlappingCharacters);
+	for (const TPair<TObjectKey<ACoreCharacter>, FObjectiveCharacterOverlapState>& Entry : CharacterOverlapStateMap)
+	{
+		ACoreCharacter* Character = Entry.Key.ResolveObjectPtr();
+
+		if (!Character)
+		{
+			continue;
+		}
+
+		Character->OnDestroyed.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
+
+		if (Entry.Value.ListIndex != INDEX_NONE && Character->GetStatusComponent())
+		{
+			Character->GetStatusComponent()->OnDied.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterKilled);
+		}
+	}
+
+	CharacterOverlapStateMap.Empty();
+	ListedCharacterKeyList.Empty();
+
+	if (OverlappingCharacters.CharacterList.Num() == 0 && OverlappingCharacterView.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<ACoreCharacter*> PreviousOverlappingCharacterView = MoveTemp(OverlappingCharacterView);
+	OverlappingCharacterView.Reset();
+	OverlappingCharacters.CharacterList.Empty();
+	OverlappingCharacters.MarkArrayDirty();
 	MARK_PROPERTY_DIRTY_FROM_NAME(UObjectivePlayerVolume, OverlappingCharacters, this);
+
+	for (ACoreCharacter* Character : PreviousOverlappingCharacterView)
+	{
+		if (IsValid(Character))
+		{
+			NotifyCharacterExited(Character);
+		}
+	}
+
+	NotifyCharacterListChanged();
 }
 
 void UObjectivePlayerVolume::GenerateInitialOverlaps()
@@ -197,16 +229,19 @@ void UObjectivePlayerVolume::GenerateInitialOverlaps()
 
 void UObjectivePlayerVolume::OnOverlapBegin(AActor* OverlapActor, AActor* OtherActor)
 {
-	if (!OtherActor)
+	ACoreCharacter* Character = Cast<ACoreCharacter>(OtherActor);
+
+	if (!Character)
 	{
 		return;
 	}
 
-	ACoreCharacter* Character = Cast<ACoreCharacter>(OtherActor);
+	FObjectiveCharacterOverlapState& OverlapState = CharacterOverlapStateMap.FindOrAdd(Character);
+	OverlapState.OverlapCount++;
 
-	if (!Character)
+	if (OverlapState.OverlapCount == 1)
 	{
-		return;
+		Character->OnDestroyed.AddDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
 	}
 
 	AddCharacter(Character);
@@ -214,11 +249,6 @@ void UObjectivePlayerVolume::OnOverlapBegin(AActor* OverlapActor, AActor* OtherA
 
 void UObjectivePlayerVolume::OnOverlapEnd(AActor* OverlapActor, AActor* OtherActor)
 {
-	if (!OtherActor)
-	{
-		return;
-	}
-
 	ACoreCharacter* Character = Cast<ACoreCharacter>(OtherActor);
 
 	if (!Character)
@@ -226,75 +256,107 @@ void UObjectivePlayerVolume::OnOverlapEnd(AActor* OverlapActor, AActor* OtherAct
 		return;
 	}
 
-	bool bStillOverlapping = false;
+	FObjectiveCharacterOverlapState* OverlapState = CharacterOverlapStateMap.Find(Character);
 
-	for (AActor* Actor : OverlapActors)
+	if (!OverlapState)
 	{
-		if (!Actor)
-		{
-			continue;
-		}
-
-		if (Actor->IsOverlappingActor(Character))
-		{
-			bStillOverlapping = true;
-			break;
-		}
+		return;
 	}
 
-	if (!bStillOverlapping)
+	OverlapState->OverlapCount--;
+
+	if (OverlapState->OverlapCount > 0)
 	{
-		RemoveCharacter(Character);
+		return;
 	}
+
+	RemoveCharacter(Character);
+	Character->OnDestroyed.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
+	CharacterOverlapStateMap.Remove(Character);
 }
 
 void UObjectivePlayerVolume::AddCharacter(ACoreCharacter* Character)
 {
-	TWeakObjectPtr<ACoreCharacter> CharacterWeakPtr(Character);
+	if (!Character || Character->IsDead())
+	{
+		return;
+	}
+
+	FObjectiveCharacterOverlapState* OverlapState = CharacterOverlapStateMap.Find(Character);
 
-	if (!CharacterWeakPtr.IsValid() || CharacterWeakPtr->IsDead() || OverlappingCharacters.Contains(CharacterWeakPtr))
+	if (!OverlapState || OverlapState->ListIndex != INDEX_NONE)
 	{
 		return;
 	}
 
-	CharacterWeakPtr->OnDestroyed.AddDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
-	
-	if (CharacterWeakPtr->GetStatusComponent())
+	if (Character->GetStatusComponent())
 	{
-		CharacterWeakPtr->GetStatusComponent()->OnDied.AddDynamic(this, &UObjectivePlayerVolume::CharacterKilled);
+		Character->GetStatusComponent()->OnDied.AddDynamic(this, &UObjectivePlayerVolume::CharacterKilled);
 	}
 
-	TArray<TWeakObjectPtr<ACoreCharacter>> PreviousOverlappingCharacters = OverlappingCharacters;
-	OverlappingCharacters.AddUnique(CharacterWeakPtr);
-	OnRep_OverlappingCharacters(PreviousOverlappingCharacters);
+	OverlapState->ListIndex = OverlappingCharacters.CharacterList.Emplace(Character);
+	ListedCharacterKeyList.Add(Character);
+	OverlappingCharacterView.Add(Character);
+	OverlappingCharacters.MarkItemDirty(OverlappingCharacters.CharacterList[OverlapState->ListIndex]);
 	MARK_PROPERTY_DIRTY_FROM_NAME(UObjectivePlayerVolume, OverlappingCharacters, this);
+
+	NotifyCharacterEntered(Character);
+	NotifyCharacterListChanged();
 }
 
 void UObjectivePlayerVolume::RemoveCharacter(ACoreCharacter* Character)
 {
-	TWeakObjectPtr<ACoreCharacter> CharacterWeakPtr(Character);
+	if (!Character)
+	{
+		return;
+	}
 
-	if (!CharacterWeakPtr.IsValid() || !OverlappingCharacters.Contains(CharacterWeakPtr))
+	FObjectiveCharacterOverlapState* OverlapState = CharacterOverlapStateMap.Find(Character);
+
+	if (!OverlapState || OverlapState->ListIndex == INDEX_NONE)
 	{
 		return;
 	}
 
-	CharacterWeakPtr->OnDestroyed.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
+	if (Character->GetStatusComponent())
+	{
+		Character->GetStatusComponent()->OnDied.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterKilled);
+	}
+
+	//The server's view is kept parallel to the replicated list so both can be removed from by swapping.
+	const int32 ListIndex = OverlapState->ListIndex;
+	OverlapState->ListIndex = INDEX_NONE;
+	OverlappingCharacters.CharacterList.RemoveAtSwap(ListIndex, 1, false);
+	ListedCharacterKeyList.RemoveAtSwap(ListIndex, 1, false);
+	OverlappingCharacterView.RemoveAtSwap(ListIndex, 1, false);
 
-	if (CharacterWeakPtr->GetStatusComponent())
+	if (ListedCharacterKeyList.IsValidIndex(ListIndex))
 	{
-		CharacterWeakPtr->GetStatusComponent()->OnDied.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterKilled);
+		if (FObjectiveCharacterOverlapState* MovedOverlapState = CharacterOverlapStateMap.Find(ListedCharacterKeyList[ListIndex]))
+		{
+			MovedOverlapState->ListIndex = ListIndex;
+		}
 	}
 
-	TArray<TWeakObjectPtr<ACoreCharacter>> PreviousOverlappingCharacters = OverlappingCharacters;
-	OverlappingCharacters.Remove(CharacterWeakPtr);
-	OnRep_OverlappingCharacters(PreviousOverlappingCharacters);
+	OverlappingCharacters.MarkArrayDirty();
 	MARK_PROPERTY_DIRTY_FROM_NAME(UObjectivePlayerVolume, OverlappingCharacters, this);
+
+	NotifyCharacterExited(Character);
+	NotifyCharacterListChanged();
 }
 
 void UObjectivePlayerVolume::CharacterDestroyed(AActor* Character)
 {
-	RemoveCharacter(Cast<ACoreCharacter>(Character));
+	ACoreCharacter* CoreCharacter = Cast<ACoreCharacter>(Character);
+
+	if (!CoreCharacter)
+	{
+		return;
+	}
+
+	RemoveCharacter(CoreCharacter);
+	CoreCharacter->OnDestroyed.RemoveDynamic(this, &UObjectivePlayerVolume::CharacterDestroyed);
+	CharacterOverlapStateMap.Remove(CoreCharacter);
 }
 
 void UObjectivePlayerVolume::CharacterKilled(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -304,13 +366,14 @@ void UObjectivePlayerVolume::CharacterKilled(UStatusComponent* Component, float
 		return;
 	}
 
+	//Dead characters keep their overlap count so that the count stays correct should they be revived while inside the volume.
 	RemoveCharacter(Cast<ACoreCharacter>(Component->GetOwner()));
 }
 
 void UObjectivePlayerVolume::NotifyKilled(AController* Killer, AController* Killed, ACoreCharacter* KilledCharacter, const struct FDamageEvent& DamageEvent)
 {
 	//Allow UObjectivePlayerVolume::CharacterKilled to handle this as it clearly has not yet.
-	if (OverlappingCharacters.Contains(TWeakObjectPtr<ACoreCharacter>(KilledCharacter)))
+	if (IsCharacterOverlapping(KilledCharacter))
 	{
 		return;
 	}
@@ -318,26 +381,77 @@ void UObjectivePlayerVolume::NotifyKilled(AController* Killer, AController* Kill
 	K2_OnPlayerKilled(Killer, Killed, KilledCharacter, DamageEvent);
 }
 
-void UObjectivePlayerVolume::OnRep_OverlappingCharacters(TArray<TWeakObjectPtr<ACoreCharacter>> PreviousOverlappingCharacters)
+void UObjectivePlayerVolume::NotifyCharacterEntered(ACoreCharacter* Character)
+{
+	K2_OnPlayerEntered(Character);
+	OnPlayerEnteredObjective.Broadcast(this, Character);
+}
+
+void UObjectivePlayerVolume::NotifyCharacterExited(ACoreCharacter* Character)
+{
+	K2_OnPlayerExited(Character);
+	OnPlayerExitedObjective.Broadcast(this, Character);
+}
+
+void UObjectivePlayerVolume::NotifyCharacterListChanged()
 {
-	for (TWeakObjectPtr<ACoreCharacter> Character : PreviousOverlappingCharacters)
+	K2_OnPlayerListChanged();
+	OnPlayerListChanged.Broadcast(this);
+}
+
+void FObjectiveOverlappingCharacterContainer::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	if (!OwningObjective)
 	{
-		if (Character.IsValid() && !OverlappingCharacters.Contains(Character))
+		return;
+	}
+
+	bool bListChanged = false;
+	for (const int32& Index : AddedIndices)
+	{
+		ACoreCharacter* Character = CharacterList[Index].Character.Get();
+
+		//Characters that are not yet relevant to this client are picked up in PostReplicatedChange once their reference is mapped.
+		if (!Character || OwningObjective->OverlappingCharacterView.Contains(Character))
 		{
-			K2_OnPlayerEntered(Character.Get());
-			OnPlayerExitedObjective.Broadcast(this, Character.Get());
+			continue;
 		}
+
+		OwningObjective->OverlappingCharacterView.Add(Character);
+		OwningObjective->NotifyCharacterEntered(Character);
+		bListChanged = true;
 	}
 
-	for (TWeakObjectPtr<ACoreCharacter> Character : OverlappingCharacters)
+	if (bListChanged)
+	{
+		OwningObjective->NotifyCharacterListChanged();
+	}
+}
+
+void FObjectiveOverlappingCharacterContainer::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	if (!OwningObjective)
 	{
-		if (Character.IsValid() && !PreviousOverlappingCharacters.Contains(Character))
+		return;
+	}
+
+	for (const int32& Index : RemovedIndices)
+	{
+		ACoreCharacter* Character = CharacterList[Index].Character.Get();
+
+		if (!Character || OwningObjective->OverlappingCharacterView.RemoveSingleSwap(Character, false) == 0)
 		{
-			K2_OnPlayerExited(Character.Get());
-			OnPlayerEnteredObjective.Broadcast(this, Character.Get());
+			continue;
 		}
+
+		OwningObjective->NotifyCharacterExited(Character);
 	}
 
-	K2_OnPlayerListChanged();
-	OnPlayerListChanged.Broadcast(this);
-}
\ No newline at end of file
+	OwningObjective->OverlappingCharacterView.RemoveAllSwap([](const ACoreCharacter* Character) { return !IsValid(Character); }, false);
+	OwningObjective->NotifyCharacterListChanged();
+}
+
+void FObjectiveOverlappingCharacterContainer::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	PostReplicatedAdd(ChangedIndices, FinalSize);
+}
@@ -6,6 +6,7 @@
 #include "GameFramework/GameModeBase.h"
 #include "NauseaNetDefines.h"
 #include "System/SpawnCharacterSystem.h"
+#include "System/WaveContentPreloader.h"
 #include "Objective/WaveConfig/WaveSpawnLocationInterface.h"
 #include "Character/CoreCharacter.h"
 #include "Gameplay/StatusComponent.h"
@@ -48,6 +49,7 @@ void UObjectiveWave::Initialize(UMissionComponent* MissionComponent)
 	if (WaveConfigInstance)
 	{
 		WaveConfigInstance->Initialize();
+		WaveConfigInstance->RequestContentPreload();
 	}
 }
 
@@ -532,6 +534,13 @@ void UObjectiveWaveConfig::Initialize()
 	ensure(GetOwningObjective());
 }
 
+void UObjectiveWaveConfig::RequestContentPreload()
+{
+	TArray<FSoftObjectPath> AssetList;
+	AppendPreloadAssetList(AssetList);
+	UWaveContentPreloader::RequestPreload(this, this, 0, AssetList);
+}
+
 void UObjectiveWaveConfig::SetActive(bool bNewIsActive)
 {
 	if (!GetOwningObjective()->IsAuthority() || bIsActive == bNewIsActive)
@@ -565,6 +574,7 @@ void UObjectiveWaveConfig::StartSpawning()
 void UObjectiveWaveConfig::StopSpawning()
 {
 	SetWaveStatus(EWaveStatus::Completed);
+	UWaveContentPreloader::ReleaseAllPreloads(this, this);
 
 	CurrentlySpawnedCharacters.RemoveSwap(nullptr);
 
@@ -6,6 +6,7 @@
 #include "TimerManager.h"
 #include "Internationalization/StringTableRegistry.h"
 #include "GameFramework/GameStateBase.h"
+#include "System/WaveContentPreloader.h"
 
 UMultiWaveConfig::UMultiWaveConfig(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -57,6 +58,24 @@ void UMultiWaveConfig::Initialize()
 	WaveCountUpdated();
 }
 
+void UMultiWaveConfig::RequestContentPreload()
+{
+	PreloadUpcomingWaves(FMath::Max(GetCurrentWaveIndex(), 0));
+}
+
+void UMultiWaveConfig::AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const
+{
+	for (const UObjectiveWaveConfig* WaveInstance : WaveInstanceList)
+	{
+		if (!WaveInstance)
+		{
+			continue;
+		}
+
+		WaveInstance->AppendPreloadAssetList(AssetList);
+	}
+}
+
 void UMultiWaveConfig::StartSpawning()
 {
 	SetCurrentWaveIndex(0);
@@ -75,6 +94,7 @@ void UMultiWaveConfig::StopSpawning()
 	SetWaveStatus(EWaveStatus::Completed);
 	SetCurrentWaveIndex(GetTotalWaveCount() - 1);
 	ActiveWaveConfigInstance = nullptr;
+	UWaveContentPreloader::ReleaseAllPreloads(this, this);
 }
 
 FString UMultiWaveConfig::DescribeWaveConfigToGameplayDebugger() const
@@ -121,6 +141,7 @@ void UMultiWaveConfig::StartNextWave()
 	ActiveWaveConfigInstance = WaveInstanceList[GetCurrentWaveIndex()];
 	ActiveWaveConfigInstance->SetActive(true);
 	BindToActiveWaveInstance();
+	PreloadUpcomingWaves(GetCurrentWaveIndex());
 
 	SetWaveStatus(EWaveStatus::InProgress);
 }
@@ -197,9 +218,29 @@ void UMultiWaveConfig::WaveCountUpdated()
 	OnWaveConfigTotalWaveCountChanged.Broadcast(this, GetTotalWaveCount());
 }
 
+void UMultiWaveConfig::PreloadUpcomingWaves(int32 WaveIndex)
+{
+	UWaveContentPreloader::ReleasePreloadsBefore(this, this, WaveIndex);
+
+	TArray<FSoftObjectPath> AssetList;
+	const int32 LastPreloadWaveIndex = FMath::Min(WaveIndex + PreloadWaveCount, WaveInstanceList.Num() - 1);
+	for (int32 PreloadWaveIndex = WaveIndex; PreloadWaveIndex <= LastPreloadWaveIndex; PreloadWaveIndex++)
+	{
+		if (!WaveInstanceList[PreloadWaveIndex])
+		{
+			continue;
+		}
+
+		AssetList.Reset();
+		WaveInstanceList[PreloadWaveIndex]->AppendPreloadAssetList(AssetList);
+		UWaveContentPreloader::RequestPreload(this, this, PreloadWaveIndex, AssetList);
+	}
+}
+
 void UMultiWaveConfig::StartWaveIntermission()
 {
 	SetWaveStatus(EWaveStatus::Intermission);
+	PreloadUpcomingWaves(GetCurrentWaveIndex() + 1);
 
 	if (WaveIntermissionDuration > 0.f)
 	{
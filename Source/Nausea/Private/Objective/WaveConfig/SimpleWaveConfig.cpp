@@ -6,6 +6,7 @@
 #include "TimerManager.h"
 #include "System/SpawnCharacterSystem.h"
 #include "Character/CoreCharacter.h"
+#include "System/WaveContentPreloader.h"
 
 TSubclassOf<ACoreCharacter> FSpawnGroupEntry::GetNextSpawnClass()
 {
@@ -56,43 +57,68 @@ void FSpawnGroupEntry::AppendSpawns(const TArray<TSubclassOf<ACoreCharacter>>& S
 	}
 }
 
-USimpleWaveConfig::USimpleWaveConfig(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer)
+void FSpawnGroupEntry::AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const
 {
+	if (!SpawnGroup)
+	{
+		return;
+	}
+
+	const TMap<TSoftClassPtr<ACoreCharacter>, int32>& CDOSpawnGroup = SpawnGroup.GetDefaultObject()->GetSpawnGroup();
 
+	AssetList.Reserve(AssetList.Num() + CDOSpawnGroup.Num());
+	for (const TPair<TSoftClassPtr<ACoreCharacter>, int32>& CDOEntry : CDOSpawnGroup)
+	{
+		if (CDOEntry.Key.IsNull())
+		{
+			continue;
+		}
+
+		AssetList.Add(CDOEntry.Key.ToSoftObjectPath());
+	}
 }
 
-void USimpleWaveConfig::Initialize()
+void FSpawnGroupEntry::ResolveSpawnMap()
 {
-	Super::Initialize();
+	if (!SpawnGroup)
+	{
+		return;
+	}
 
-	for (FSpawnGroupEntry& SpawnGroupEntry : SpawnGroupList)
+	const TMap<TSoftClassPtr<ACoreCharacter>, int32>& CDOSpawnGroup = SpawnGroup.GetDefaultObject()->GetSpawnGroup();
+
+	for (const TPair<TSoftClassPtr<ACoreCharacter>, int32>& CDOEntry : CDOSpawnGroup)
 	{
-		if (!SpawnGroupEntry.SpawnGroup)
+		if (CDOEntry.Key.IsNull())
 		{
 			continue;
 		}
 
-		const TMap<TSoftClassPtr<ACoreCharacter>, int32>& CDOSpawnGroup = SpawnGroupEntry.SpawnGroup.GetDefaultObject()->GetSpawnGroup();
-
-		for (const TPair<TSoftClassPtr<ACoreCharacter>, int32>& CDOEntry : CDOSpawnGroup)
+		if (TSubclassOf<ACoreCharacter> CharacterClass = UWaveContentPreloader::ResolveClass(CDOEntry.Key))
 		{
-			if (CDOEntry.Key.IsNull())
-			{
-				continue;
-			}
-
-			if (TSubclassOf<ACoreCharacter> CharacterClass = CDOEntry.Key.LoadSynchronous())
-			{
-				SpawnGroupEntry.LoadedSpawnMap.Add(CharacterClass) = CDOEntry.Value;
-			}
+			LoadedSpawnMap.Add(CharacterClass) = CDOEntry.Value;
 		}
 	}
 }
 
+USimpleWaveConfig::USimpleWaveConfig(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void USimpleWaveConfig::AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const
+{
+	for (const FSpawnGroupEntry& SpawnGroupEntry : SpawnGroupList)
+	{
+		SpawnGroupEntry.AppendPreloadAssetList(AssetList);
+	}
+}
+
 void USimpleWaveConfig::StartSpawning()
 {
 	RemainingWaitingToSpawnCount = GetTotalSpawnCount();
+	ResolveSpawnGroupList();
 	GenerateSpawnGroupArray();
 	Super::StartSpawning();
 
@@ -289,6 +315,21 @@ void USimpleWaveConfig::PerformSpawn(int32& NumberOfSpawns, uint8 RetryCount)
 	PerformSpawn(NumberOfSpawns, RetryCount);
 }
 
+void USimpleWaveConfig::ResolveSpawnGroupList()
+{
+	if (bResolvedSpawnGroupList)
+	{
+		return;
+	}
+
+	bResolvedSpawnGroupList = true;
+
+	for (FSpawnGroupEntry& SpawnGroupEntry : SpawnGroupList)
+	{
+		SpawnGroupEntry.ResolveSpawnMap();
+	}
+}
+
 void USimpleWaveConfig::GenerateSpawnGroupArray()
 {
 	CurrentSpawnGroupList = SpawnGroupList;
@@ -290,6 +290,35 @@ void ADungeonGameMode::StartNextWave()
 	WaveSetup->StartWave(WaveNumber);
 }
 
+bool ADungeonGameMode::ForceStartNextWave()
+{
+	ADungeonGameState* DungeonGameState = GetGameState<ADungeonGameState>();
+
+	if (!DungeonGameState || !DungeonGameState->IsInProgress())
+	{
+		return false;
+	}
+
+	UDungeonWaveSetup* WaveSetup = DungeonGameState->GetWaveSetup();
+
+	if (!WaveSetup)
+	{
+		return false;
+	}
+
+	const int64 CurrentWaveNumber = DungeonGameState->GetCurrentWaveNumber();
+
+	if ((CurrentWaveNumber > 0 && WaveSetup->IsFinalWave(CurrentWaveNumber)) || !WaveSetup->IsCurrentWaveDoneSpawning())
+	{
+		return false;
+	}
+
+	GetWorld()->GetTimerManager().ClearTimer(AutoStartWaveTimerHandle);
+	DungeonGameState->SetAutoStartTime(-1.f);
+	StartNextWave();
+	return true;
+}
+
 void ADungeonGameMode::PerformAutoStart(int32 AutoStartTime)
 {
 	ADungeonGameState* DungeonGameState = GetGameState<ADungeonGameState>();
@@ -3,6 +3,7 @@
 
 #include "Overlord/DungeonGameModeSettings.h"
 #include "System/CoreSingleton.h"
+#include "System/WaveContentPreloader.h"
 #include "Overlord/DungeonGameMode.h"
 #include "Character/DungeonCharacter.h"
 
@@ -155,6 +156,58 @@ void UDungeonWaveSetup::GetCharacterClassListForWave(int64 WaveNumber, TArray<TS
 	}
 }
 
+void UDungeonWaveSetup::PreloadUpcomingWaves(int64 WaveNumber)
+{
+	UWaveContentPreloader::ReleasePreloadsBefore(this, this, WaveNumber);
+
+	TArray<FSoftObjectPath> AssetList;
+	for (int64 PreloadWaveNumber = WaveNumber; PreloadWaveNumber <= WaveNumber + PreloadWaveCount; PreloadWaveNumber++)
+	{
+		//LastWaveNumber of 0 means this setup is endless.
+		if (LastWaveNumber > 0 && PreloadWaveNumber > LastWaveNumber)
+		{
+			break;
+		}
+
+		AssetList.Reset();
+		GetPreloadAssetListForWave(PreloadWaveNumber, AssetList);
+		UWaveContentPreloader::RequestPreload(this, this, PreloadWaveNumber, AssetList);
+	}
+}
+
+void UDungeonWaveSetup::GetPreloadAssetListForWave(int64 WaveNumber, TArray<FSoftObjectPath>& AssetList) const
+{
+	TArray<UWaveConfiguration*> WaveConfiguration = GetWaveConfiguration(WaveNumber);
+
+	for (UWaveConfiguration* Configuration : WaveConfiguration)
+	{
+		if (!Configuration)
+		{
+			continue;
+		}
+
+		Configuration->AppendPreloadAssetList(AssetList);
+	}
+}
+
+bool UDungeonWaveSetup::IsCurrentWaveDoneSpawning() const
+{
+	if (InitializedWave == -1)
+	{
+		return true;
+	}
+
+	for (const UWaveConfiguration* Configuration : GetWaveConfiguration(InitializedWave))
+	{
+		if (Configuration && Configuration->IsInitialized() && !Configuration->IsDoneSpawning())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void UDungeonWaveSetup::OnWaveCharacterListEmpty()
 {
 	if (DefaultWaveConfiguration && DefaultWaveConfiguration->IsInitialized() && !DefaultWaveConfiguration->IsDoneSpawning())
@@ -410,6 +463,19 @@ void UWaveConfiguration::AppendCharacterClassListForWave(int64 WaveNumber, TArra
 	}
 }
 
+void UWaveConfiguration::AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const
+{
+	for (const UWaveSpawnGroup* Group : SpawnWaveGroups)
+	{
+		if (!Group)
+		{
+			continue;
+		}
+
+		Group->AppendPreloadAssetList(AssetList);
+	}
+}
+
 UWaveConfiguration* UWaveConfiguration::CreateWaveConfiguration(UObject* WorldContextObject, TSubclassOf<UWaveConfiguration> WaveClass, FGameplayTagContainer AdditionalSpawnerTags,
 	bool bClearWaveClassSpawnTags, int32 BaseSpawnCountOverride, int32 SpawnTimeOffsetOverride, int32 SpawnIntervalTimeOverride, int32 SpawnBatchAmountOverride)
 {
@@ -742,7 +808,7 @@ void FWaveSpawnGroupEntry::Initialize()
 {
 	if (!LoadedCharacter)
 	{
-		LoadedCharacter = Character.LoadSynchronous();
+		LoadedCharacter = UWaveContentPreloader::ResolveClass(Character);
 	}
 	RemainingToSpawn = SpawnCount;
 }
@@ -776,7 +842,7 @@ TSubclassOf<ADungeonCharacter> FWaveSpawnGroupEntry::GetClass() const
 		return LoadedCharacter;
 	}
 
-	LoadedCharacter = Character.LoadSynchronous();
+	LoadedCharacter = UWaveContentPreloader::ResolveClass(Character);
 	return LoadedCharacter;
 }
 
@@ -803,6 +869,20 @@ void UWaveSpawnGroup::AppendCharacterClassListForWave(int64 WaveNumber, TArray<T
 	}
 }
 
+void UWaveSpawnGroup::AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const
+{
+	AssetList.Reserve(AssetList.Num() + SpawnList.Num());
+	for (const FWaveSpawnGroupEntry& Entry : SpawnList)
+	{
+		if (Entry.GetSoftClass().IsNull())
+		{
+			continue;
+		}
+
+		AssetList.Add(Entry.GetSoftClass().ToSoftObjectPath());
+	}
+}
+
 bool UWaveSpawnGroup::HasRemainingSpawns() const
 {
 	for (const FWaveSpawnGroupEntry& Entry : SpawnList)
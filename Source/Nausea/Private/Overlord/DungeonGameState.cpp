@@ -7,11 +7,15 @@
 #include "System/CoreWorldSettings.h"
 #include "System/DungeonLevelScriptActor.h"
 #include "Overlord/DungeonGameModeSettings.h"
+#include "Overlord/TrapManager.h"
+#include "Character/HordeReplicationManager.h"
+#include "System/WaveContentPreloader.h"
 
 ADungeonGameState::ADungeonGameState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-
+	TrapManager = CreateDefaultSubobject<UTrapManager>(TEXT("TrapManager"));
+	HordeReplicationManager = CreateDefaultSubobject<UHordeReplicationManager>(TEXT("HordeReplicationManager"));
 }
 
 void ADungeonGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -49,11 +53,22 @@ void ADungeonGameState::OnRep_MatchState()
 void ADungeonGameState::HandleMatchHasStarted()
 {
 	Super::HandleMatchHasStarted();
+
+	//Start streaming in the first waves while the match auto start is counting down.
+	if (UDungeonWaveSetup* WaveSetup = GetWaveSetup())
+	{
+		WaveSetup->PreloadUpcomingWaves(CurrentWaveNumber + 1);
+	}
 }
 
 void ADungeonGameState::HandleMatchHasEnded()
 {
 	Super::HandleMatchHasEnded();
+
+	if (CurrentWaveSetup)
+	{
+		UWaveContentPreloader::ReleaseAllPreloads(this, CurrentWaveSetup);
+	}
 }
 
 bool ADungeonGameState::IsInEndGameState() const
@@ -206,6 +221,13 @@ void ADungeonGameState::UpdateDungeonCharacterClassList()
 void ADungeonGameState::OnRep_CurrentWaveNumber(int64 PreviousWaveNumber)
 {
 	UpdateDungeonCharacterClassList();
+
+	//The current wave's content is now held by the class list, so move the preload window on to the next waves.
+	if (UDungeonWaveSetup* WaveSetup = GetWaveSetup())
+	{
+		WaveSetup->PreloadUpcomingWaves(CurrentWaveNumber + 1);
+	}
+
 	OnCurrentWaveNumberChanged.Broadcast(this, CurrentWaveNumber, PreviousWaveNumber);
 }
 
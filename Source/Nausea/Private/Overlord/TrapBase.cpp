@@ -6,6 +6,7 @@
 #include "Player/DungeonPlayerController.h"
 #include "Player/DungeonPlayerState.h"
 #include "Overlord/PlacementActor.h"
+#include "Overlord/TrapManager.h"
 #include "Components/PrimitiveComponent.h"
 #include "UI/CoreWidgetComponent.h"
 
@@ -124,45 +125,23 @@ void ATrapBase::RevokeOccupancy()
 	OccupiedHandleList.Reset();
 }
 
-TArray<AActor*> ATrapBase::PerformOverlapTestWithPrimitive(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, TArray<AActor*> ActorsToIgnore)
+void ATrapBase::OnTrapActivationResolved(UPrimitiveComponent* Component, const TArray<AActor*>& HitActorList)
 {
-	if (!GetWorld() || !Component)
-	{
-		return TArray<AActor*>();
-	}
-
-	static TArray<FOverlapResult> OverlapList;
-	OverlapList.Reset();
-
-	FTransform OverlapTransform = Component->GetComponentTransform();
-	FCollisionShape OverlapShape = Component->GetCollisionShape();
-	GetWorld()->OverlapMultiByObjectType(OverlapList, OverlapTransform.GetLocation(), OverlapTransform.GetRotation(), FCollisionObjectQueryParams(ECC_DungeonPawn), OverlapShape);
-
-	if (OverlapList.Num() == 0)
-	{
-		return TArray<AActor*>();
-	}
-
-	static TSet<AActor*> OverlapActorSet;
-	OverlapActorSet.Reset();
-	for (const FOverlapResult& Result : OverlapList)
-	{
-		OverlapActorSet.Add(Result.GetActor());
-	}
-
-	return OverlapActorSet.Array();
+	K2_OnTrapActivationResolved(Component, HitActorList);
 }
 
-TArray<AActor*> ATrapBase::PerformOverlapTestWithPrimitiveAndApplyDamage(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, TArray<AActor*> ActorsToIgnore)
+TArray<AActor*> ATrapBase::PerformOverlapTestWithPrimitive(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore)
 {
-	static TArray<AActor*> OverlapActorList;
-	OverlapActorList = PerformOverlapTestWithPrimitive(Component, ActorClassFilter, ActorsToIgnore);
-
-	
-
+	TArray<AActor*> OverlapActorList;
+	UTrapManager::PerformOverlapTest(Component, ActorClassFilter, ActorsToIgnore, OverlapActorList);
 	return OverlapActorList;
 }
 
+bool ATrapBase::PerformOverlapTestWithPrimitiveAndApplyDamage(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TSubclassOf<UDamageType> DamageType, float Damage)
+{
+	return UTrapManager::QueueTrapActivation(this, Component, ActorClassFilter, ActorsToIgnore, DamageType, Damage);
+}
+
 TSoftObjectPtr<UTexture2D> ATrapBase::GetTrapIconForClass(TSubclassOf<ATrapBase> TrapClass)
 {
 	if (const ATrapBase* TrapCDO = TrapClass.GetDefaultObject())
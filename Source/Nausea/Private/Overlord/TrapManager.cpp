@@ -0,0 +1,317 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "Overlord/TrapManager.h"
+#include "Nausea.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/DamageType.h"
+#include "NauseaGlobalDefines.h"
+#include "Overlord/TrapBase.h"
+#include "Overlord/DungeonGameState.h"
+
+DECLARE_STATS_GROUP(TEXT("TrapManager"), STATGROUP_TrapManager, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Trap Activations"), STAT_TrapManagerResolveActivations, STATGROUP_TrapManager);
+DECLARE_CYCLE_STAT(TEXT("Apply Trap Damage"), STAT_TrapManagerApplyDamage, STATGROUP_TrapManager);
+
+UTrapManager::UTrapManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UTrapManager::Tick(float DeltaTime)
+{
+	ResolvePendingActivations();
+}
+
+inline UTrapManager* GetTrapManager(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ADungeonGameState* DungeonGameState = World->GetGameState<ADungeonGameState>();
+
+	if (!DungeonGameState)
+	{
+		return nullptr;
+	}
+
+	return DungeonGameState->GetTrapManager();
+}
+
+bool UTrapManager::QueueTrapActivation(ATrapBase* Trap, UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TSubclassOf<UDamageType> DamageType, float Damage)
+{
+	if (!Trap || !Component || Trap->GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	UTrapManager* TrapManager = GetTrapManager(Trap);
+
+	if (!TrapManager)
+	{
+		return false;
+	}
+
+	TrapManager->PendingActivationList.Emplace(Trap, Component, ActorClassFilter, ActorsToIgnore, DamageType, Damage);
+	return true;
+}
+
+void UTrapManager::PerformOverlapTest(const UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TArray<AActor*>& OutActorList)
+{
+	OutActorList.Reset();
+
+	UWorld* World = Component ? Component->GetWorld() : nullptr;
+
+	if (!World)
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TrapOverlap), false, Component->GetOwner());
+	QueryParams.AddIgnoredActors(ActorsToIgnore);
+
+	TArray<FOverlapResult> OverlapList;
+	const FTransform& OverlapTransform = Component->GetComponentTransform();
+	World->OverlapMultiByObjectType(OverlapList, OverlapTransform.GetLocation(), OverlapTransform.GetRotation(), FCollisionObjectQueryParams(ECC_DungeonPawn), Component->GetCollisionShape(), QueryParams);
+
+	OutActorList.Reserve(OverlapList.Num());
+	for (const FOverlapResult& Result : OverlapList)
+	{
+		AActor* Actor = Result.GetActor();
+
+		if (!Actor || (ActorClassFilter && !Actor->IsA(ActorClassFilter)))
+		{
+			continue;
+		}
+
+		OutActorList.AddUnique(Actor);
+	}
+}
+
+void UTrapManager::ResolvePendingActivations()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrapManagerResolveActivations);
+	CSV_SCOPED_TIMING_STAT(Nausea, TrapManagerResolveActivations);
+
+	Swap(ResolvingActivationList, PendingActivationList);
+	PendingActivationList.Reset();
+
+	ResolvingActivationList.RemoveAllSwap([](const FTrapActivation& Activation)
+	{
+		return !Activation.Trap.IsValid() || !Activation.Component.IsValid();
+	}, false);
+
+	if (ResolvingActivationList.Num() == 0)
+	{
+		return;
+	}
+
+	BuildActivationClusters();
+
+	HitActorList.Reset();
+	for (int32 ClusterIndex = 0; ClusterIndex < ClusterList.Num(); ClusterIndex++)
+	{
+		GatherOverlapCandidates(ClusterList[ClusterIndex]);
+
+		for (FTrapActivation& Activation : ResolvingActivationList)
+		{
+			if (Activation.ClusterIndex == ClusterIndex)
+			{
+				ResolveActivation(Activation);
+			}
+		}
+	}
+
+	ApplyPendingDamage();
+
+	TArray<AActor*> TrapHitActorList;
+	for (const FTrapActivation& Activation : ResolvingActivationList)
+	{
+		ATrapBase* Trap = Activation.Trap.Get();
+
+		if (!Trap || !Activation.Component.IsValid())
+		{
+			continue;
+		}
+
+		TrapHitActorList.Reset(Activation.HitCount);
+		TrapHitActorList.Append(HitActorList.GetData() + Activation.HitStartIndex, Activation.HitCount);
+		Trap->OnTrapActivationResolved(Activation.Component.Get(), TrapHitActorList);
+	}
+
+	ResolvingActivationList.Reset();
+	ClusterList.Reset();
+	CandidateList.Reset();
+	HitActorList.Reset();
+}
+
+inline float GetBoundsVolume(const FBox& Bounds)
+{
+	//Flat primitives would otherwise have no volume and always fail to cluster.
+	const FVector Size = Bounds.GetSize().ComponentMax(FVector(1.f));
+	return Size.X * Size.Y * Size.Z;
+}
+
+void UTrapManager::BuildActivationClusters()
+{
+	ClusterList.Reset();
+
+	for (FTrapActivation& Activation : ResolvingActivationList)
+	{
+		const FBox ActivationBounds = Activation.Component->Bounds.GetBox();
+		const float ActivationVolume = GetBoundsVolume(ActivationBounds);
+		Activation.ClusterIndex = INDEX_NONE;
+
+		for (int32 Index = 0; Index < ClusterList.Num(); Index++)
+		{
+			FTrapActivationCluster& Cluster = ClusterList[Index];
+			const FBox MergedBounds = Cluster.Bounds + ActivationBounds;
+
+			//Merging activations far apart from each other would turn the shared query into one covering everything in between.
+			if (GetBoundsVolume(MergedBounds) > (Cluster.MemberVolume + ActivationVolume) * MaxClusterVolumeScale)
+			{
+				continue;
+			}
+
+			Cluster.Bounds = MergedBounds;
+			Cluster.MemberVolume += ActivationVolume;
+			Activation.ClusterIndex = Index;
+			break;
+		}
+
+		if (Activation.ClusterIndex != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Activation.ClusterIndex = ClusterList.AddDefaulted();
+		ClusterList[Activation.ClusterIndex].Bounds = ActivationBounds;
+		ClusterList[Activation.ClusterIndex].MemberVolume = ActivationVolume;
+	}
+}
+
+void UTrapManager::GatherOverlapCandidates(const FTrapActivationCluster& Cluster)
+{
+	CandidateList.Reset();
+
+	if (!Cluster.Bounds.IsValid)
+	{
+		return;
+	}
+
+	OverlapResultList.Reset();
+	GetWorld()->OverlapMultiByObjectType(OverlapResultList, Cluster.Bounds.GetCenter(), FQuat::Identity, FCollisionObjectQueryParams(ECC_DungeonPawn),
+		FCollisionShape::MakeBox(Cluster.Bounds.GetExtent()), FCollisionQueryParams(SCENE_QUERY_STAT(TrapManagerOverlap), false));
+
+	CandidateList.Reserve(OverlapResultList.Num());
+	for (const FOverlapResult& Result : OverlapResultList)
+	{
+		AActor* Actor = Result.GetActor();
+		UPrimitiveComponent* Component = Result.GetComponent();
+
+		if (!Actor || !Component)
+		{
+			continue;
+		}
+
+		FTrapOverlapCandidate& Candidate = CandidateList[CandidateList.Emplace(Actor, Component)];
+		Candidate.Bounds = Component->Bounds.GetBox();
+	}
+}
+
+void UTrapManager::ResolveActivation(FTrapActivation& Activation)
+{
+	const UPrimitiveComponent* TrapComponent = Activation.Component.Get();
+	const FBox TrapBounds = TrapComponent->Bounds.GetBox();
+	const FTransform& TrapTransform = TrapComponent->GetComponentTransform();
+	const FCollisionShape TrapShape = TrapComponent->GetCollisionShape();
+
+	Activation.HitStartIndex = HitActorList.Num();
+	ActivationHitActorSet.Reset();
+
+	for (const FTrapOverlapCandidate& Candidate : CandidateList)
+	{
+		if (Candidate.Actor == Activation.Trap.Get() || (Activation.ActorClassFilter && !Candidate.Actor->IsA(Activation.ActorClassFilter)))
+		{
+			continue;
+		}
+
+		//Pawns made of several dungeon pawn primitives show up once per primitive, but must only be hit once per activation.
+		if (ActivationHitActorSet.Contains(Candidate.Actor) || Activation.ActorsToIgnore.Contains(Candidate.Actor))
+		{
+			continue;
+		}
+
+		//Cheap bounds rejection before running the shape test against the candidate's body.
+		if (!TrapBounds.Intersect(Candidate.Bounds))
+		{
+			continue;
+		}
+
+		if (!Candidate.Component->OverlapComponent(TrapTransform.GetLocation(), TrapTransform.GetRotation(), TrapShape))
+		{
+			continue;
+		}
+
+		ActivationHitActorSet.Add(Candidate.Actor);
+		HitActorList.Add(Candidate.Actor);
+	}
+
+	Activation.HitCount = HitActorList.Num() - Activation.HitStartIndex;
+}
+
+void UTrapManager::ApplyPendingDamage()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrapManagerApplyDamage);
+	CSV_SCOPED_TIMING_STAT(Nausea, TrapManagerApplyDamage);
+
+	DamageEntryList.Reset();
+	DamageEntryIndexMap.Reset();
+
+	//Targets hit by several traps of the same owner and damage type receive a single damage event carrying the summed damage.
+	for (const FTrapActivation& Activation : ResolvingActivationList)
+	{
+		if (!Activation.DamageType || Activation.HitCount == 0)
+		{
+			continue;
+		}
+
+		ATrapBase* Trap = Activation.Trap.Get();
+
+		for (int32 Index = Activation.HitStartIndex; Index < Activation.HitStartIndex + Activation.HitCount; Index++)
+		{
+			AActor* Target = HitActorList[Index];
+			const TTuple<AActor*, UClass*, AActor*> Key(Target, *Activation.DamageType, Trap->GetOwner());
+
+			if (const int32* EntryIndex = DamageEntryIndexMap.Find(Key))
+			{
+				DamageEntryList[*EntryIndex].Damage += Activation.Damage;
+				continue;
+			}
+
+			const int32 EntryIndex = DamageEntryList.Emplace(Target, Activation.DamageType, Trap);
+			DamageEntryList[EntryIndex].Damage = Activation.Damage;
+			DamageEntryIndexMap.Add(Key, EntryIndex);
+		}
+	}
+
+	for (const FTrapDamageEntry& DamageEntry : DamageEntryList)
+	{
+		if (!IsValid(DamageEntry.Target) || !IsValid(DamageEntry.DamageCauser) || DamageEntry.Damage <= 0.f)
+		{
+			continue;
+		}
+
+		DamageEntry.Target->TakeDamage(DamageEntry.Damage, FDamageEvent(DamageEntry.DamageType), DamageEntry.DamageCauser->GetInstigatorController(), DamageEntry.DamageCauser);
+	}
+
+	DamageEntryList.Reset();
+}
@@ -164,48 +164,19 @@ void UPlayerClassSimplePassiveSkill::InitializeSkill_Implementation(UPlayerClass
 	switch (PassiveSkill)
 	{
 	case ESimplePassiveSkill::EquipRate:
-		PlayerClass->OnProcessEquipTime.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessWeaponEvent);
-		PlayerClass->OnProcessPutDownTime.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessWeaponEvent);
-		bPowerAsReduction = true;
-		return;
 	case ESimplePassiveSkill::FireRate:
-		PlayerClass->OnProcessFireRate.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessFireModeEvent);
-		bPowerAsReduction = true;
-		return;
 	case ESimplePassiveSkill::Recoil:
-		PlayerClass->OnProcessRecoil.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessRecoilEvent);
-		bPowerAsReduction = true;
-		return;
-	case ESimplePassiveSkill::AmmoCapacity:
-		PlayerClass->OnProcessAmmoCapacity.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessAmmoEvent);
-		bPowerAsReduction = false;
-		return;
-	case ESimplePassiveSkill::LoadedAmmoCapacity:
-		PlayerClass->OnProcessLoadedAmmoCapacity.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessLoadedAmmoEvent);
-		bPowerAsReduction = false;
-		return;
 	case ESimplePassiveSkill::ReloadRate:
-		PlayerClass->OnProcessReloadRate.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessLoadedAmmoEvent);
-		bPowerAsReduction = true;
-		return;
-	case ESimplePassiveSkill::MovementSpeed:
-		PlayerClass->OnProcessMovementSpeed.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessCharacterEvent);
-		return;
 	case ESimplePassiveSkill::DamageTaken:
-		PlayerClass->OnProcessDamageTaken.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessDamageValueEvent);
 		bPowerAsReduction = true;
-		return;
-	case ESimplePassiveSkill::DamageDealt:
-		PlayerClass->OnProcessDamageDealt.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessDamageValueEvent);
+		break;
+	default:
 		bPowerAsReduction = false;
-		return;
-	case ESimplePassiveSkill::MaxHealth:
-		PlayerClass->OnProcessOwnedActorMaxHealth.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessStatValueEvent);
-		return;
-	case ESimplePassiveSkill::MaxArmour:
-		PlayerClass->OnProcessOwnedActorMaxArmour.AddUObject(this, &UPlayerClassSimplePassiveSkill::ProcessStatValueEvent);
-		return;
+		break;
 	}
+
+	//Simple passive skills are flattened into the player class' modifier table instead of binding to its hooks.
+	PlayerClass->RegisterSimplePassiveSkill(this);
 }
 
 FText UPlayerClassSimplePassiveSkill::GetSkillDescription_Implementation() const
@@ -232,98 +203,49 @@ FText UPlayerClassSimplePassiveSkill::GetSkillPowerForSkillDescription() const
 	return FText::AsPercent(GetSkillPower());
 }
 
-void UPlayerClassSimplePassiveSkill::ApplySkillToValue(float& Value) const
-{
-	if (bPowerAsReduction)
-	{
-		Value *= FMath::Max(1.f - GetSkillPower(), 0.f);
-	}
-	else
-	{
-		Value *= 1.f + GetSkillPower();
-	}
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessWeaponEvent(const UWeapon* Weapon, float& Value)
-{
-	if (!IsRelevantWeapon(Weapon))
-	{
-		return;
-	}
-
-	ApplySkillToValue(Value);
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessFireModeEvent(const UWeapon* Weapon, const UFireMode* FireMode, float& Value)
-{
-	if (!IsRelevantFireMode(FireMode))
-	{
-		return;
-	}
-
-	ApplySkillToValue(Value);
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessRecoilEvent(const UWeapon* Weapon, const UFireMode* FireMode, float& RecoilX, float& RecoilY, float& Rate)
-{
-	if (!IsRelevantFireMode(FireMode))
-	{
-		return;
-	}
-
-	ApplySkillToValue(RecoilX);
-	ApplySkillToValue(RecoilY);
-	ApplySkillToValue(Rate);
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessAmmoEvent(const UWeapon* Weapon, const UAmmo* Ammo, float& Value)
+bool UPlayerClassSimplePassiveSkill::IsRelevantObject(const UObject* RelevanceObject) const
 {
-	if (!IsRelevantAmmo(Ammo))
+	switch (PassiveSkill)
 	{
-		return;
+	case ESimplePassiveSkill::EquipRate:
+		return IsRelevantWeapon(Cast<UWeapon>(RelevanceObject));
+	case ESimplePassiveSkill::FireRate:
+	case ESimplePassiveSkill::Recoil:
+		return IsRelevantFireMode(Cast<UFireMode>(RelevanceObject));
+	case ESimplePassiveSkill::ReloadRate:
+	case ESimplePassiveSkill::AmmoCapacity:
+	case ESimplePassiveSkill::LoadedAmmoCapacity:
+		return IsRelevantAmmo(Cast<UAmmo>(RelevanceObject));
+	case ESimplePassiveSkill::DamageTaken:
+	case ESimplePassiveSkill::DamageDealt:
+		return IsRelevantDamageType(Cast<UCoreDamageType>(RelevanceObject));
 	}
 
-	ApplySkillToValue(Value);
+	return true;
 }
 
-void UPlayerClassSimplePassiveSkill::ProcessLoadedAmmoEvent(const UWeapon* Weapon, const ULoadedAmmo* LoadedAmmo, float& Value)
+float UPlayerClassSimplePassiveSkill::GetSkillMultiplier() const
 {
-	if (!IsRelevantAmmo(LoadedAmmo))
+	if (bPowerAsReduction)
 	{
-		return;
+		return FMath::Max(1.f - GetSkillPower(), 0.f);
 	}
-
-	ApplySkillToValue(Value);
+	
+	return 1.f + GetSkillPower();
 }
 
-void UPlayerClassSimplePassiveSkill::ProcessDamageValueEvent(UStatusComponent* Target, float& Value, const struct FDamageEvent& DamageEvent, ACorePlayerState* Instigator)
+void UPlayerClassSimplePassiveSkill::PushDamageLogModifier(UStatusComponent* Target, float Multiplier) const
 {
-	if (!IsRelevantDamageType(Cast<UCoreDamageType>(DamageEvent.DamageTypeClass.GetDefaultObject())))
+	if (!Target)
 	{
 		return;
 	}
 
-	const float InitialValue = Value;
-	ApplySkillToValue(Value);
+	ensure(PlayerSkillVariant != EPlayerClassVariant::Invalid);
 
-	if (InitialValue == Value || !Target || !Target->ShouldPerformDamageLog())
-	{
-		return;
-	}
-
-	TArray<UPlayerClassSkill*> CDOSkillList;
-	switch (PlayerSkillVariant)
-	{
-	case EPlayerClassVariant::Invalid:
-		ensure(false);
-		break;
-	case EPlayerClassVariant::Special:
-		CDOSkillList = UPlayerClassComponent::GetCoreSkillListOfClass(GetPlayerClassComponent()->GetClass());
-		break;
-	default:
-		CDOSkillList = UPlayerClassComponent::GetVariantSkillListOfClass(GetPlayerClassComponent()->GetClass(), PlayerSkillVariant);
-		break;
-	}
+	const TArray<UPlayerClassSkill*>& CDOSkillList = PlayerSkillVariant == EPlayerClassVariant::Special
+		? UPlayerClassComponent::GetCoreSkillListOfClass(GetPlayerClassComponent()->GetClass())
+		: UPlayerClassComponent::GetVariantSkillListOfClass(GetPlayerClassComponent()->GetClass(), PlayerSkillVariant);
 
 	if (!ensure(CDOSkillList.IsValidIndex(PlayerSkillIndex)))
 	{
@@ -332,17 +254,7 @@ void UPlayerClassSimplePassiveSkill::ProcessDamageValueEvent(UStatusComponent* T
 
 	ensure(CDOSkillList[PlayerSkillIndex]->GetSkillName().IdenticalTo(GetSkillName()));
 
-	Target->PushDamageLogModifier(FDamageLogEventModifier(CDOSkillList[PlayerSkillIndex], GetPlayerClassComponent()->GetOwningPlayerState(), Value / InitialValue));
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessStatValueEvent(AActor* TargetActor, float& Value)
-{
-	ApplySkillToValue(Value);
-}
-
-void UPlayerClassSimplePassiveSkill::ProcessCharacterEvent(const ACoreCharacter* Character, float& Value)
-{
-	ApplySkillToValue(Value);
+	Target->PushDamageLogModifier(FDamageLogEventModifier(CDOSkillList[PlayerSkillIndex], GetPlayerClassComponent()->GetOwningPlayerState(), Multiplier));
 }
 
 FText UPlayerClassSimplePassiveSkill::GetNameOfSimplePassiveSkill(ESimplePassiveSkill SimplePassiveSkill)
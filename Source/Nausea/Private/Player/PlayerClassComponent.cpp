@@ -4,6 +4,8 @@
 #include "Player/PlayerClassComponent.h"
 #include "Internationalization/StringTableRegistry.h"
 #include "Engine/ActorChannel.h"
+#include "UObject/GCObject.h"
+#include "Materials/MaterialInterface.h"
 #include "NauseaNetDefines.h"
 #include "Player/CorePlayerController.h"
 #include "Player/CorePlayerState.h"
@@ -11,6 +13,8 @@
 #include "Weapon/InventoryManagerComponent.h"
 #include "Player/PlayerClass/PlayerClassSkill.h"
 #include "Weapon/FireMode.h"
+#include "Gameplay/StatusComponent.h"
+#include "Gameplay/CoreDamageType.h"
 #include "Player/PlayerClass/PlayerClassExperienceSource.h"
 
 UPlayerClassComponent::UPlayerClassComponent(const FObjectInitializer& ObjectInitializer)
@@ -307,8 +311,87 @@ void UPlayerClassComponent::ProcessInitialInventoryList(TArray<TSubclassOf<UInve
 	}
 }
 
+void UPlayerClassComponent::RegisterSimplePassiveSkill(UPlayerClassSimplePassiveSkill* Skill)
+{
+	if (!Skill || Skill->GetPassiveSkill() == ESimplePassiveSkill::Invalid)
+	{
+		return;
+	}
+
+	SimplePassiveSkillMap.FindOrAdd(Skill->GetPassiveSkill()).AddUnique(Skill);
+	MarkPassiveSkillModifiersDirty();
+}
+
+void UPlayerClassComponent::MarkPassiveSkillModifiersDirty()
+{
+	PassiveSkillModifierMap.Reset();
+}
+
+float UPlayerClassComponent::GetPassiveSkillMultiplier(ESimplePassiveSkill SkillType, const UObject* RelevanceObject) const
+{
+	return GetPassiveSkillModifier(SkillType, RelevanceObject).Multiplier;
+}
+
+void UPlayerClassComponent::ApplyPassiveSkillDamageModifiers(ESimplePassiveSkill SkillType, UStatusComponent* Target, float& Value, const FDamageEvent& DamageEvent) const
+{
+	const FPassiveSkillModifier& Modifier = GetPassiveSkillModifier(SkillType, DamageEvent.DamageTypeClass ? DamageEvent.DamageTypeClass.GetDefaultObject() : nullptr);
+
+	if (Modifier.Multiplier == 1.f)
+	{
+		return;
+	}
+
+	Value *= Modifier.Multiplier;
+
+	if (!Target || !Target->ShouldPerformDamageLog())
+	{
+		return;
+	}
+
+	for (const TPair<const UPlayerClassSimplePassiveSkill*, float>& Contributor : Modifier.ContributorList)
+	{
+		Contributor.Key->PushDamageLogModifier(Target, Contributor.Value);
+	}
+}
+
+const FPassiveSkillModifier& UPlayerClassComponent::GetPassiveSkillModifier(ESimplePassiveSkill SkillType, const UObject* RelevanceObject) const
+{
+	const TPair<ESimplePassiveSkill, TObjectKey<UObject>> Key(SkillType, RelevanceObject);
+
+	if (const FPassiveSkillModifier* Modifier = PassiveSkillModifierMap.Find(Key))
+	{
+		return *Modifier;
+	}
+
+	FPassiveSkillModifier& Modifier = PassiveSkillModifierMap.Add(Key);
+
+	if (const TArray<UPlayerClassSimplePassiveSkill*>* SkillList = SimplePassiveSkillMap.Find(SkillType))
+	{
+		for (const UPlayerClassSimplePassiveSkill* Skill : *SkillList)
+		{
+			if (!Skill || !Skill->IsRelevantObject(RelevanceObject))
+			{
+				continue;
+			}
+
+			const float SkillMultiplier = Skill->GetSkillMultiplier();
+
+			if (SkillMultiplier == 1.f)
+			{
+				continue;
+			}
+
+			Modifier.Multiplier *= SkillMultiplier;
+			Modifier.ContributorList.Emplace(Skill, SkillMultiplier);
+		}
+	}
+
+	return Modifier;
+}
+
 void UPlayerClassComponent::OnRep_Level()
 {
+	MarkPassiveSkillModifiersDirty();
 	CheckRemoteReady();
 	OnLevelChanged.Broadcast(this, Level);
 }
@@ -320,6 +403,7 @@ void UPlayerClassComponent::OnRep_ExperiencePercent()
 
 void UPlayerClassComponent::OnRep_Variant()
 {
+	MarkPassiveSkillModifiersDirty();
 	CheckRemoteReady();
 }
 
@@ -409,47 +493,219 @@ inline const UPlayerClassComponent* GetPlayerClassCDO(TSubclassOf<UPlayerClassCo
 	return nullptr;
 }
 
-TArray<UPlayerClassSkill*> UPlayerClassComponent::GetCoreSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass)
+//Owns every player class record and reports the objects records point at to the garbage collector.
+//Records are heap allocated and never freed while running, so views handed out stay valid. A record replaced because its class was edited or reinstanced is retired instead
+//and the record generation is bumped so that anything holding on to record data can tell it is out of date.
+class FPlayerClassRecordCache : public FGCObject
 {
-	if(const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+public:
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		for (TPair<TObjectKey<UClass>, TUniquePtr<FPlayerClassRecord>>& Entry : RecordMap)
+		{
+			AddRecordReferences(Collector, *Entry.Value);
+		}
+
+		for (TUniquePtr<FPlayerClassRecord>& Record : RetiredRecordList)
+		{
+			AddRecordReferences(Collector, *Record);
+		}
+	}
+
+	virtual FString GetReferencerName() const override { return TEXT("FPlayerClassRecordCache"); }
+
+	void RetireRecord(const UClass* PlayerClass)
+	{
+		TUniquePtr<FPlayerClassRecord>* Record = RecordMap.Find(PlayerClass);
+
+		if (!Record)
+		{
+			return;
+		}
+
+		if (Record->IsValid())
+		{
+			RetiredRecordList.Add(MoveTemp(*Record));
+			Generation++;
+		}
+
+		RecordMap.Remove(PlayerClass);
+	}
+
+protected:
+	static void AddRecordReferences(FReferenceCollector& Collector, FPlayerClassRecord& Record)
 	{
-		return PlayerClassCDO->GetCoreSkillList();
+		for (FPlayerClassVariantRecord* VariantRecord : { &Record.CoreRecord, &Record.PrimaryRecord, &Record.AlternativeRecord })
+		{
+			Collector.AddReferencedObjects(VariantRecord->VariantSkillList);
+			Collector.AddReferencedObjects(VariantRecord->ActiveSkillList);
+			Collector.AddReferencedObject(VariantRecord->BackplateMaterial);
+			Collector.AddReferencedObject(VariantRecord->HexagonBackplateMaterial);
+		}
 	}
 
-	return TArray<UPlayerClassSkill*>();
+public:
+	TMap<TObjectKey<UClass>, TUniquePtr<FPlayerClassRecord>> RecordMap;
+	TArray<TUniquePtr<FPlayerClassRecord>> RetiredRecordList;
+	uint32 Generation = 0;
+};
+
+//Created on first use rather than during static initialization, since registering a referencer requires UObject to be initialized.
+static FPlayerClassRecordCache& GetPlayerClassRecordCache()
+{
+	static FPlayerClassRecordCache PlayerClassRecordCache;
+	return PlayerClassRecordCache;
 }
 
-TArray<UPlayerClassSkill*> UPlayerClassComponent::GetVariantSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
+static const TArray<UPlayerClassSkill*> EmptySkillList;
+static const TArray<TSoftClassPtr<UInventory>> EmptyInventoryList;
+
+#if WITH_EDITOR
+void UPlayerClassComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
 	{
-		switch (PlayerClassVariant)
+		GetPlayerClassRecordCache().RetireRecord(GetClass());
+	}
+}
+#endif //WITH_EDITOR
+
+void UPlayerClassComponent::BuildPlayerClassRecord(FPlayerClassRecord& Record) const
+{
+	Record.PlayerClassCDO = this;
+	Record.Generation = GetPlayerClassRecordCache().Generation;
+
+	Record.Title = PlayerClassTitle;
+	Record.Description = PlayerClassDescription;
+	Record.Icon = PlayerClassIcon;
+	Record.IconLarge = PlayerClassIconLarge;
+	Record.CoreColour = PlayerClassCoreColour;
+
+	Record.CoreRecord.VariantSkillList = CoreSkillList;
+	Record.CoreRecord.ActiveSkillList = CoreSkillList;
+	Record.CoreRecord.DefaultInventoryList = CoreDefaultInventory;
+
+	auto BuildVariantRecord = [this](FPlayerClassVariantRecord& VariantRecord, const TArray<UPlayerClassSkill*>& VariantSkillList, const TArray<TSoftClassPtr<UInventory>>& VariantInventoryList)
+	{
+		VariantRecord.VariantSkillList = VariantSkillList;
+
+		VariantRecord.ActiveSkillList = CoreSkillList;
+		VariantRecord.ActiveSkillList.Append(VariantSkillList);
+
+		VariantRecord.DefaultInventoryList = CoreDefaultInventory;
+		VariantRecord.DefaultInventoryList.Append(VariantInventoryList);
+	};
+
+	BuildVariantRecord(Record.PrimaryRecord, PrimarySkillList, PrimaryDefaultInventory);
+	Record.PrimaryRecord.Colour = PlayerClassColourPrimaryVariant;
+	Record.PrimaryRecord.BackplateMaterial = PlayerClassPrimaryBackplate;
+	Record.PrimaryRecord.HexagonBackplateMaterial = PlayerClassPrimaryHexagonBackplate;
+
+	BuildVariantRecord(Record.AlternativeRecord, AlternativeSkillList, AlternateDefaultInventory);
+	Record.AlternativeRecord.Colour = PlayerClassColourAlternativeVariant;
+	Record.AlternativeRecord.BackplateMaterial = PlayerClassAlternativeBackplate;
+	Record.AlternativeRecord.HexagonBackplateMaterial = PlayerClassAlternativeHexagonBackplate;
+
+	Record.MaxLevel = GetMaxLevel();
+	Record.bHasExperienceCurve = GetExperienceCurve() != nullptr;
+	Record.ExperienceCurveValueList.Reset();
+
+	if (Record.bHasExperienceCurve)
+	{
+		Record.ExperienceCurveValueList.Reserve(Record.MaxLevel + 2);
+		for (int32 LevelIndex = 0; LevelIndex <= Record.MaxLevel + 1; LevelIndex++)
 		{
-		case EPlayerClassVariant::Primary:
-			return PlayerClassCDO->GetPrimaryVariantSkillList();
-		case EPlayerClassVariant::Alternative:
-			return PlayerClassCDO->GetAlternativeVariantSkillList();
+			Record.ExperienceCurveValueList.Add(GetExperienceCurve()->GetFloatValue(LevelIndex));
 		}
 	}
+}
+
+const FPlayerClassRecord* UPlayerClassComponent::GetPlayerClassRecord(TSubclassOf<UPlayerClassComponent> PlayerClass)
+{
+	if (!PlayerClass)
+	{
+		return nullptr;
+	}
+
+	FPlayerClassRecordCache& RecordCache = GetPlayerClassRecordCache();
+	const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass);
+
+	if (const TUniquePtr<FPlayerClassRecord>* CachedRecord = RecordCache.RecordMap.Find(PlayerClass.Get()))
+	{
+		if (CachedRecord->IsValid() && (*CachedRecord)->PlayerClassCDO.Get() == PlayerClassCDO)
+		{
+			return CachedRecord->Get();
+		}
+
+		//The class default object was replaced since this record was built.
+		RecordCache.RetireRecord(PlayerClass.Get());
+	}
+
+	if (!PlayerClassCDO)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FPlayerClassRecord>& Record = RecordCache.RecordMap.Add(PlayerClass.Get(), MakeUnique<FPlayerClassRecord>());
+	PlayerClassCDO->BuildPlayerClassRecord(*Record);
+	return Record.Get();
+}
+
+uint32 UPlayerClassComponent::GetPlayerClassRecordGeneration()
+{
+	return GetPlayerClassRecordCache().Generation;
+}
+
+void UPlayerClassComponent::BuildPlayerClassRecords(const TArray<TSubclassOf<UPlayerClassComponent>>& PlayerClassList)
+{
+	for (TSubclassOf<UPlayerClassComponent> PlayerClass : PlayerClassList)
+	{
+		GetPlayerClassRecord(PlayerClass);
+	}
+}
+
+const TArray<UPlayerClassSkill*>& UPlayerClassComponent::GetCoreSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass)
+{
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
+	{
+		return Record->CoreRecord.ActiveSkillList;
+	}
+
+	return EmptySkillList;
+}
+
+const TArray<UPlayerClassSkill*>& UPlayerClassComponent::GetVariantSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
+{
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
+
+	if (const FPlayerClassVariantRecord* VariantRecord = Record ? Record->GetVariantRecord(PlayerClassVariant) : nullptr)
+	{
+		return VariantRecord->VariantSkillList;
+	}
 
-	return TArray<UPlayerClassSkill*>();
+	return EmptySkillList;
 }
 
-TArray<UPlayerClassSkill*> UPlayerClassComponent::GetActiveSkillListListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
+const TArray<UPlayerClassSkill*>& UPlayerClassComponent::GetActiveSkillListListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
+
+	if (!Record)
 	{
-		return PlayerClassCDO->GetAlternativeVariantSkillList();
+		return EmptySkillList;
 	}
 
-	return TArray<UPlayerClassSkill*>();
+	const FPlayerClassVariantRecord* VariantRecord = Record->GetVariantRecord(PlayerClassVariant);
+	return VariantRecord ? VariantRecord->ActiveSkillList : Record->CoreRecord.ActiveSkillList;
 }
 
 FText UPlayerClassComponent::GetPlayerClassTitle(TSubclassOf<UPlayerClassComponent> PlayerClass)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
 	{
-		return PlayerClassCDO->GetTitle();
+		return Record->Title;
 	}
 
 	return FText::FromString("");
@@ -473,9 +729,9 @@ FText UPlayerClassComponent::GetVariantName(EPlayerClassVariant PlayerClassVaria
 
 FText UPlayerClassComponent::GetPlayerClassDescription(TSubclassOf<UPlayerClassComponent> PlayerClass)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
 	{
-		return PlayerClassCDO->GetDescription();
+		return Record->Description;
 	}
 
 	return FText::FromString("");
@@ -483,9 +739,9 @@ FText UPlayerClassComponent::GetPlayerClassDescription(TSubclassOf<UPlayerClassC
 
 TSoftObjectPtr<UTexture2D> UPlayerClassComponent::GetPlayerClassIcon(TSubclassOf<UPlayerClassComponent> PlayerClass)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
 	{
-		return PlayerClassCDO->PlayerClassIcon;
+		return Record->Icon;
 	}
 
 	return nullptr;
@@ -493,9 +749,9 @@ TSoftObjectPtr<UTexture2D> UPlayerClassComponent::GetPlayerClassIcon(TSubclassOf
 
 TSoftObjectPtr<UTexture2D> UPlayerClassComponent::GetPlayerClassIconLarge(TSubclassOf<UPlayerClassComponent> PlayerClass)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
 	{
-		return PlayerClassCDO->PlayerClassIconLarge;
+		return Record->IconLarge;
 	}
 
 	return nullptr;
@@ -503,9 +759,9 @@ TSoftObjectPtr<UTexture2D> UPlayerClassComponent::GetPlayerClassIconLarge(TSubcl
 
 const FLinearColor& UPlayerClassComponent::GetPlayerClassCoreColour(TSubclassOf<UPlayerClassComponent> PlayerClass)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	if (const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass))
 	{
-		return PlayerClassCDO->PlayerClassCoreColour;
+		return Record->CoreColour;
 	}
 
 	return FLinearColor::Black;
@@ -513,15 +769,11 @@ const FLinearColor& UPlayerClassComponent::GetPlayerClassCoreColour(TSubclassOf<
 
 const FLinearColor& UPlayerClassComponent::GetPlayerClassVariantColour(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
+
+	if (const FPlayerClassVariantRecord* VariantRecord = Record ? Record->GetVariantRecord(PlayerClassVariant) : nullptr)
 	{
-		switch (PlayerClassVariant)
-		{
-		case EPlayerClassVariant::Primary:
-			return PlayerClassCDO->PlayerClassColourPrimaryVariant;
-		case EPlayerClassVariant::Alternative:
-			return PlayerClassCDO->PlayerClassColourAlternativeVariant;
-		}
+		return VariantRecord->Colour;
 	}
 
 	return FLinearColor::Black;
@@ -529,24 +781,11 @@ const FLinearColor& UPlayerClassComponent::GetPlayerClassVariantColour(TSubclass
 
 UMaterialInterface* UPlayerClassComponent::GetPlayerClassBackplateMaterial(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	if (!PlayerClass)
-	{
-		return nullptr;
-	}
-
-	const UPlayerClassComponent* PlayerClassCDO = PlayerClass.GetDefaultObject();
-
-	if (!PlayerClassCDO)
-	{
-		return nullptr;
-	}
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
 
-	switch (PlayerClassVariant)
+	if (const FPlayerClassVariantRecord* VariantRecord = Record ? Record->GetVariantRecord(PlayerClassVariant) : nullptr)
 	{
-	case EPlayerClassVariant::Primary:
-		return PlayerClassCDO->PlayerClassPrimaryBackplate;
-	case EPlayerClassVariant::Alternative:
-		return PlayerClassCDO->PlayerClassAlternativeBackplate;
+		return VariantRecord->BackplateMaterial;
 	}
 
 	return nullptr;
@@ -554,81 +793,56 @@ UMaterialInterface* UPlayerClassComponent::GetPlayerClassBackplateMaterial(TSubc
 
 UMaterialInterface* UPlayerClassComponent::GetPlayerClassHexagonBackplateMaterial(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	if (!PlayerClass)
-	{
-		return nullptr;
-	}
-
-	const UPlayerClassComponent* PlayerClassCDO = PlayerClass.GetDefaultObject();
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
 
-	if (!PlayerClassCDO)
+	if (const FPlayerClassVariantRecord* VariantRecord = Record ? Record->GetVariantRecord(PlayerClassVariant) : nullptr)
 	{
-		return nullptr;
-	}
-
-	switch (PlayerClassVariant)
-	{
-	case EPlayerClassVariant::Primary:
-		return PlayerClassCDO->PlayerClassPrimaryHexagonBackplate;
-	case EPlayerClassVariant::Alternative:
-		return PlayerClassCDO->PlayerClassAlternativeHexagonBackplate;
+		return VariantRecord->HexagonBackplateMaterial;
 	}
 
 	return nullptr;
 }
 
-TArray<TSoftClassPtr<UInventory>> UPlayerClassComponent::GetDefaultInventoryListFromClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
+const TArray<TSoftClassPtr<UInventory>>& UPlayerClassComponent::GetDefaultInventoryListFromClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	TArray<TSoftClassPtr<UInventory>> DefaultInventoryList;
-	if (const UPlayerClassComponent* PlayerClassCDO = GetPlayerClassCDO(PlayerClass))
-	{
-		DefaultInventoryList = PlayerClassCDO->CoreDefaultInventory;
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
 
-		switch (PlayerClassVariant)
-		{
-		case EPlayerClassVariant::Primary:
-			DefaultInventoryList.Append(PlayerClassCDO->PrimaryDefaultInventory);
-			break;
-		case EPlayerClassVariant::Alternative:
-			DefaultInventoryList.Append(PlayerClassCDO->AlternateDefaultInventory);
-			break;
-		}
+	if (!Record)
+	{
+		return EmptyInventoryList;
 	}
 
-	return DefaultInventoryList;
+	const FPlayerClassVariantRecord* VariantRecord = Record->GetVariantRecord(PlayerClassVariant);
+	return VariantRecord ? VariantRecord->DefaultInventoryList : Record->CoreRecord.DefaultInventoryList;
 }
 
 int32 UPlayerClassComponent::GetPlayerClassLevel(TScriptInterface<IPlayerOwnershipInterface> PlayerOwnedInterface, TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant)
 {
-	const UPlayerClassComponent* PlayerClassCDO = PlayerClass.GetDefaultObject();
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
 
-	if (!PlayerClassCDO || !PlayerClassCDO->GetExperienceCurve())
+	if (!Record || !Record->bHasExperienceCurve)
 	{
 		return 0;
 	}
 
 	const uint64 PlayerClassExperience = UPlayerStatisticHelpers::GetPlayerClassExperience(PlayerOwnedInterface, PlayerClass, PlayerClassVariant);
-	uint64 RequiredExpirence = 0;
-	int32 PlayerClassLevel = 0;
 
-	while (PlayerClassLevel <= PlayerClassCDO->GetMaxLevel())
+	for (int32 PlayerClassLevel = 1; PlayerClassLevel <= Record->MaxLevel + 1; PlayerClassLevel++)
 	{
-		PlayerClassLevel++;
-
-		if (uint64(PlayerClassCDO->GetExperienceCurve()->GetFloatValue(PlayerClassLevel)) > PlayerClassExperience)
+		if (uint64(Record->ExperienceCurveValueList[PlayerClassLevel]) > PlayerClassExperience)
 		{
 			return PlayerClassLevel - 1;
 		}
 	}
 
-	return PlayerClassCDO->GetMaxLevel();
+	return Record->MaxLevel;
 }
 
 void UPlayerClassComponent::GetPlayerClassLevelInfo(TScriptInterface<IPlayerOwnershipInterface> PlayerOwnedInterface, TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant, int32& PlayerClassLevel, int64& ExperienceProgress, int64& ExperienceRequirement, float& PercentProgress)
 {
-	const UPlayerClassComponent* PlayerClassCDO = PlayerClass.GetDefaultObject();
+	const FPlayerClassRecord* Record = GetPlayerClassRecord(PlayerClass);
 
-	if (!PlayerClassCDO || !PlayerClassCDO->GetExperienceCurve())
+	if (!Record || !Record->bHasExperienceCurve)
 	{
 		PlayerClassLevel = 0;
 		ExperienceProgress = 0;
@@ -639,13 +853,11 @@ void UPlayerClassComponent::GetPlayerClassLevelInfo(TScriptInterface<IPlayerOwne
 
 	const int64 PlayerClassExperience = int64(FMath::Min(UPlayerStatisticHelpers::GetPlayerClassExperience(PlayerOwnedInterface, PlayerClass, PlayerClassVariant), MAX_uint64 / 2));
 
-	PlayerClassLevel = PlayerClassCDO->GetMaxLevel();
+	PlayerClassLevel = Record->MaxLevel;
 
-	int32 CheckLevel = 0;
-	while (CheckLevel <= PlayerClassCDO->GetMaxLevel())
+	for (int32 CheckLevel = 1; CheckLevel <= Record->MaxLevel + 1; CheckLevel++)
 	{
-		CheckLevel++;
-		ExperienceRequirement = int64(PlayerClassCDO->GetExperienceCurve()->GetFloatValue(CheckLevel));
+		ExperienceRequirement = int64(Record->ExperienceCurveValueList[CheckLevel]);
 
 		if (ExperienceRequirement > PlayerClassExperience)
 		{
@@ -654,7 +866,7 @@ void UPlayerClassComponent::GetPlayerClassLevelInfo(TScriptInterface<IPlayerOwne
 		}
 	}
 
-	const uint64 PreviousExperienceRequirement = PlayerClassCDO->GetExperienceCurve()->GetFloatValue(PlayerClassLevel);
+	const uint64 PreviousExperienceRequirement = Record->ExperienceCurveValueList[PlayerClassLevel];
 
 	ExperienceProgress = PlayerClassExperience - PreviousExperienceRequirement;
 	PercentProgress = float(ExperienceProgress) / float(ExperienceRequirement - PreviousExperienceRequirement);
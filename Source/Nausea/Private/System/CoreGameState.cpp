@@ -8,6 +8,11 @@
 #include "NauseaNetDefines.h"
 #include "System/CoreGameMode.h"
 #include "System/SpawnCharacterSystem.h"
+#include "System/WaveContentPreloader.h"
+#include "System/CustomizationStreamingManager.h"
+#include "Character/CorpseManager.h"
+#include "Gameplay/Ability/AbilityContentManager.h"
+#include "Character/CoreCustomizationComponent.h"
 #include "Player/CorePlayerState.h"
 #include "Player/PlayerClassComponent.h"
 #include "Gameplay/StatusInterface.h"
@@ -19,6 +24,9 @@ ACoreGameState::ACoreGameState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	SpawnCharacterSystem = CreateDefaultSubobject<USpawnCharacterSystem>(TEXT("SpawnCharacterSystem"));
+	WaveContentPreloader = CreateDefaultSubobject<UWaveContentPreloader>(TEXT("WaveContentPreloader"));
+	CorpseManager = CreateDefaultSubobject<UCorpseManager>(TEXT("CorpseManager"));
+	AbilityContentManager = CreateDefaultSubobject<UAbilityContentManager>(TEXT("AbilityContentManager"));
 }
 
 void ACoreGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -60,6 +68,8 @@ void ACoreGameState::AddPlayerState(APlayerState* PlayerState)
 void ACoreGameState::RemovePlayerState(APlayerState* PlayerState)
 {
 	Super::RemovePlayerState(PlayerState);
+
+	UCustomizationStreamingManager::ReleaseAllRequests(this, PlayerState);
 	
 	ACorePlayerState* CorePlayerState = Cast<ACorePlayerState>(PlayerState);
 
@@ -80,6 +90,16 @@ void ACoreGameState::OnRep_MatchState()
 	OnMatchStateChanged.Broadcast(this, GetMatchState());
 }
 
+void ACoreGameState::HandleMatchIsWaitingToStart()
+{
+	Super::HandleMatchIsWaitingToStart();
+
+	for (APlayerState* PlayerState : PlayerArray)
+	{
+		PreloadPlayerCustomization(Cast<ACorePlayerState>(PlayerState));
+	}
+}
+
 void ACoreGameState::InitializeGameState(ACoreGameMode* CoreGameMode)
 {
 	GameDifficulty = UGameplayStatics::GetIntOption(CoreGameMode->OptionsString, ACoreGameMode::OptionDifficulty, CoreGameMode->GetDefaultGameDifficulty());
@@ -94,6 +114,11 @@ void ACoreGameState::OnPlayerStateReady(ACorePlayerState* PlayerState)
 
 	OnPlayerStateAdded.Broadcast(PlayerState->IsActivePlayer(), PlayerState);
 
+	if (IsWaitingToStart())
+	{
+		PreloadPlayerCustomization(PlayerState);
+	}
+
 	if (!PlayerState->IsActivePlayer())
 	{
 		UnbindToRelevantPlayerState(PlayerState);
@@ -119,6 +144,29 @@ bool ACoreGameState::IsWaitingPostMatch() const
 	return GetMatchState() == MatchState::WaitingPostMatch;
 }
 
+void ACoreGameState::PreloadPlayerCustomization(ACorePlayerState* PlayerState)
+{
+	if (!PlayerState || PlayerState->IsOnlyASpectator() || IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	const AGameModeBase* DefaultGameMode = GetDefaultGameMode();
+
+	if (!DefaultGameMode)
+	{
+		return;
+	}
+
+	TArray<UCustomizationAsset*> CustomizationList;
+	if (!UCoreCustomizationComponent::GetDefaultCustomizationList(DefaultGameMode->DefaultPawnClass, CustomizationList))
+	{
+		return;
+	}
+
+	UCustomizationStreamingManager::PreloadCustomizationList(this, PlayerState, CustomizationList);
+}
+
 bool ACoreGameState::CanPlayerSelectPlayerClass(const ACorePlayerController* PlayerController, TSubclassOf<UPlayerClassComponent> PlayerClass) const
 {
 	if (!PlayerClass || !PlayerController)
@@ -267,7 +315,7 @@ void ACoreGameState::ApplyFriendlyFireEffectPowerMultiplier(AActor* Actor, float
 
 void ACoreGameState::OnRep_PlayerClassList()
 {
-
+	UPlayerClassComponent::BuildPlayerClassRecords(PlayerClassList);
 }
 
 void ACoreGameState::BindToRelevantPlayerState(ACorePlayerState* PlayerState)
@@ -4,6 +4,7 @@
 #include "System/CoreSingleton.h"
 #include "Engine/GameInstance.h"
 #include "GameFramework/WorldSettings.h"
+#include "GameFramework/Actor.h"
 
 UCoreSingleton::UCoreSingleton(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -11,6 +12,24 @@ UCoreSingleton::UCoreSingleton(const FObjectInitializer& ObjectInitializer)
 
 }
 
+void UCoreSingleton::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return;
+	}
+
+	for (const FTaggedActorSpatialGridSetting& Setting : TagSpatialGridSettingList)
+	{
+		if (Setting.Tag.IsValid())
+		{
+			TaggedActorRegistry.SetSpatialGridCellSize(Setting.Tag, Setting.CellSize);
+		}
+	}
+}
+
 void UCoreSingleton::Tick(float DeltaTime)
 {
 	if (GameInstance.IsValid() && GameInstance->GetWorld() && GameInstance->GetWorld()->GetWorldSettings())
@@ -67,9 +86,9 @@ void UCoreSingleton::RegisterActorWithTag(const UObject* WorldContextObject, AAc
 
 	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
 	{
-		for (const FGameplayTag& IndividualTag : Tag)
+		if (Singleton->TaggedActorRegistry.Register(Actor, Tag))
 		{
-			Singleton->ActorGameplayTagMap.FindOrAdd(IndividualTag).Add(Actor);
+			Actor->OnDestroyed.AddUniqueDynamic(Singleton, &UCoreSingleton::OnTaggedActorDestroyed);
 		}
 	}
 }
@@ -83,56 +102,369 @@ void UCoreSingleton::UnregisterActorWithTag(const UObject* WorldContextObject, A
 
 	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
 	{
-		TArray<FGameplayTag> RemovableTagEntryList;
+		if (Singleton->TaggedActorRegistry.Unregister(Actor, Tag))
+		{
+			Actor->OnDestroyed.RemoveDynamic(Singleton, &UCoreSingleton::OnTaggedActorDestroyed);
+		}
+	}
+}
+
+void UCoreSingleton::GetActorsWithTag(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag, bool bExactMatch)
+{
+	ActorList.Reset();
+	
+	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
+	{
+		Singleton->TaggedActorRegistry.GetActors(ActorList, Tag, bExactMatch);
+	}
+}
+
+void UCoreSingleton::GetActorsWithTagInRadius(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag, const FVector& Location, float Radius, bool bExactMatch)
+{
+	ActorList.Reset();
+
+	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
+	{
+		Singleton->TaggedActorRegistry.GetActorsInRadius(ActorList, Tag, Location, Radius, bExactMatch);
+	}
+}
+
+void UCoreSingleton::SetTagSpatialGridCellSize(const UObject* WorldContextObject, const FGameplayTag& Tag, float CellSize)
+{
+	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
+	{
+		Singleton->TaggedActorRegistry.SetSpatialGridCellSize(Tag, CellSize);
+	}
+}
+
+void UCoreSingleton::OnTaggedActorDestroyed(AActor* DestroyedActor)
+{
+	if (!DestroyedActor)
+	{
+		return;
+	}
+
+	TaggedActorRegistry.UnregisterAll(DestroyedActor);
+	DestroyedActor->OnDestroyed.RemoveDynamic(this, &UCoreSingleton::OnTaggedActorDestroyed);
+}
+
+int32* FTaggedActorEntry::FindSlot(const FGameplayTag& Tag)
+{
+	for (TPair<FGameplayTag, int32>& Slot : SlotList)
+	{
+		if (Slot.Key == Tag)
+		{
+			return &Slot.Value;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FTaggedActorRegistry::Register(AActor* Actor, const FGameplayTagContainer& TagContainer)
+{
+	const TObjectKey<AActor> ActorKey(Actor);
+	const bool bNewEntry = !ActorEntryMap.Contains(ActorKey);
+	FTaggedActorEntry& ActorEntry = ActorEntryMap.FindOrAdd(ActorKey);
+
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		if (ActorEntry.FindSlot(Tag))
+		{
+			continue;
+		}
+
+		FTaggedActorList* TaggedActorList = TaggedActorListMap.Find(Tag);
 
-		for (const FGameplayTag& IndividualTag : Tag)
+		if (!TaggedActorList)
 		{
-			if (!Singleton->ActorGameplayTagMap.Contains(IndividualTag))
+			TaggedActorList = &TaggedActorListMap.Add(Tag);
+
+			if (const float* CellSize = SpatialGridCellSizeMap.Find(Tag))
 			{
-				continue;
+				TaggedActorList->SpatialGrid.CellSize = *CellSize;
 			}
+		}
+
+		const int32 SlotIndex = TaggedActorList->ActorList.Add(Actor);
+		TaggedActorList->ActorKeyList.Add(ActorKey);
+		TaggedActorList->SpatialGrid.Invalidate();
+		ActorEntry.SlotList.Emplace(Tag, SlotIndex);
+	}
+
+	if (ActorEntry.SlotList.Num() == 0)
+	{
+		ActorEntryMap.Remove(ActorKey);
+		return false;
+	}
+
+	return bNewEntry;
+}
+
+bool FTaggedActorRegistry::Unregister(AActor* Actor, const FGameplayTagContainer& TagContainer)
+{
+	const TObjectKey<AActor> ActorKey(Actor);
+	FTaggedActorEntry* ActorEntry = ActorEntryMap.Find(ActorKey);
 
-			TArray<TWeakObjectPtr<AActor>>& TaggedActorList = Singleton->ActorGameplayTagMap[IndividualTag];
-			TaggedActorList.Remove(Actor);
+	if (!ActorEntry)
+	{
+		return false;
+	}
+
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		const int32 EntrySlotIndex = ActorEntry->SlotList.IndexOfByPredicate([&Tag](const TPair<FGameplayTag, int32>& Slot) { return Slot.Key == Tag; });
+
+		if (EntrySlotIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const int32 SlotIndex = ActorEntry->SlotList[EntrySlotIndex].Value;
+		ActorEntry->SlotList.RemoveAtSwap(EntrySlotIndex, 1, false);
+		RemoveSlot(Tag, SlotIndex);
+
+		//RemoveSlot can modify ActorEntryMap values but never adds to or removes from the map, so our entry pointer is still valid.
+	}
+
+	if (ActorEntry->SlotList.Num() == 0)
+	{
+		ActorEntryMap.Remove(ActorKey);
+		return true;
+	}
+
+	return false;
+}
+
+void FTaggedActorRegistry::UnregisterAll(AActor* Actor)
+{
+	const TObjectKey<AActor> ActorKey(Actor);
+	FTaggedActorEntry ActorEntry;
+
+	if (!ActorEntryMap.RemoveAndCopyValue(ActorKey, ActorEntry))
+	{
+		return;
+	}
 
-			if (TaggedActorList.Num() == 0)
+	for (const TPair<FGameplayTag, int32>& Slot : ActorEntry.SlotList)
+	{
+		RemoveSlot(Slot.Key, Slot.Value);
+	}
+}
+
+void FTaggedActorRegistry::RemoveSlot(const FGameplayTag& Tag, int32 SlotIndex)
+{
+	FTaggedActorList* TaggedActorList = TaggedActorListMap.Find(Tag);
+
+	if (!TaggedActorList || !TaggedActorList->ActorList.IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	const int32 LastSlotIndex = TaggedActorList->ActorList.Num() - 1;
+
+	//Point the actor occupying the last slot at the slot it is about to be swapped into.
+	if (SlotIndex != LastSlotIndex)
+	{
+		if (FTaggedActorEntry* MovedActorEntry = ActorEntryMap.Find(TaggedActorList->ActorKeyList[LastSlotIndex]))
+		{
+			if (int32* MovedSlotIndex = MovedActorEntry->FindSlot(Tag))
+			{
+				*MovedSlotIndex = SlotIndex;
+			}
+		}
+	}
+
+	TaggedActorList->ActorList.RemoveAtSwap(SlotIndex, 1, false);
+	TaggedActorList->ActorKeyList.RemoveAtSwap(SlotIndex, 1, false);
+	TaggedActorList->SpatialGrid.Invalidate();
+
+	if (TaggedActorList->ActorList.Num() == 0)
+	{
+		TaggedActorListMap.Remove(Tag);
+	}
+}
+
+void FTaggedActorRegistry::GatherTaggedActorLists(TArray<const FTaggedActorList*, TInlineAllocator<8>>& OutTaggedActorLists, const FGameplayTagContainer& TagContainer, bool bExactMatch) const
+{
+	if (bExactMatch)
+	{
+		for (const FGameplayTag& Tag : TagContainer)
+		{
+			if (const FTaggedActorList* TaggedActorList = TaggedActorListMap.Find(Tag))
 			{
-				RemovableTagEntryList.Add(IndividualTag);
+				OutTaggedActorLists.Add(TaggedActorList);
 			}
 		}
+		return;
+	}
 
-		for (const FGameplayTag& IndividualTag : RemovableTagEntryList)
+	//The number of registered tags is small compared to the number of registered actors, so walking the tags here is cheap.
+	for (const TPair<FGameplayTag, FTaggedActorList>& Entry : TaggedActorListMap)
+	{
+		if (Entry.Key.MatchesAny(TagContainer))
 		{
-			Singleton->ActorGameplayTagMap.Remove(IndividualTag);
+			OutTaggedActorLists.Add(&Entry.Value);
 		}
 	}
 }
 
-void UCoreSingleton::GetActorsWithTag(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag)
+void FTaggedActorRegistry::GetActors(TArray<AActor*>& OutActorList, const FGameplayTagContainer& TagContainer, bool bExactMatch) const
 {
-	ActorList.Reset();
-	
-	if (UCoreSingleton* Singleton = GetSingleton(WorldContextObject))
+	TArray<const FTaggedActorList*, TInlineAllocator<8>> TaggedActorLists;
+	GatherTaggedActorLists(TaggedActorLists, TagContainer, bExactMatch);
+
+	//Actors registered with more than one of the matched tags would otherwise be added more than once.
+	const bool bNeedsDeduplication = TaggedActorLists.Num() > 1;
+	TSet<AActor*> AddedActorSet;
+
+	for (const FTaggedActorList* TaggedActorList : TaggedActorLists)
 	{
-		for (const FGameplayTag& IndividualTag : Tag)
+		OutActorList.Reserve(OutActorList.Num() + TaggedActorList->ActorList.Num());
+
+		for (const TWeakObjectPtr<AActor>& Actor : TaggedActorList->ActorList)
 		{
-			if (!Singleton->ActorGameplayTagMap.Contains(IndividualTag))
+			if (!Actor.IsValid())
 			{
 				continue;
 			}
 
-			const TArray<TWeakObjectPtr<AActor>>& TaggedActorList = Singleton->ActorGameplayTagMap[IndividualTag];
-			ActorList.Reserve(ActorList.Num() + TaggedActorList.Num());
-
-			for (const TWeakObjectPtr<AActor>& Actor : TaggedActorList)
+			if (bNeedsDeduplication)
 			{
-				if (!Actor.IsValid())
+				bool bAlreadyAdded = false;
+				AddedActorSet.Add(Actor.Get(), &bAlreadyAdded);
+
+				if (bAlreadyAdded)
 				{
 					continue;
 				}
+			}
+
+			OutActorList.Add(Actor.Get());
+		}
+	}
+}
+
+void FTaggedActorRegistry::GetActorsInRadius(TArray<AActor*>& OutActorList, const FGameplayTagContainer& TagContainer, const FVector& Location, float Radius, bool bExactMatch) const
+{
+	TArray<const FTaggedActorList*, TInlineAllocator<8>> TaggedActorLists;
+	GatherTaggedActorLists(TaggedActorLists, TagContainer, bExactMatch);
+
+	const bool bNeedsDeduplication = TaggedActorLists.Num() > 1;
+	TSet<AActor*> AddedActorSet;
+	const float RadiusSquared = FMath::Square(Radius);
 
-				ActorList.Add(Actor.Get());
+	auto TestSlot = [&OutActorList, &AddedActorSet, &Location, RadiusSquared, bNeedsDeduplication](const FTaggedActorList& TaggedActorList, int32 SlotIndex)
+	{
+		AActor* Actor = TaggedActorList.ActorList[SlotIndex].Get();
+
+		if (!Actor || FVector::DistSquared(Actor->GetActorLocation(), Location) > RadiusSquared)
+		{
+			return;
+		}
+
+		if (bNeedsDeduplication)
+		{
+			bool bAlreadyAdded = false;
+			AddedActorSet.Add(Actor, &bAlreadyAdded);
+
+			if (bAlreadyAdded)
+			{
+				return;
+			}
+		}
+
+		OutActorList.Add(Actor);
+	};
+
+	for (const FTaggedActorList* TaggedActorList : TaggedActorLists)
+	{
+		const FTaggedActorSpatialGrid& SpatialGrid = TaggedActorList->SpatialGrid;
+
+		if (SpatialGrid.IsEnabled())
+		{
+			const FIntVector MinCell = SpatialGrid.GetCell(Location - FVector(Radius));
+			const FIntVector MaxCell = SpatialGrid.GetCell(Location + FVector(Radius));
+			const int64 CellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+			//Only use the grid if visiting the covered cells is cheaper than testing every actor.
+			if (CellCount < TaggedActorList->ActorList.Num())
+			{
+				if (SpatialGrid.BuildFrame != GFrameCounter)
+				{
+					RebuildSpatialGrid(*TaggedActorList);
+				}
+
+				for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+				{
+					for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+					{
+						for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+						{
+							if (const TArray<int32>* CellSlotList = SpatialGrid.CellMap.Find(FIntVector(X, Y, Z)))
+							{
+								for (int32 SlotIndex : *CellSlotList)
+								{
+									TestSlot(*TaggedActorList, SlotIndex);
+								}
+							}
+						}
+					}
+				}
+				continue;
 			}
 		}
+
+		for (int32 SlotIndex = 0; SlotIndex < TaggedActorList->ActorList.Num(); SlotIndex++)
+		{
+			TestSlot(*TaggedActorList, SlotIndex);
+		}
 	}
-}
\ No newline at end of file
+}
+
+void FTaggedActorRegistry::SetSpatialGridCellSize(const FGameplayTag& Tag, float CellSize)
+{
+	if (CellSize > 0.f)
+	{
+		SpatialGridCellSizeMap.FindOrAdd(Tag) = CellSize;
+	}
+	else
+	{
+		SpatialGridCellSizeMap.Remove(Tag);
+	}
+
+	if (FTaggedActorList* TaggedActorList = TaggedActorListMap.Find(Tag))
+	{
+		TaggedActorList->SpatialGrid.CellSize = FMath::Max(CellSize, 0.f);
+		TaggedActorList->SpatialGrid.CellMap.Reset();
+		TaggedActorList->SpatialGrid.Invalidate();
+	}
+}
+
+void FTaggedActorRegistry::RebuildSpatialGrid(const FTaggedActorList& TaggedActorList) const
+{
+	FTaggedActorSpatialGrid& SpatialGrid = TaggedActorList.SpatialGrid;
+
+	//Keep allocated cell arrays around since most actors will stay in the same cells between rebuilds, unless actors have spread out over far more cells than needed.
+	if (SpatialGrid.CellMap.Num() > TaggedActorList.ActorList.Num() * 4)
+	{
+		SpatialGrid.CellMap.Reset();
+	}
+	else
+	{
+		for (TPair<FIntVector, TArray<int32>>& Cell : SpatialGrid.CellMap)
+		{
+			Cell.Value.Reset();
+		}
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < TaggedActorList.ActorList.Num(); SlotIndex++)
+	{
+		if (const AActor* Actor = TaggedActorList.ActorList[SlotIndex].Get())
+		{
+			SpatialGrid.CellMap.FindOrAdd(SpatialGrid.GetCell(Actor->GetActorLocation())).Add(SlotIndex);
+		}
+	}
+
+	SpatialGrid.BuildFrame = GFrameCounter;
+}
@@ -0,0 +1,450 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "System/CustomizationStreamingManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/ActorComponent.h"
+#include "System/NauseaGameInstance.h"
+#include "Character/Customization/CustomizationObject.h"
+
+DECLARE_STATS_GROUP(TEXT("CustomizationStreamingManager"), STATGROUP_CustomizationStreamingManager, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Update Customization Streaming"), STAT_CustomizationStreamingUpdate, STATGROUP_CustomizationStreamingManager);
+
+uint64 FCustomizationStreamHandle::HandleIDCounter = 0;
+
+UCustomizationStreamingManager::UCustomizationStreamingManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UCustomizationStreamingManager::BeginDestroy()
+{
+	for (TPair<FSoftObjectPath, FCustomizationAssetEntry>& Entry : AssetEntryMap)
+	{
+		if (Entry.Value.Handle.IsValid())
+		{
+			Entry.Value.Handle->CancelHandle();
+		}
+	}
+
+	AssetEntryMap.Empty();
+	RequestMap.Empty();
+	OutstandingRequestCount = 0;
+
+	Super::BeginDestroy();
+}
+
+void UCustomizationStreamingManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CustomizationStreamingUpdate);
+
+	RemoveStaleRequests();
+	CompleteLoadedRequests();
+	StartPendingRequests();
+}
+
+inline UCustomizationStreamingManager* GetCustomizationStreamingManager(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+	if (!World || World->IsNetMode(NM_DedicatedServer))
+	{
+		return nullptr;
+	}
+
+	UNauseaGameInstance* NauseaGameInstance = World->GetGameInstance<UNauseaGameInstance>();
+
+	if (!NauseaGameInstance)
+	{
+		return nullptr;
+	}
+
+	return NauseaGameInstance->GetCustomizationStreamingManager();
+}
+
+FCustomizationStreamHandle UCustomizationStreamingManager::RequestLoad(const UObject* WorldContextObject, const UObject* Requester, const TArray<FSoftObjectPath>& AssetList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate)
+{
+	if (!Requester || AssetList.Num() == 0)
+	{
+		return FCustomizationStreamHandle();
+	}
+
+	UCustomizationStreamingManager* Manager = GetCustomizationStreamingManager(WorldContextObject);
+
+	if (!Manager)
+	{
+		return FCustomizationStreamHandle();
+	}
+
+	return Manager->AddRequest(Requester, AssetList, Priority, MoveTemp(Delegate));
+}
+
+bool UCustomizationStreamingManager::IsRequestComplete(const UObject* WorldContextObject, FCustomizationStreamHandle Handle)
+{
+	UCustomizationStreamingManager* Manager = GetCustomizationStreamingManager(WorldContextObject);
+
+	if (!Manager)
+	{
+		return false;
+	}
+
+	const FCustomizationStreamRequest* Request = Manager->RequestMap.Find(Handle);
+	return Request && Request->bCompleted;
+}
+
+void UCustomizationStreamingManager::ReleaseRequest(const UObject* WorldContextObject, FCustomizationStreamHandle Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	UCustomizationStreamingManager* Manager = GetCustomizationStreamingManager(WorldContextObject);
+
+	if (!Manager)
+	{
+		return;
+	}
+
+	Manager->RemoveRequest(Handle);
+}
+
+int32 UCustomizationStreamingManager::ReleaseAllRequests(const UObject* WorldContextObject, const UObject* Requester)
+{
+	UCustomizationStreamingManager* Manager = GetCustomizationStreamingManager(WorldContextObject);
+
+	if (!Manager)
+	{
+		return 0;
+	}
+
+	TArray<FCustomizationStreamHandle> ReleaseList;
+	for (const TPair<FCustomizationStreamHandle, FCustomizationStreamRequest>& Entry : Manager->RequestMap)
+	{
+		if (Entry.Value.Requester == Requester)
+		{
+			ReleaseList.Add(Entry.Key);
+		}
+	}
+
+	for (FCustomizationStreamHandle Handle : ReleaseList)
+	{
+		Manager->RemoveRequest(Handle);
+	}
+
+	return ReleaseList.Num();
+}
+
+FCustomizationStreamHandle UCustomizationStreamingManager::PreloadCustomizationList(const UObject* WorldContextObject, const UObject* Requester, const TArray<UCustomizationAsset*>& CustomizationList)
+{
+	UCustomizationStreamingManager* Manager = GetCustomizationStreamingManager(WorldContextObject);
+
+	if (!Manager || !Requester)
+	{
+		return FCustomizationStreamHandle();
+	}
+
+	for (const TPair<FCustomizationStreamHandle, FCustomizationStreamRequest>& Entry : Manager->RequestMap)
+	{
+		if (Entry.Value.Requester == Requester && Entry.Value.Priority == ECustomizationStreamPriority::Preload)
+		{
+			return Entry.Key;
+		}
+	}
+
+	TArray<FSoftObjectPath> AssetList;
+	UCustomizationAsset::GetAssetListForCustomizationList(CustomizationList, AssetList);
+
+	if (AssetList.Num() == 0)
+	{
+		return FCustomizationStreamHandle();
+	}
+
+	return Manager->AddRequest(Requester, AssetList, ECustomizationStreamPriority::Preload, FStreamableDelegate());
+}
+
+FCustomizationStreamHandle UCustomizationStreamingManager::AddRequest(const UObject* Requester, const TArray<FSoftObjectPath>& AssetList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate)
+{
+	const FCustomizationStreamHandle Handle = FCustomizationStreamHandle::GenerateHandle();
+	FCustomizationStreamRequest& Request = RequestMap.Add(Handle);
+	Request.Requester = Requester;
+	Request.Priority = Priority;
+	Request.Delegate = MoveTemp(Delegate);
+
+	bool bAllAssetsResident = true;
+	Request.AssetList.Reserve(AssetList.Num());
+	for (const FSoftObjectPath& AssetPath : AssetList)
+	{
+		if (AssetPath.IsNull())
+		{
+			continue;
+		}
+
+		Request.AssetList.AddUnique(AssetPath);
+		bAllAssetsResident &= AssetPath.ResolveObject() != nullptr;
+	}
+
+	//Requests that do not need to stream anything, or that the local player is waiting on, skip the queue.
+	if (bAllAssetsResident || Priority == ECustomizationStreamPriority::Immediate)
+	{
+		StartRequest(Request);
+		Request.bCompleted = HasRequestLoaded(Request);
+	}
+
+	if (!Request.bCompleted)
+	{
+		OutstandingRequestCount++;
+	}
+
+	return Handle;
+}
+
+void UCustomizationStreamingManager::RemoveRequest(FCustomizationStreamHandle Handle)
+{
+	FCustomizationStreamRequest* Request = RequestMap.Find(Handle);
+
+	if (!Request)
+	{
+		return;
+	}
+
+	if (!Request->bCompleted)
+	{
+		OutstandingRequestCount--;
+	}
+
+	ReleaseRequestAssets(*Request);
+	RequestMap.Remove(Handle);
+}
+
+int32 UCustomizationStreamingManager::StartRequest(FCustomizationStreamRequest& Request)
+{
+	if (Request.bStarted)
+	{
+		return 0;
+	}
+
+	Request.bStarted = true;
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	const TAsyncLoadPriority LoadPriority = Request.Priority == ECustomizationStreamPriority::Immediate ? FStreamableManager::AsyncLoadHighPriority : FStreamableManager::DefaultAsyncLoadPriority;
+
+	int32 StartedLoadCount = 0;
+	for (const FSoftObjectPath& AssetPath : Request.AssetList)
+	{
+		FCustomizationAssetEntry& Entry = AssetEntryMap.FindOrAdd(AssetPath);
+		Entry.ReferenceCount++;
+
+		if (Entry.Handle.IsValid())
+		{
+			continue;
+		}
+
+		Entry.Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), LoadPriority);
+
+		if (Entry.Handle.IsValid() && Entry.Handle->IsLoadingInProgress())
+		{
+			StartedLoadCount++;
+		}
+	}
+
+	return StartedLoadCount;
+}
+
+void UCustomizationStreamingManager::ReleaseRequestAssets(FCustomizationStreamRequest& Request)
+{
+	if (!Request.bStarted)
+	{
+		return;
+	}
+
+	Request.bStarted = false;
+
+	for (const FSoftObjectPath& AssetPath : Request.AssetList)
+	{
+		FCustomizationAssetEntry* Entry = AssetEntryMap.Find(AssetPath);
+
+		if (!Entry || --Entry->ReferenceCount > 0)
+		{
+			continue;
+		}
+
+		if (Entry->Handle.IsValid())
+		{
+			if (Entry->Handle->IsLoadingInProgress())
+			{
+				Entry->Handle->CancelHandle();
+			}
+			else
+			{
+				Entry->Handle->ReleaseHandle();
+			}
+		}
+
+		AssetEntryMap.Remove(AssetPath);
+	}
+}
+
+bool UCustomizationStreamingManager::HasRequestLoaded(const FCustomizationStreamRequest& Request) const
+{
+	if (!Request.bStarted)
+	{
+		return false;
+	}
+
+	for (const FSoftObjectPath& AssetPath : Request.AssetList)
+	{
+		const FCustomizationAssetEntry* Entry = AssetEntryMap.Find(AssetPath);
+
+		if (Entry && Entry->Handle.IsValid() && Entry->Handle->IsLoadingInProgress())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UCustomizationStreamingManager::RemoveStaleRequests()
+{
+	TArray<FCustomizationStreamHandle> StaleRequestList;
+	for (const TPair<FCustomizationStreamHandle, FCustomizationStreamRequest>& Entry : RequestMap)
+	{
+		if (!Entry.Value.Requester.IsValid())
+		{
+			StaleRequestList.Add(Entry.Key);
+		}
+	}
+
+	for (FCustomizationStreamHandle Handle : StaleRequestList)
+	{
+		RemoveRequest(Handle);
+	}
+}
+
+void UCustomizationStreamingManager::CompleteLoadedRequests()
+{
+	CompletedDelegateList.Reset();
+	for (TPair<FCustomizationStreamHandle, FCustomizationStreamRequest>& Entry : RequestMap)
+	{
+		FCustomizationStreamRequest& Request = Entry.Value;
+
+		if (Request.bCompleted || !HasRequestLoaded(Request))
+		{
+			continue;
+		}
+
+		Request.bCompleted = true;
+		OutstandingRequestCount--;
+
+		if (Request.Delegate.IsBound())
+		{
+			CompletedDelegateList.Add(MoveTemp(Request.Delegate));
+		}
+	}
+
+	//Delegates commonly apply customization which can issue or release requests so they are only fired once we are done iterating.
+	TArray<FStreamableDelegate> DelegateList = MoveTemp(CompletedDelegateList);
+	for (FStreamableDelegate& Delegate : DelegateList)
+	{
+		Delegate.ExecuteIfBound();
+	}
+}
+
+void UCustomizationStreamingManager::StartPendingRequests()
+{
+	int32 InFlightAssetCount = GetInFlightAssetCount();
+
+	if (InFlightAssetCount >= MaxInFlightAssetLoads)
+	{
+		return;
+	}
+
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation = FRotator::ZeroRotator;
+	bool bHasView = false;
+
+	if (APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
+	{
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasView = true;
+	}
+
+	const FVector ViewDirection = ViewRotation.Vector();
+
+	SortedPendingRequestList.Reset();
+	for (TPair<FCustomizationStreamHandle, FCustomizationStreamRequest>& Entry : RequestMap)
+	{
+		if (Entry.Value.bStarted)
+		{
+			continue;
+		}
+
+		Entry.Value.SortScore = GetRequestSortScore(Entry.Value, ViewLocation, ViewDirection, bHasView);
+		SortedPendingRequestList.Add(Entry.Key);
+	}
+
+	SortedPendingRequestList.Sort([this](const FCustomizationStreamHandle& A, const FCustomizationStreamHandle& B)
+	{
+		const FCustomizationStreamRequest& RequestA = RequestMap[A];
+		const FCustomizationStreamRequest& RequestB = RequestMap[B];
+
+		if (RequestA.Priority != RequestB.Priority)
+		{
+			return RequestA.Priority > RequestB.Priority;
+		}
+
+		return RequestA.SortScore < RequestB.SortScore;
+	});
+
+	for (FCustomizationStreamHandle Handle : SortedPendingRequestList)
+	{
+		if (InFlightAssetCount >= MaxInFlightAssetLoads)
+		{
+			break;
+		}
+
+		InFlightAssetCount += StartRequest(RequestMap[Handle]);
+	}
+}
+
+float UCustomizationStreamingManager::GetRequestSortScore(const FCustomizationStreamRequest& Request, const FVector& ViewLocation, const FVector& ViewDirection, bool bHasView) const
+{
+	const UObject* Requester = Request.Requester.Get();
+	const AActor* RequesterActor = Cast<AActor>(Requester);
+
+	if (const UActorComponent* RequesterComponent = Cast<UActorComponent>(Requester))
+	{
+		RequesterActor = RequesterComponent->GetOwner();
+	}
+
+	if (!RequesterActor || !bHasView)
+	{
+		return 0.f;
+	}
+
+	const FVector ViewOffset = RequesterActor->GetActorLocation() - ViewLocation;
+	const float Distance = ViewOffset.Size();
+
+	//Characters still waiting on their customization may have nothing to render yet so also accept anything roughly in front of the view.
+	const bool bOnScreen = RequesterActor->WasRecentlyRendered(0.2f) || FVector::DotProduct(ViewDirection, ViewOffset.GetSafeNormal()) > 0.5f;
+	return bOnScreen ? Distance : Distance + OffscreenDistancePenalty;
+}
+
+int32 UCustomizationStreamingManager::GetInFlightAssetCount() const
+{
+	int32 InFlightAssetCount = 0;
+	for (const TPair<FSoftObjectPath, FCustomizationAssetEntry>& Entry : AssetEntryMap)
+	{
+		if (Entry.Value.Handle.IsValid() && Entry.Value.Handle->IsLoadingInProgress())
+		{
+			InFlightAssetCount++;
+		}
+	}
+
+	return InFlightAssetCount;
+}
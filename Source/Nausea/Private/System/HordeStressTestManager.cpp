@@ -0,0 +1,350 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "System/HordeStressTestManager.h"
+#include "Nausea.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameMode.h"
+#include "GameFramework/PlayerController.h"
+#include "Character/CoreCharacter.h"
+#include "Character/DungeonCharacter.h"
+#include "Gameplay/AbilityComponent.h"
+#include "Weapon/InventoryManagerComponent.h"
+#include "Overlord/DungeonGameMode.h"
+#include "Overlord/DungeonGameState.h"
+
+DEFINE_LOG_CATEGORY(LogHordeStressTest);
+
+UHordeStressTestManager::UHordeStressTestManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+bool UHordeStressTestManager::IsStressTestRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("HordeStressTest"));
+}
+
+void UHordeStressTestManager::StartStressTest()
+{
+	if (bRunning)
+	{
+		return;
+	}
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("StressDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("StressSampleInterval="), SampleInterval);
+	FParse::Value(CommandLine, TEXT("StressWaveInterval="), WaveInterval);
+	FParse::Value(CommandLine, TEXT("StressMatchStartTimeout="), MatchStartTimeout);
+	FParse::Value(CommandLine, TEXT("StressReportDir="), ReportDirectory);
+
+	SampleInterval = FMath::Max(SampleInterval, 0.1f);
+
+	UE_LOG(LogHordeStressTest, Log, TEXT("Horde stress test requested. Duration: %.1fs Sample Interval: %.1fs Wave Interval: %.1fs Match Start Timeout: %.1fs"),
+		Duration, SampleInterval, WaveInterval, MatchStartTimeout);
+
+	bRunning = true;
+}
+
+void UHordeStressTestManager::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+
+	if (!World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	if (!bRunStarted)
+	{
+		BeginRun();
+	}
+
+	if (bFinishing)
+	{
+#if CSV_PROFILER
+		//Wait for the capture to be written out before exiting.
+		if (CaptureFuture.IsValid() && !CaptureFuture.IsReady())
+		{
+			return;
+		}
+#endif //CSV_PROFILER
+
+		bRunning = false;
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+
+	FrameCount++;
+	TotalFrameTime += DeltaTime;
+	MaxFrameTime = FMath::Max(MaxFrameTime, DeltaTime);
+
+	const float ElapsedTime = float(FPlatformTime::Seconds() - RunStartTime);
+
+	if (World->GetNetMode() == NM_Client)
+	{
+		UpdateSimulatedClient(World, DeltaTime);
+	}
+	else if (World->GetAuthGameMode())
+	{
+		UpdateServer(World, DeltaTime, ElapsedTime);
+	}
+
+	TimeUntilSample -= DeltaTime;
+
+	if (TimeUntilSample <= 0.f)
+	{
+		TimeUntilSample = SampleInterval;
+		RecordSample(World);
+	}
+
+	if (ElapsedTime >= Duration)
+	{
+		FinishRun();
+	}
+}
+
+void UHordeStressTestManager::BeginRun()
+{
+	bRunStarted = true;
+	RunStartTime = FPlatformTime::Seconds();
+	TimeUntilSample = 0.f;
+	TimeUntilForcedWave = WaveInterval;
+	TimeUntilFireToggle = 0.f;
+	TimeUntilAbility = AbilityInterval;
+
+#if CSV_PROFILER
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+
+	if (CsvProfiler && !CsvProfiler->IsCapturing())
+	{
+		const TCHAR* Role = IsRunningDedicatedServer() ? TEXT("Server") : TEXT("Client");
+		const FString Filename = FString::Printf(TEXT("HordeStressTest_%s_%u_%s.csv"), Role, FPlatformProcess::GetCurrentProcessId(), *FDateTime::Now().ToString());
+		CsvProfiler->BeginCapture(-1, ReportDirectory, Filename);
+		CSV_METADATA(TEXT("HordeStressTestRole"), Role);
+
+		UE_LOG(LogHordeStressTest, Log, TEXT("Horde stress test started. Writing capture %s."), *Filename);
+		return;
+	}
+#endif //CSV_PROFILER
+
+	UE_LOG(LogHordeStressTest, Warning, TEXT("Horde stress test started without a CSV capture (CSV profiler is unavailable or already capturing). Only the summary will be logged."));
+}
+
+void UHordeStressTestManager::FinishRun()
+{
+	if (bFinishing)
+	{
+		return;
+	}
+
+	bFinishing = true;
+
+	UWorld* World = GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	ACoreCharacter* Character = PlayerController ? Cast<ACoreCharacter>(PlayerController->GetPawn()) : nullptr;
+
+	if (bHoldingFire && Character && Character->GetInventoryManager())
+	{
+		Character->GetInventoryManager()->StopFire(EFireMode::Primary);
+	}
+
+	bHoldingFire = false;
+
+	UE_LOG(LogHordeStressTest, Log, TEXT("Horde stress test finished after %.1fs. Frames: %i Average Frame Time: %.2fms Max Frame Time: %.2fms Peak Character Count: %i Peak Out Bytes Per Second: %i"),
+		float(FPlatformTime::Seconds() - RunStartTime), FrameCount, FrameCount > 0 ? (TotalFrameTime / float(FrameCount)) * 1000.f : 0.f, MaxFrameTime * 1000.f,
+		PeakCharacterCount, PeakOutBytesPerSecond);
+
+#if CSV_PROFILER
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+
+	if (CsvProfiler && CsvProfiler->IsCapturing())
+	{
+		CaptureFuture = CsvProfiler->EndCapture();
+	}
+#endif //CSV_PROFILER
+}
+
+void UHordeStressTestManager::UpdateServer(UWorld* World, float DeltaTime, float ElapsedTime)
+{
+	AGameMode* GameMode = World->GetAuthGameMode<AGameMode>();
+
+	if (!GameMode)
+	{
+		return;
+	}
+
+	if (!GameMode->HasMatchStarted())
+	{
+		if (ElapsedTime >= MatchStartTimeout && GameMode->GetMatchState() == MatchState::WaitingToStart)
+		{
+			UE_LOG(LogHordeStressTest, Log, TEXT("Match has not started after %.1fs, starting it without ready players."), ElapsedTime);
+			GameMode->StartMatch();
+		}
+
+		return;
+	}
+
+	const FName CurrentMatchState = GameMode->GetMatchState();
+
+	if (GameMode->HasMatchEnded() || CurrentMatchState == MatchState::EndVictory || CurrentMatchState == MatchState::EndLoss)
+	{
+		UE_LOG(LogHordeStressTest, Log, TEXT("Match ended (%s), ending horde stress test."), *CurrentMatchState.ToString());
+		FinishRun();
+		return;
+	}
+
+	if (WaveInterval <= 0.f)
+	{
+		return;
+	}
+
+	TimeUntilForcedWave -= DeltaTime;
+
+	if (TimeUntilForcedWave > 0.f)
+	{
+		return;
+	}
+
+	ADungeonGameMode* DungeonGameMode = Cast<ADungeonGameMode>(GameMode);
+
+	//Keep retrying every tick until the current wave has finished spawning. Past the final wave this simply never succeeds.
+	if (DungeonGameMode && DungeonGameMode->ForceStartNextWave())
+	{
+		TimeUntilForcedWave = WaveInterval;
+	}
+}
+
+void UHordeStressTestManager::UpdateSimulatedClient(UWorld* World, float DeltaTime)
+{
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+	ACoreCharacter* Character = PlayerController ? Cast<ACoreCharacter>(PlayerController->GetPawn()) : nullptr;
+
+	if (!Character || Character->IsDead())
+	{
+		bHoldingFire = false;
+		return;
+	}
+
+	FRotator ControlRotation = PlayerController->GetControlRotation();
+	ControlRotation.Yaw = FRotator::NormalizeAxis(ControlRotation.Yaw + (TurnRate * DeltaTime));
+	PlayerController->SetControlRotation(ControlRotation);
+
+	TimeUntilFireToggle -= DeltaTime;
+
+	if (TimeUntilFireToggle <= 0.f)
+	{
+		TimeUntilFireToggle = FireBurstDuration;
+
+		if (UInventoryManagerComponent* InventoryManager = Character->GetInventoryManager())
+		{
+			if (bHoldingFire)
+			{
+				InventoryManager->StopFire(EFireMode::Primary);
+			}
+			else
+			{
+				InventoryManager->StartFire(EFireMode::Primary);
+			}
+
+			bHoldingFire = !bHoldingFire;
+		}
+	}
+
+	TimeUntilAbility -= DeltaTime;
+
+	if (TimeUntilAbility > 0.f)
+	{
+		return;
+	}
+
+	TimeUntilAbility = AbilityInterval;
+
+	UAbilityComponent* AbilityComponent = Character->GetAbilityComponent();
+
+	if (!AbilityComponent || !AbilityComponent->IsLocallyOwned() || AbilityComponent->GetAbilityClassList().Num() == 0)
+	{
+		return;
+	}
+
+	const TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList = AbilityComponent->GetAbilityClassList();
+	TSubclassOf<UAbilityInfo> AbilityClass = AbilityClassList[FMath::RandRange(0, AbilityClassList.Num() - 1)];
+
+	if (!AbilityClass || AbilityComponent->CanPerformAbility(AbilityClass) != EAbilityRequestResponse::Success)
+	{
+		return;
+	}
+
+	TArray<FAbilityTargetData> AbilityTargetData;
+	AbilityTargetData.Add(FAbilityTargetData::GenerateTargetLocationData(Character->GetActorTransform()));
+	AbilityClass.GetDefaultObject()->ProcessTargetData(AbilityComponent, AbilityTargetData);
+	AbilityComponent->PerformAbility(FAbilityInstanceData::GenerateInstanceData(AbilityClass, AbilityTargetData));
+}
+
+void UHordeStressTestManager::RecordSample(UWorld* World)
+{
+	int32 CharacterCount = 0;
+	for (TActorIterator<ADungeonCharacter> Iterator(World); Iterator; ++Iterator)
+	{
+		CharacterCount++;
+	}
+
+	PeakCharacterCount = FMath::Max(PeakCharacterCount, CharacterCount);
+
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	const int32 OutBytesPerSecond = NetDriver ? int32(NetDriver->OutBytesPerSecond) : 0;
+	PeakOutBytesPerSecond = FMath::Max(PeakOutBytesPerSecond, OutBytesPerSecond);
+
+#if CSV_PROFILER
+	CSV_CUSTOM_STAT(Nausea, DungeonCharacterCount, CharacterCount, ECsvCustomStatOp::Set);
+
+	if (const ADungeonGameState* DungeonGameState = World->GetGameState<ADungeonGameState>())
+	{
+		CSV_CUSTOM_STAT(Nausea, WaveNumber, int32(DungeonGameState->GetCurrentWaveNumber()), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Nausea, WaveRemainingSpawnCount, int32(DungeonGameState->GetWaveRemainingSpawnCount()), ECsvCustomStatOp::Set);
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	CSV_CUSTOM_STAT(Nausea, UsedPhysicalMB, float(double(MemoryStats.UsedPhysical) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Nausea, UsedVirtualMB, float(double(MemoryStats.UsedVirtual) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	CSV_CUSTOM_STAT(Nausea, NetOutBytesPerSecond, OutBytesPerSecond, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Nausea, NetInBytesPerSecond, int32(NetDriver->InBytesPerSecond), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Nausea, NetConnectionCount, NetDriver->ClientConnections.Num(), ECsvCustomStatOp::Set);
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection)
+		{
+			continue;
+		}
+
+		const int32 ConnectionIndex = GetConnectionIndex(Connection);
+		FCsvProfiler::RecordCustomStat(FName(*FString::Printf(TEXT("Connection%iOutBytesPerSecond"), ConnectionIndex)), CSV_CATEGORY_INDEX(Nausea), Connection->OutBytesPerSecond, ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(FName(*FString::Printf(TEXT("Connection%iInBytesPerSecond"), ConnectionIndex)), CSV_CATEGORY_INDEX(Nausea), Connection->InBytesPerSecond, ECsvCustomStatOp::Set);
+	}
+#endif //CSV_PROFILER
+}
+
+int32 UHordeStressTestManager::GetConnectionIndex(const UNetConnection* Connection)
+{
+	if (const int32* ConnectionIndex = ConnectionIndexMap.Find(Connection))
+	{
+		return *ConnectionIndex;
+	}
+
+	return ConnectionIndexMap.Add(Connection, ConnectionIndexMap.Num());
+}
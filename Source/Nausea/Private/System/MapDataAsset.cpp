@@ -3,15 +3,117 @@
 
 #include "System/MapDataAsset.h"
 #include "Internationalization/StringTableRegistry.h"
+#include "AssetData.h"
 
 const FPrimaryAssetType UMapDataAsset::MapDataAssetType = FName(TEXT("MapDataAsset"));
 
+//Asset registry tags written by UMapDataAsset::GetAssetRegistryTags and read back by UMapDataAsset::ReadIndexEntry.
+static const FName MapAssetTagName = FName(TEXT("MapAsset"));
+static const FName MapNameTagName = FName(TEXT("MapName"));
+static const FName MapIconTagName = FName(TEXT("MapIcon"));
+static const FName GameTypeTagName = FName(TEXT("GameType"));
+static const FName MainMenuTagName = FName(TEXT("MainMenu"));
+static const FName MinPlayerCountTagName = FName(TEXT("MinPlayerCount"));
+static const FName MaxPlayerCountTagName = FName(TEXT("MaxPlayerCount"));
+static const FName MapTagsTagName = FName(TEXT("MapTags"));
+
 UMapDataAsset::UMapDataAsset(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 
 }
 
+void UMapDataAsset::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	FString MapNameString;
+	FTextStringHelper::WriteToBuffer(MapNameString, MapName);
+
+	OutTags.Add(FAssetRegistryTag(MapAssetTagName, MapAsset.ToString(), FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(FAssetRegistryTag(MapNameTagName, MapNameString, FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(MapIconTagName, MapIcon.ToString(), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(GameTypeTagName, StaticEnum<EGameType>()->GetNameStringByValue(int64(GameType)), FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(FAssetRegistryTag(MainMenuTagName, LexToString(bMainMenu), FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(FAssetRegistryTag(MinPlayerCountTagName, LexToString(MinPlayerCount), FAssetRegistryTag::TT_Numerical));
+	OutTags.Add(FAssetRegistryTag(MaxPlayerCountTagName, LexToString(MaxPlayerCount), FAssetRegistryTag::TT_Numerical));
+	OutTags.Add(FAssetRegistryTag(MapTagsTagName, MapTags.ToStringSimple(), FAssetRegistryTag::TT_Alphabetical));
+}
+
+bool UMapDataAsset::ReadIndexEntry(const FAssetData& AssetData, FMapDataIndexEntry& OutEntry)
+{
+	FString TagValue;
+
+	//Assets saved before registry tags were written will not have any of them.
+	if (!AssetData.IsValid() || !AssetData.GetTagValue(MapAssetTagName, TagValue))
+	{
+		return false;
+	}
+
+	OutEntry.MapDataAsset = TSoftObjectPtr<UMapDataAsset>(AssetData.ToSoftObjectPath());
+	OutEntry.MapAsset = TSoftObjectPtr<UWorld>(FSoftObjectPath(TagValue));
+
+	AssetData.GetTagValue(MapNameTagName, OutEntry.MapName);
+
+	if (AssetData.GetTagValue(MapIconTagName, TagValue))
+	{
+		OutEntry.MapIcon = TSoftObjectPtr<UTexture>(FSoftObjectPath(TagValue));
+	}
+
+	if (AssetData.GetTagValue(GameTypeTagName, TagValue))
+	{
+		const int64 GameTypeValue = StaticEnum<EGameType>()->GetValueByNameString(TagValue);
+		OutEntry.GameType = GameTypeValue != INDEX_NONE ? EGameType(GameTypeValue) : EGameType::Invalid;
+	}
+
+	if (AssetData.GetTagValue(MainMenuTagName, TagValue))
+	{
+		OutEntry.bMainMenu = TagValue.ToBool();
+	}
+
+	if (AssetData.GetTagValue(MinPlayerCountTagName, TagValue))
+	{
+		LexFromString(OutEntry.MinPlayerCount, *TagValue);
+	}
+
+	if (AssetData.GetTagValue(MaxPlayerCountTagName, TagValue))
+	{
+		LexFromString(OutEntry.MaxPlayerCount, *TagValue);
+	}
+
+	OutEntry.MapTags.Reset();
+	if (AssetData.GetTagValue(MapTagsTagName, TagValue))
+	{
+		TArray<FString> TagNameList;
+		TagValue.ParseIntoArray(TagNameList, TEXT(","), true);
+
+		for (const FString& TagName : TagNameList)
+		{
+			const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName.TrimStartAndEnd()), false);
+
+			if (Tag.IsValid())
+			{
+				OutEntry.MapTags.AddTag(Tag);
+			}
+		}
+	}
+
+	return true;
+}
+
+void UMapDataAsset::GetIndexEntry(FMapDataIndexEntry& OutEntry) const
+{
+	OutEntry.MapDataAsset = TSoftObjectPtr<UMapDataAsset>(FSoftObjectPath(this));
+	OutEntry.MapAsset = MapAsset;
+	OutEntry.MapName = MapName;
+	OutEntry.MapIcon = MapIcon;
+	OutEntry.GameType = GameType;
+	OutEntry.bMainMenu = bMainMenu;
+	OutEntry.MinPlayerCount = MinPlayerCount;
+	OutEntry.MaxPlayerCount = MaxPlayerCount;
+	OutEntry.MapTags = MapTags;
+}
+
 FText UMapDataAsset::GetGameTypeTextForEnum(EGameType GameType)
 {
 	switch (GameType)
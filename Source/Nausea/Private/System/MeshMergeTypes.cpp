@@ -1,12 +1,15 @@
 
 #include "System/MeshMergeTypes.h"
 #include "Async/Async.h"
+#include "Engine/World.h"
 #include "Engine/AssetManager.h"
 #include "SkeletalMeshMerge.h"
 #include "Engine/SkeletalMesh.h"
 #include "Rendering/SkeletalMeshRenderData.h"
 #include "Animation/Skeleton.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "GPUSkinVertexFactory.h"
 #include "Engine/Public/SkeletalMeshMerge.h"
 #include "System/NauseaGameInstance.h"
 #include "Character/Customization/CustomizationObject.h"
@@ -28,6 +31,61 @@ bool FMeshList::operator!=(const FMeshList& Other) const
 	return MeshList != Other.MeshList;
 }
 
+void FSharedMaterialKey::SetTextureOverride(FName ParameterName, UTexture* Texture)
+{
+	for (TPair<FName, TWeakObjectPtr<UTexture>>& TextureOverride : TextureOverrideList)
+	{
+		if (TextureOverride.Key == ParameterName)
+		{
+			TextureOverride.Value = Texture;
+			return;
+		}
+	}
+
+	TextureOverrideList.Emplace(ParameterName, Texture);
+	TextureOverrideList.Sort([](const TPair<FName, TWeakObjectPtr<UTexture>>& A, const TPair<FName, TWeakObjectPtr<UTexture>>& B)
+	{
+		return A.Key.LexicalLess(B.Key);
+	});
+}
+
+inline UCustomizationMergeManager* GetCustomizationMergeManager(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+	if (!World || World->IsNetMode(NM_DedicatedServer))
+	{
+		return nullptr;
+	}
+
+	UNauseaGameInstance* NauseaGameInstance = World->GetGameInstance<UNauseaGameInstance>();
+
+	if (!NauseaGameInstance)
+	{
+		return nullptr;
+	}
+
+	return NauseaGameInstance->GetCustomizationManager();
+}
+
+void UCustomizationMergeManager::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UCustomizationMergeManager::OnWorldCleanup);
+	}
+}
+
+void UCustomizationMergeManager::BeginDestroy()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	WorldCleanupHandle.Reset();
+
+	Super::BeginDestroy();
+}
+
 FMeshMergeHandle UCustomizationMergeManager::RequestMeshMerge(const UObject* WorldContextObject, const FMeshList& MeshList, FCustomizationMergeRequestDelegate&& Delegate)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
@@ -235,6 +293,8 @@ void UCustomizationMergeManager::PerformMeshMerge(FActiveMergeRequest& Request,
 
 	TargetMesh->SetSkeleton(SkeletalMeshList[0]->GetSkeleton());
 	TargetMesh->SetPhysicsAsset(SkeletalMeshList[0]->GetPhysicsAsset());
+
+	BuildSectionMapping(SkeletalMeshList, SectionMapping.Get());
 	
 	AsyncTask(ENamedThreads::GameThread, [WeakThis, Handle, TargetMesh, SkeletalMeshList, SectionMapping]()
 	{
@@ -244,6 +304,7 @@ void UCustomizationMergeManager::PerformMeshMerge(FActiveMergeRequest& Request,
 		}
 
 		QUICK_SCOPE_CYCLE_COUNTER(STAT_Customization_PerformMerge);
+		const double MergeStartTime = FPlatformTime::Seconds();
 		FSkeletalMeshMerge SkeletalMeshMerger(TargetMesh.Get(), SkeletalMeshList, SectionMapping.Get(), 0, EMeshBufferAccess::Default, nullptr);
 
 		{
@@ -256,6 +317,8 @@ void UCustomizationMergeManager::PerformMeshMerge(FActiveMergeRequest& Request,
 			SkeletalMeshMerger.FinalizeMesh();
 		}
 
+		WeakThis->RecordMergeTime((FPlatformTime::Seconds() - MergeStartTime) * 1000.0);
+
 		AsyncTask(ENamedThreads::GameThread, [WeakThis, Handle, TargetMesh]()
 			{
 				QUICK_SCOPE_CYCLE_COUNTER(STAT_Customization_ApplyMergeMesh);
@@ -284,6 +347,14 @@ void UCustomizationMergeManager::StartNextPendingMeshMerge()
 		return;
 	}
 
+	//Pay back time previous merges spent over budget before starting another.
+	if (MergeBudgetDebt > 0.0)
+	{
+		MergeBudgetDebt = FMath::Max(MergeBudgetDebt - double(MergeBudgetMilliseconds), 0.0);
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UCustomizationMergeManager::StartNextPendingMeshMerge));
+		return;
+	}
+
 	FPendingMergeRequest& PendingMerge = PendingMergeList[0];
 
 	if (!PendingMerge.HasDelegates())
@@ -310,6 +381,7 @@ void UCustomizationMergeManager::MeshMergeComplete(FActiveMergeRequest& Request)
 	if (Request.IsValid())
 	{
 		MergedMeshMap.Add(Request.GetHandle(), MoveTempIfPossible(FMergedMesh(Request)));
+		MergedMeshHashMap.Add(GetTypeHash(static_cast<const FMeshList&>(Request)), Request.GetHandle());
 
 		Request.MarkCompleted();
 		Request.BroadcastComplete();
@@ -324,6 +396,11 @@ void UCustomizationMergeManager::MeshMergeComplete(FActiveMergeRequest& Request)
 	GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UCustomizationMergeManager::StartNextPendingMeshMerge));
 }
 
+void UCustomizationMergeManager::RecordMergeTime(double MergeMilliseconds)
+{
+	MergeBudgetDebt += FMath::Max(MergeMilliseconds - double(MergeBudgetMilliseconds), 0.0);
+}
+
 FActiveMergeRequest& UCustomizationMergeManager::GetActiveMergeRequest(FMeshMergeHandle Handle)
 {
 	static FActiveMergeRequest InvalidRequest = FActiveMergeRequest();
@@ -341,15 +418,15 @@ FActiveMergeRequest& UCustomizationMergeManager::GetActiveMergeRequest(FMeshMerg
 
 FMeshMergeHandle UCustomizationMergeManager::GetMergedMeshFromCustomizationSet(const FMeshList& InMeshList) const
 {
-	for (const TPair<FMeshMergeHandle, FMergedMesh>& Entry : MergedMeshMap)
+	const FMeshMergeHandle* Handle = MergedMeshHashMap.Find(GetTypeHash(InMeshList));
+
+	if (!Handle)
 	{
-		if (Entry.Value == InMeshList)
-		{
-			return Entry.Key;
-		}
+		return FMeshMergeHandle();
 	}
 
-	return FMeshMergeHandle();
+	const FMergedMesh* MergedMesh = MergedMeshMap.Find(*Handle);
+	return MergedMesh && *MergedMesh == InMeshList ? *Handle : FMeshMergeHandle();
 }
 
 FMeshMergeHandle UCustomizationMergeManager::GetActiveMergeRequestFromCustomizationSet(const FMeshList& InMeshList) const
@@ -376,4 +453,268 @@ FMeshMergeHandle UCustomizationMergeManager::GetPendingMergeRequestFromCustomiza
 	}
 
 	return FMeshMergeHandle();
-}
\ No newline at end of file
+}
+
+void UCustomizationMergeManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	const TObjectKey<UWorld> WorldKey(World);
+
+	//Drop shared instances no remaining world uses so that they (and the override textures they reference) can be garbage collected.
+	for (TMap<TObjectKey<UMaterialInterface>, FSharedMaterialEntry>::TIterator Iterator = SharedMaterialEntryMap.CreateIterator(); Iterator; ++Iterator)
+	{
+		FSharedMaterialEntry& Entry = Iterator.Value();
+		Entry.WorldList.RemoveSwap(WorldKey);
+
+		if (Entry.WorldList.Num() != 0)
+		{
+			continue;
+		}
+
+		const uint32 KeyHash = GetTypeHash(Entry.Key);
+		UMaterialInstanceDynamic* const* SharedMaterial = SharedMaterialMap.Find(KeyHash);
+
+		if (SharedMaterial && TObjectKey<UMaterialInterface>(*SharedMaterial) == Iterator.Key())
+		{
+			SharedMaterialMap.Remove(KeyHash);
+		}
+
+		Iterator.RemoveCurrent();
+	}
+}
+
+UMaterialInterface* UCustomizationMergeManager::GetSharedTextureOverrideMaterial(const UObject* WorldContextObject, UMaterialInterface* SourceMaterial, FName ParameterName, UTexture* Texture)
+{
+	UCustomizationMergeManager* Manager = GetCustomizationMergeManager(WorldContextObject);
+
+	if (!Manager || !SourceMaterial)
+	{
+		return nullptr;
+	}
+
+	const TObjectKey<UWorld> WorldKey(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull));
+
+	//If the source is already one of our shared instances, build on top of the overrides it was made with rather than nesting instances.
+	FSharedMaterialKey Key;
+	if (const FSharedMaterialEntry* SourceEntry = Manager->SharedMaterialEntryMap.Find(SourceMaterial))
+	{
+		Key = SourceEntry->Key;
+	}
+	else
+	{
+		Key.SourceMaterial = SourceMaterial;
+	}
+
+	Key.SetTextureOverride(ParameterName, Texture);
+
+	if (!Key.SourceMaterial.IsValid())
+	{
+		return nullptr;
+	}
+
+	const uint32 KeyHash = GetTypeHash(Key);
+
+	if (UMaterialInstanceDynamic* const* SharedMaterial = Manager->SharedMaterialMap.Find(KeyHash))
+	{
+		FSharedMaterialEntry* SharedEntry = *SharedMaterial ? Manager->SharedMaterialEntryMap.Find(*SharedMaterial) : nullptr;
+
+		if (SharedEntry && SharedEntry->Key == Key)
+		{
+			SharedEntry->WorldList.AddUnique(WorldKey);
+			return *SharedMaterial;
+		}
+	}
+
+	UMaterialInstanceDynamic* SharedMaterial = UMaterialInstanceDynamic::Create(Key.SourceMaterial.Get(), Manager);
+
+	for (const TPair<FName, TWeakObjectPtr<UTexture>>& TextureOverride : Key.TextureOverrideList)
+	{
+		SharedMaterial->SetTextureParameterValue(TextureOverride.Key, TextureOverride.Value.Get());
+	}
+
+	Manager->SharedMaterialMap.Add(KeyHash, SharedMaterial);
+	FSharedMaterialEntry& SharedEntry = Manager->SharedMaterialEntryMap.Add(SharedMaterial);
+	SharedEntry.Key = MoveTemp(Key);
+	SharedEntry.WorldList.Add(WorldKey);
+	return SharedMaterial;
+}
+
+inline const UMaterialInterface* GetSectionMaterial(const USkeletalMesh* SkeletalMesh, int32 LODIndex, int32 SectionIndex, int32 MaterialIndex)
+{
+	if (const FSkeletalMeshLODInfo* LODInfo = SkeletalMesh->GetLODInfo(LODIndex))
+	{
+		if (LODInfo->LODMaterialMap.IsValidIndex(SectionIndex) && LODInfo->LODMaterialMap[SectionIndex] != INDEX_NONE)
+		{
+			MaterialIndex = LODInfo->LODMaterialMap[SectionIndex];
+		}
+	}
+
+	const TArray<FSkeletalMaterial>& MaterialList = SkeletalMesh->GetMaterials();
+	return MaterialList.IsValidIndex(MaterialIndex) ? MaterialList[MaterialIndex].MaterialInterface : nullptr;
+}
+
+void UCustomizationMergeManager::BuildSectionMapping(const TArray<USkeletalMesh*>& SkeletalMeshList, TArray<FSkelMeshMergeSectionMapping>& OutSectionMapping)
+{
+	struct FMergeSectionGroup
+	{
+		const UMaterialInterface* Material = nullptr;
+		uint32 MaterialHash = 0;
+		//Names of the bones referenced by this group's sections, per LOD.
+		TArray<TSet<FName>> LODBoneNameList;
+	};
+
+	OutSectionMapping.Reset();
+	OutSectionMapping.SetNum(SkeletalMeshList.Num());
+
+	const int32 MaxBonesPerSection = FGPUBaseSkinVertexFactory::GetMaxGPUSkinBones();
+	TArray<FMergeSectionGroup> GroupList;
+	TSet<FName> CombinedBoneNameSet;
+
+	for (int32 MeshIndex = 0; MeshIndex < SkeletalMeshList.Num(); MeshIndex++)
+	{
+		const USkeletalMesh* SkeletalMesh = SkeletalMeshList[MeshIndex];
+		const FSkeletalMeshRenderData* RenderData = SkeletalMesh ? SkeletalMesh->GetResourceForRendering() : nullptr;
+
+		if (!RenderData || RenderData->LODRenderData.Num() == 0)
+		{
+			continue;
+		}
+
+		const TIndirectArray<FSkeletalMeshLODRenderData>& LODRenderDataList = RenderData->LODRenderData;
+		const int32 SectionCount = LODRenderDataList[0].RenderSections.Num();
+
+		//Forced section IDs are applied to the same section index on every LOD so only meshes whose LODs share a section layout can be remapped.
+		bool bHasConsistentSections = true;
+		for (int32 LODIndex = 1; LODIndex < LODRenderDataList.Num() && bHasConsistentSections; LODIndex++)
+		{
+			const TArray<FSkelMeshRenderSection>& RenderSections = LODRenderDataList[LODIndex].RenderSections;
+			bHasConsistentSections = RenderSections.Num() == SectionCount;
+
+			for (int32 SectionIndex = 0; SectionIndex < SectionCount && bHasConsistentSections; SectionIndex++)
+			{
+				bHasConsistentSections = GetSectionMaterial(SkeletalMesh, LODIndex, SectionIndex, RenderSections[SectionIndex].MaterialIndex)
+					== GetSectionMaterial(SkeletalMesh, 0, SectionIndex, LODRenderDataList[0].RenderSections[SectionIndex].MaterialIndex);
+			}
+		}
+
+		if (!bHasConsistentSections)
+		{
+			continue;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetRefSkeleton();
+		TArray<int32>& SectionIDs = OutSectionMapping[MeshIndex].SectionIDs;
+		SectionIDs.Init(INDEX_NONE, SectionCount);
+
+		for (int32 SectionIndex = 0; SectionIndex < SectionCount; SectionIndex++)
+		{
+			const UMaterialInterface* Material = GetSectionMaterial(SkeletalMesh, 0, SectionIndex, LODRenderDataList[0].RenderSections[SectionIndex].MaterialIndex);
+			const uint32 MaterialHash = GetMaterialCompatibilityHash(Material);
+
+			auto CanAddToGroup = [&](const FMergeSectionGroup& Group)
+			{
+				if (Group.MaterialHash != MaterialHash || !AreMaterialsCompatible(Group.Material, Material))
+				{
+					return false;
+				}
+
+				for (int32 LODIndex = 0; LODIndex < LODRenderDataList.Num(); LODIndex++)
+				{
+					CombinedBoneNameSet.Reset();
+
+					if (Group.LODBoneNameList.IsValidIndex(LODIndex))
+					{
+						CombinedBoneNameSet.Append(Group.LODBoneNameList[LODIndex]);
+					}
+
+					for (FBoneIndexType BoneIndex : LODRenderDataList[LODIndex].RenderSections[SectionIndex].BoneMap)
+					{
+						CombinedBoneNameSet.Add(RefSkeleton.GetBoneName(BoneIndex));
+					}
+
+					if (CombinedBoneNameSet.Num() > MaxBonesPerSection)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			};
+
+			int32 GroupIndex = GroupList.IndexOfByPredicate(CanAddToGroup);
+
+			if (GroupIndex == INDEX_NONE)
+			{
+				GroupIndex = GroupList.AddDefaulted();
+				GroupList[GroupIndex].Material = Material;
+				GroupList[GroupIndex].MaterialHash = MaterialHash;
+			}
+
+			FMergeSectionGroup& Group = GroupList[GroupIndex];
+			if (Group.LODBoneNameList.Num() < LODRenderDataList.Num())
+			{
+				Group.LODBoneNameList.SetNum(LODRenderDataList.Num());
+			}
+
+			for (int32 LODIndex = 0; LODIndex < LODRenderDataList.Num(); LODIndex++)
+			{
+				for (FBoneIndexType BoneIndex : LODRenderDataList[LODIndex].RenderSections[SectionIndex].BoneMap)
+				{
+					Group.LODBoneNameList[LODIndex].Add(RefSkeleton.GetBoneName(BoneIndex));
+				}
+			}
+
+			SectionIDs[SectionIndex] = GroupIndex;
+		}
+	}
+}
+
+bool UCustomizationMergeManager::AreMaterialsCompatible(const UMaterialInterface* MaterialA, const UMaterialInterface* MaterialB)
+{
+	if (MaterialA == MaterialB)
+	{
+		return true;
+	}
+
+	const UMaterialInstance* InstanceA = Cast<UMaterialInstance>(MaterialA);
+	const UMaterialInstance* InstanceB = Cast<UMaterialInstance>(MaterialB);
+
+	//Instances with static permutations compile their own shaders and can not stand in for one another.
+	if (!InstanceA || !InstanceB || InstanceA->bHasStaticPermutationResource || InstanceB->bHasStaticPermutationResource)
+	{
+		return false;
+	}
+
+	return InstanceA->Parent == InstanceB->Parent
+		&& InstanceA->ScalarParameterValues == InstanceB->ScalarParameterValues
+		&& InstanceA->VectorParameterValues == InstanceB->VectorParameterValues
+		&& InstanceA->TextureParameterValues == InstanceB->TextureParameterValues;
+}
+
+uint32 UCustomizationMergeManager::GetMaterialCompatibilityHash(const UMaterialInterface* Material)
+{
+	const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Material);
+
+	if (!MaterialInstance || MaterialInstance->bHasStaticPermutationResource)
+	{
+		return PointerHash(Material);
+	}
+
+	uint32 Hash = PointerHash(MaterialInstance->Parent);
+
+	for (const FScalarParameterValue& Parameter : MaterialInstance->ScalarParameterValues)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Parameter.ParameterInfo.Name), GetTypeHash(Parameter.ParameterValue)));
+	}
+
+	for (const FVectorParameterValue& Parameter : MaterialInstance->VectorParameterValues)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Parameter.ParameterInfo.Name), GetTypeHash(Parameter.ParameterValue)));
+	}
+
+	for (const FTextureParameterValue& Parameter : MaterialInstance->TextureParameterValues)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Parameter.ParameterInfo.Name), PointerHash(Parameter.ParameterValue)));
+	}
+
+	return Hash;
+}
@@ -2,8 +2,50 @@
 
 
 #include "System/NauseaAssetManager.h"
+#include "System/MapDataAsset.h"
+#include "Character/Customization/CustomizationObject.h"
 
 void UNauseaAssetManager::StartInitialLoading()
 {
 	Super::StartInitialLoading();
-}
\ No newline at end of file
+}
+
+template<typename AssetType, typename EntryType>
+void BuildAssetIndex(const UAssetManager& AssetManager, const FPrimaryAssetType& PrimaryAssetType, TArray<EntryType>& OutIndex)
+{
+	TArray<FAssetData> AssetDataList;
+	AssetManager.GetPrimaryAssetDataList(PrimaryAssetType, AssetDataList);
+
+	OutIndex.Reset(AssetDataList.Num());
+
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		EntryType& Entry = OutIndex.AddDefaulted_GetRef();
+		Entry.AssetId = AssetManager.GetPrimaryAssetIdForData(AssetData);
+
+		if (AssetType::ReadIndexEntry(AssetData, Entry))
+		{
+			continue;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("BuildAssetIndex loaded %s to index it because it is missing its asset registry tags. Resave the asset to avoid this."), *AssetData.ObjectPath.ToString());
+
+		if (const AssetType* Asset = Cast<AssetType>(AssetData.GetAsset()))
+		{
+			Asset->GetIndexEntry(Entry);
+			continue;
+		}
+
+		OutIndex.Pop(false);
+	}
+}
+
+void UNauseaAssetManager::GetMapDataIndex(TArray<FMapDataIndexEntry>& OutIndex) const
+{
+	BuildAssetIndex<UMapDataAsset>(*this, UMapDataAsset::MapDataAssetType, OutIndex);
+}
+
+void UNauseaAssetManager::GetCustomizationIndex(TArray<FCustomizationIndexEntry>& OutIndex) const
+{
+	BuildAssetIndex<UCustomizationAsset>(*this, UCustomizationAsset::CustomizationAssetType, OutIndex);
+}
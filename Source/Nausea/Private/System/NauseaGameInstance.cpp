@@ -6,6 +6,8 @@
 #include "System/NauseaWorldSettings.h"
 #include "System/MapDataAsset.h"
 #include "System/MeshMergeTypes.h"
+#include "System/CustomizationStreamingManager.h"
+#include "System/HordeStressTestManager.h"
 #include "Character/Customization/CustomizationObject.h"
 
 UNauseaGameInstance::UNauseaGameInstance(const FObjectInitializer& ObjectInitializer)
@@ -13,35 +15,168 @@ UNauseaGameInstance::UNauseaGameInstance(const FObjectInitializer& ObjectInitial
 {
 #if !UE_SERVER
 	CustomizationManager = CreateDefaultSubobject<UCustomizationMergeManager>(TEXT("CustomizationMergeManager"));
+	CustomizationStreamingManager = CreateDefaultSubobject<UCustomizationStreamingManager>(TEXT("CustomizationStreamingManager"));
 #endif //!UE_SERVER
 }
 
+inline UNauseaGameInstance* GetNauseaGameInstance(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	return World->GetGameInstance<UNauseaGameInstance>();
+}
+
 void UNauseaGameInstance::Init()
 {
 	Super::OnStart();
 
-	bIsMapDataListReady = true;
-	LoadMapDataList(true);
-	bIsCustomizationObjectListReady = true;
-	LoadCustomizationList(true);
+	BuildAssetIndices();
+
+	if (UHordeStressTestManager::IsStressTestRequested())
+	{
+		HordeStressTestManager = NewObject<UHordeStressTestManager>(this, TEXT("HordeStressTestManager"));
+		HordeStressTestManager->StartStressTest();
+	}
 }
 
 void UNauseaGameInstance::Shutdown()
 {
 	MapDataAssetMap.Empty();
 	PendingMapDataAssetList.Empty();
+	MapDataIndex.Empty();
+	MapDataIndexLookup.Empty();
+	CustomizationIndex.Empty();
 
 	Super::Shutdown();
 }
 
+void UNauseaGameInstance::BuildAssetIndices()
+{
+	UNauseaAssetManager* AssetManager = Cast<UNauseaAssetManager>(UAssetManager::GetIfValid());
+
+	if (!AssetManager)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UNauseaGameInstance::BuildAssetIndices failed to build asset indices due to missing asset manager."));
+		return;
+	}
+
+	AssetManager->GetMapDataIndex(MapDataIndex);
+
+	MapDataIndexLookup.Reset();
+	MapDataIndexLookup.Reserve(MapDataIndex.Num());
+	for (int32 Index = 0; Index < MapDataIndex.Num(); Index++)
+	{
+		MapDataIndexLookup.Add(MapDataIndex[Index].MapAsset.ToSoftObjectPath(), Index);
+	}
+
+	AssetManager->GetCustomizationIndex(CustomizationIndex);
+}
+
+const FMapDataIndexEntry* UNauseaGameInstance::FindMapDataIndexEntry(const TSoftObjectPtr<UWorld>& World) const
+{
+	const int32* Index = MapDataIndexLookup.Find(World.ToSoftObjectPath());
+	return Index ? &MapDataIndex[*Index] : nullptr;
+}
+
+TSharedPtr<FStreamableHandle> UNauseaGameInstance::RequestMapDataAssets(const TArray<FPrimaryAssetId>& AssetIdList, bool bHighPriority, FSimpleDelegate&& Delegate)
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfValid();
+
+	if (!AssetManager || AssetIdList.Num() == 0)
+	{
+		Delegate.ExecuteIfBound();
+		return nullptr;
+	}
+
+	TArray<FName> Bundles;
+	Bundles.Add(FName("Game"));
+
+	auto MapDataLoadComplete = [this, AssetIdList, Delegate = MoveTemp(Delegate)]()
+	{
+		if (UAssetManager* AssetManager = UAssetManager::GetIfValid())
+		{
+			for (const FPrimaryAssetId& AssetId : AssetIdList)
+			{
+				if (UMapDataAsset* LoadedMapData = AssetManager->GetPrimaryAssetObject<UMapDataAsset>(AssetId))
+				{
+					MapDataAssetMap.FindOrAdd(LoadedMapData->GetMapAsset()) = LoadedMapData;
+				}
+			}
+		}
+
+		Delegate.ExecuteIfBound();
+	};
+
+	return AssetManager->LoadPrimaryAssets(AssetIdList, Bundles, FStreamableDelegate::CreateWeakLambda(this, MapDataLoadComplete),
+		bHighPriority ? FStreamableManager::AsyncLoadHighPriority : FStreamableManager::DefaultAsyncLoadPriority);
+}
+
+const TArray<FMapDataIndexEntry>& UNauseaGameInstance::GetMapDataIndex(const UObject* WorldContextObject)
+{
+	static const TArray<FMapDataIndexEntry> InvalidMapDataIndex = TArray<FMapDataIndexEntry>();
+
+	UNauseaGameInstance* NauseaGameInstance = GetNauseaGameInstance(WorldContextObject);
+
+	if (!NauseaGameInstance)
+	{
+		return InvalidMapDataIndex;
+	}
+
+	return NauseaGameInstance->MapDataIndex;
+}
+
+FCustomizationStreamHandle UNauseaGameInstance::RequestCustomizationAssets(const UObject* Requester, const TArray<FPrimaryAssetId>& AssetIdList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate)
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfValid();
+
+	if (!AssetManager)
+	{
+		return FCustomizationStreamHandle();
+	}
+
+	TArray<FSoftObjectPath> AssetPathList;
+	AssetPathList.Reserve(AssetIdList.Num());
+	for (const FPrimaryAssetId& AssetId : AssetIdList)
+	{
+		const FSoftObjectPath AssetPath = AssetManager->GetPrimaryAssetPath(AssetId);
+
+		if (AssetPath.IsValid())
+		{
+			AssetPathList.Add(AssetPath);
+		}
+	}
+
+	return UCustomizationStreamingManager::RequestLoad(this, Requester, AssetPathList, Priority, MoveTemp(Delegate));
+}
+
+const TArray<FCustomizationIndexEntry>& UNauseaGameInstance::GetCustomizationIndex(const UObject* WorldContextObject)
+{
+	static const TArray<FCustomizationIndexEntry> InvalidCustomizationIndex = TArray<FCustomizationIndexEntry>();
+
+	UNauseaGameInstance* NauseaGameInstance = GetNauseaGameInstance(WorldContextObject);
+
+	if (!NauseaGameInstance)
+	{
+		return InvalidCustomizationIndex;
+	}
+
+	return NauseaGameInstance->CustomizationIndex;
+}
+
 bool UNauseaGameInstance::LoadMapDataList(bool bImmediate)
 {
-	if (!bIsMapDataListReady)
+	if (bIsMapDataListLoading)
 	{
 		return false;
 	}
 
 	bIsMapDataListReady = false;
+	bIsMapDataListLoading = true;
 	MapDataAssetMap.Empty(MapDataAssetMap.Num());
 
 	UNauseaAssetManager* AssetManager = Cast<UNauseaAssetManager>(UAssetManager::GetIfValid());
@@ -55,6 +190,12 @@ bool UNauseaGameInstance::LoadMapDataList(bool bImmediate)
 	TArray<FPrimaryAssetId> MapDataAssetIdList;
 	AssetManager->GetPrimaryAssetIdList(UMapDataAsset::MapDataAssetType, MapDataAssetIdList);
 
+	if (MapDataAssetIdList.Num() == 0)
+	{
+		CheckMapDataListLoadComplete();
+		return true;
+	}
+
 	TArray<FName> Bundles;
 	Bundles.Add(FName("Game"));
 
@@ -113,29 +254,31 @@ bool UNauseaGameInstance::LoadMapDataList(bool bImmediate)
 	return true;
 }
 
-UMapDataAsset* UNauseaGameInstance::GetMapDataAsset(TSoftObjectPtr<UWorld> World) const
+UMapDataAsset* UNauseaGameInstance::GetMapDataAsset(TSoftObjectPtr<UWorld> World)
 {
-	if (MapDataAssetMap.Contains(World))
+	if (UMapDataAsset* const* MapDataAsset = MapDataAssetMap.Find(World))
 	{
-		return MapDataAssetMap[World];
+		return *MapDataAsset;
 	}
 
-	return nullptr;
-}
+	const FMapDataIndexEntry* IndexEntry = FindMapDataIndexEntry(World);
 
-inline UNauseaGameInstance* GetNauseaGameInstance(const UObject* WorldContextObject)
-{
-	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
-
-	if (!World)
+	if (!IndexEntry)
 	{
 		return nullptr;
 	}
 
-	return World->GetGameInstance<UNauseaGameInstance>();
+	UMapDataAsset* MapDataAsset = IndexEntry->MapDataAsset.LoadSynchronous();
+
+	if (MapDataAsset)
+	{
+		MapDataAssetMap.Add(World, MapDataAsset);
+	}
+
+	return MapDataAsset;
 }
 
-UMapDataAsset* UNauseaGameInstance::GetMapDataAssetForCurrentWorld() const
+UMapDataAsset* UNauseaGameInstance::GetMapDataAssetForCurrentWorld()
 {
 	if (!GetWorld())
 	{
@@ -212,12 +355,13 @@ UMapDataAsset* UNauseaGameInstance::GetMapDataAsset(const UObject* WorldContextO
 
 bool UNauseaGameInstance::LoadCustomizationList(bool bImmediate)
 {
-	if (!bIsCustomizationObjectListReady)
+	if (bIsCustomizationObjectListLoading)
 	{
 		return false;
 	}
 
 	bIsCustomizationObjectListReady = false;
+	bIsCustomizationObjectListLoading = true;
 	CustomizationObjectList.Reset();
 
 	UNauseaAssetManager* AssetManager = Cast<UNauseaAssetManager>(UAssetManager::GetIfValid());
@@ -232,6 +376,12 @@ bool UNauseaGameInstance::LoadCustomizationList(bool bImmediate)
 
 	AssetManager->GetPrimaryAssetIdList(UCustomizationAsset::CustomizationAssetType, CustomizationObjectAssetList);
 
+	if (CustomizationObjectAssetList.Num() == 0)
+	{
+		CheckCustomizationObjectListLoadComplete();
+		return true;
+	}
+
 	TArray<FName> Bundles;
 	Bundles.Add(FName("Game"));
 
@@ -298,6 +448,7 @@ void UNauseaGameInstance::CheckMapDataListLoadComplete()
 	}
 
 	bIsMapDataListReady = true;
+	bIsMapDataListLoading = false;
 
 	TArray<UMapDataAsset*> MapDataAssetList;
 	MapDataAssetMap.GenerateValueArray(MapDataAssetList);
@@ -306,12 +457,13 @@ void UNauseaGameInstance::CheckMapDataListLoadComplete()
 
 void UNauseaGameInstance::CheckCustomizationObjectListLoadComplete()
 {
-	if (PendingMapDataAssetList.Num() != 0)
+	if (PendingCustomizationObjectAssetList.Num() != 0)
 	{
 		return;
 	}
 
 	bIsCustomizationObjectListReady = true;
+	bIsCustomizationObjectListLoading = false;
 	OnCustomizationObjectListReady.Broadcast(this, CustomizationObjectList);
 }
 
@@ -330,6 +482,12 @@ void UMapLoadAsyncAction::Activate()
 		return;
 	}
 
+	if (RequestedAssetIdList.Num() > 0)
+	{
+		StreamableHandle = OwningGameInstance->RequestMapDataAssets(RequestedAssetIdList, true, FSimpleDelegate::CreateUObject(this, &UMapLoadAsyncAction::OnMapDataAssetsLoaded));
+		return;
+	}
+
 	if (OwningGameInstance->IsMapDataListReady())
 	{
 		SetReadyToDestroy();
@@ -344,11 +502,42 @@ void UMapLoadAsyncAction::Activate()
 
 void UMapLoadAsyncAction::SetReadyToDestroy()
 {
-	OwningGameInstance->OnMapDataAssetListReady.RemoveDynamic(this, &UMapLoadAsyncAction::OnMapLoadRequestComplete);
+	if (OwningGameInstance.IsValid())
+	{
+		OwningGameInstance->OnMapDataAssetListReady.RemoveDynamic(this, &UMapLoadAsyncAction::OnMapLoadRequestComplete);
+	}
+
+	StreamableHandle.Reset();
 	Super::SetReadyToDestroy();
 }
 
 UMapLoadAsyncAction* UMapLoadAsyncAction::RequestMapList(const UObject* WorldContextObject)
+{
+	return CreateAction(WorldContextObject);
+}
+
+UMapLoadAsyncAction* UMapLoadAsyncAction::RequestMapDataAssets(const UObject* WorldContextObject, const TArray<FMapDataIndexEntry>& EntryList)
+{
+	UMapLoadAsyncAction* AsyncAction = CreateAction(WorldContextObject);
+
+	if (!AsyncAction)
+	{
+		return nullptr;
+	}
+
+	AsyncAction->RequestedAssetIdList.Reserve(EntryList.Num());
+	for (const FMapDataIndexEntry& Entry : EntryList)
+	{
+		if (Entry.AssetId.IsValid())
+		{
+			AsyncAction->RequestedAssetIdList.Add(Entry.AssetId);
+		}
+	}
+
+	return AsyncAction;
+}
+
+UMapLoadAsyncAction* UMapLoadAsyncAction::CreateAction(const UObject* WorldContextObject)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
 
@@ -377,6 +566,12 @@ UMapLoadAsyncAction* UMapLoadAsyncAction::RequestMapList(const UObject* WorldCon
 }
 
 void UMapLoadAsyncAction::OnMapLoadRequestComplete(UNauseaGameInstance* NauseaGameInstance, const TArray<UMapDataAsset*>& MapDataAssetList)
+{
+	OnMapDataListLoaded.Broadcast(true);
+	SetReadyToDestroy();
+}
+
+void UMapLoadAsyncAction::OnMapDataAssetsLoaded()
 {
 	OnMapDataListLoaded.Broadcast(true);
 	SetReadyToDestroy();
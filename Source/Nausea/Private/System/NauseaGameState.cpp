@@ -84,6 +84,7 @@ void ANauseaGameState::InitializeGameState(ACoreGameMode* CoreGameMode)
 		PlayerClassList.Add(PlayerClass);
 	}
 	PlayerClassList.Shrink();
+	UPlayerClassComponent::BuildPlayerClassRecords(PlayerClassList);
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ACoreGameState, PlayerClassList, this);
 }
@@ -0,0 +1,195 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+
+#include "System/WaveContentPreloader.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/Pawn.h"
+#include "System/CoreGameState.h"
+#include "Gameplay/Ability/AbilityContentManager.h"
+#include "Character/CoreCharacterAnimInstanceTypes.h"
+
+DEFINE_LOG_CATEGORY(LogWaveContentPreloader);
+
+int32 UWaveContentPreloader::SynchronousLoadCount = 0;
+
+UWaveContentPreloader::UWaveContentPreloader(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+
+}
+
+void UWaveContentPreloader::BeginDestroy()
+{
+	for (FWaveContentPreloadRequest& Request : PreloadRequestList)
+	{
+		if (Request.Handle.IsValid())
+		{
+			Request.Handle->CancelHandle();
+		}
+	}
+
+	PreloadRequestList.Empty();
+
+	Super::BeginDestroy();
+}
+
+inline UWaveContentPreloader* GetWaveContentPreloader(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ACoreGameState* CoreGameState = World->GetGameState<ACoreGameState>();
+
+	if (!CoreGameState)
+	{
+		return nullptr;
+	}
+
+	return CoreGameState->GetWaveContentPreloader();
+}
+
+bool UWaveContentPreloader::RequestPreload(const UObject* WorldContextObject, const UObject* Requester, int64 WaveNumber, const TArray<FSoftObjectPath>& AssetList)
+{
+	if (!Requester || AssetList.Num() == 0)
+	{
+		return false;
+	}
+
+	UWaveContentPreloader* WaveContentPreloader = GetWaveContentPreloader(WorldContextObject);
+
+	if (!WaveContentPreloader)
+	{
+		return false;
+	}
+
+	return WaveContentPreloader->AddRequest(Requester, WaveNumber, AssetList);
+}
+
+int32 UWaveContentPreloader::ReleasePreloadsBefore(const UObject* WorldContextObject, const UObject* Requester, int64 WaveNumber)
+{
+	UWaveContentPreloader* WaveContentPreloader = GetWaveContentPreloader(WorldContextObject);
+
+	if (!WaveContentPreloader)
+	{
+		return 0;
+	}
+
+	return WaveContentPreloader->ReleaseRequests(Requester, WaveNumber);
+}
+
+int32 UWaveContentPreloader::ReleaseAllPreloads(const UObject* WorldContextObject, const UObject* Requester)
+{
+	UWaveContentPreloader* WaveContentPreloader = GetWaveContentPreloader(WorldContextObject);
+
+	if (!WaveContentPreloader)
+	{
+		return 0;
+	}
+
+	return WaveContentPreloader->ReleaseRequests(Requester, MAX_int64);
+}
+
+UClass* UWaveContentPreloader::LoadClassSynchronous(const FSoftObjectPath& ClassPath)
+{
+	SynchronousLoadCount++;
+	UE_LOG(LogWaveContentPreloader, Warning, TEXT("Wave content %s was not preloaded and is being loaded synchronously (%i synchronous loads so far)."), *ClassPath.ToString(), SynchronousLoadCount);
+	return Cast<UClass>(ClassPath.TryLoad());
+}
+
+bool UWaveContentPreloader::AddRequest(const UObject* Requester, int64 WaveNumber, const TArray<FSoftObjectPath>& AssetList)
+{
+	for (const FWaveContentPreloadRequest& Request : PreloadRequestList)
+	{
+		if (Request.Requester == Requester && Request.WaveNumber == WaveNumber)
+		{
+			return true;
+		}
+	}
+
+	//Waves commonly share characters across spawn groups so strip duplicates before handing the list off.
+	TArray<FSoftObjectPath> PendingAssetList;
+	PendingAssetList.Reserve(AssetList.Num());
+	for (const FSoftObjectPath& AssetPath : AssetList)
+	{
+		if (AssetPath.IsNull())
+		{
+			continue;
+		}
+
+		PendingAssetList.AddUnique(AssetPath);
+	}
+
+	if (PendingAssetList.Num() == 0)
+	{
+		return false;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PendingAssetList), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	//Ability content is soft referenced by abilities so it can only be queued once we know which characters (and therefore abilities) the wave uses.
+	TWeakPtr<FStreamableHandle> WeakHandle = Handle;
+	auto PreloadCompleteDelegate = [this, WeakHandle]
+	{
+		if (WeakHandle.IsValid())
+		{
+			OnPreloadComplete(WeakHandle.Pin());
+		}
+	};
+
+	if (Handle->HasLoadCompleted())
+	{
+		OnPreloadComplete(Handle);
+	}
+	else
+	{
+		Handle->BindCompleteDelegate(FStreamableDelegate::CreateWeakLambda(this, PreloadCompleteDelegate));
+	}
+
+	PreloadRequestList.Emplace(Requester, WaveNumber, Handle);
+	return true;
+}
+
+void UWaveContentPreloader::OnPreloadComplete(TSharedPtr<FStreamableHandle> Handle)
+{
+	TArray<UObject*> LoadedAssetList;
+	Handle->GetLoadedAssets(LoadedAssetList);
+
+	for (UObject* LoadedAsset : LoadedAssetList)
+	{
+		UClass* LoadedClass = Cast<UClass>(LoadedAsset);
+
+		if (LoadedClass && LoadedClass->IsChildOf<APawn>())
+		{
+			UAbilityContentManager::PreloadCharacterAbilities(this, LoadedClass);
+			UAnimationObject::PrepareCharacterAnimationContent(LoadedClass);
+		}
+	}
+}
+
+int32 UWaveContentPreloader::ReleaseRequests(const UObject* Requester, int64 WaveNumber)
+{
+	const int32 InitialCount = PreloadRequestList.Num();
+
+	//Requests whose requester has been destroyed are released as well.
+	PreloadRequestList.RemoveAllSwap([Requester, WaveNumber](const FWaveContentPreloadRequest& Request)
+	{
+		if (!Request.Requester.IsValid())
+		{
+			return true;
+		}
+
+		return Request.Requester == Requester && Request.WaveNumber < WaveNumber;
+	});
+
+	return InitialCount - PreloadRequestList.Num();
+}
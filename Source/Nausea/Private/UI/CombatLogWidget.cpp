@@ -9,28 +9,36 @@
 #include "Gameplay/DamageLogInterface.h"
 #include "Character/CombatHistoryComponent.h"
 
-bool FCombatLog::FadeOut(float DeltaTime)
+bool FCombatLog::CanMergeWith(const FDamageLogEvent& Other) const
 {
-	if (WidgetList.Num() == 0)
+	if (LifeTime <= 0.f || DamageLogEvent.IsDeathEvent() || Other.IsDeathEvent())
 	{
-		return true;
+		return false;
 	}
 
-	bool bAllFadedOut = true;
-	for (UWidget* Widget : WidgetList)
-	{
-		if (!Widget)
-		{
-			continue;
-		}
+	return DamageLogEvent.Instigator == Other.Instigator
+		&& DamageLogEvent.InstigatorWeaponClass == Other.InstigatorWeaponClass
+		&& DamageLogEvent.InstigatorDamageType == Other.InstigatorDamageType;
+}
 
-		const float Opacity = FMath::Clamp(Widget->GetRenderOpacity() - (DeltaTime * 2.f), 0.f, 1.f);
-		Widget->SetRenderOpacity(Opacity);
+void FCombatLog::MergeWith(const FDamageLogEvent& Other)
+{
+	DamageLogEvent.CombineWithEvent(Other);
+	LifeTime = 1.f;
+	Opacity = 1.f;
+}
 
-		bAllFadedOut &= (Opacity == 0.f);
+void FCombatLogRow::SetOpacity(float Opacity)
+{
+	if (EventTextBlock)
+	{
+		EventTextBlock->SetRenderOpacity(Opacity);
 	}
 
-	return bAllFadedOut;
+	for (UTextBlock* ModifierTextBlock : ModifierTextBlockList)
+	{
+		ModifierTextBlock->SetRenderOpacity(Opacity);
+	}
 }
 
 UCombatLogWidget::UCombatLogWidget(const FObjectInitializer& ObjectInitializer)
@@ -43,44 +51,30 @@ void UCombatLogWidget::NativeOnInitialized()
 {
 	VerticalBox = WidgetTree->ConstructWidget<UVerticalBox>();
 	WidgetTree->RootWidget = VerticalBox;
-	Super::NativeOnInitialized();
-}
 
-void UCombatLogWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
-{
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	int32 Index = 0;
-	while (Index < CombatLogList.Num())
+	//Build the entire row pool up front so that receiving events never constructs or reparents widgets.
+	RowList.SetNum(GetEntryLimit());
+	for (FCombatLogRow& Row : RowList)
 	{
-		if (CombatLogList[Index].TickLifeTime(InDeltaTime))
+		Row.EventTextBlock = CreateTextBlock(EventFont);
+
+		for (int32 Index = 0; Index < MaxModifierLineCount; Index++)
 		{
-			if (CombatLogList[Index].FadeOut(InDeltaTime))
-			{
-				AddToCombatLogPool(CombatLogList[Index]);
-				CombatLogList.RemoveAt(Index, 1, false);
-			}
+			Row.ModifierTextBlockList.Add(CreateTextBlock(ModifierFont));
 		}
-
-		Index++;
 	}
 
-	if (CombatLogList.Num() <= GetVisibleEntries())
-	{
-		return;
-	}
+	Super::NativeOnInitialized();
+}
 
-	Index = 0;
-	while (Index < CombatLogList.Num() - GetVisibleEntries())
+void UCombatLogWidget::NativeDestruct()
+{
+	if (UWorld* World = GetWorld())
 	{
-		if (CombatLogList[Index].FadeOut(InDeltaTime))
-		{
-			AddToCombatLogPool(CombatLogList[Index]);
-			CombatLogList.RemoveAt(Index, 1, false);
-		}
-
-		Index++;
+		World->GetTimerManager().ClearTimer(CombatLogUpdateTimer);
 	}
+
+	Super::NativeDestruct();
 }
 
 void UCombatLogWidget::BindToCombatHistoryComponent(UCombatHistoryComponent* CombatHistoryComponent)
@@ -105,41 +99,58 @@ void UCombatLogWidget::UnbindToCombatHistoryComponent(UCombatHistoryComponent* C
 
 void UCombatLogWidget::OnReceivedDamageLogEvent(UCombatHistoryComponent* Component, const FDamageLogEvent& DamageLogEvent)
 {
-	if (!WidgetTree || !VerticalBox)
+	if (!VerticalBox || RowList.Num() == 0)
 	{
 		return;
 	}
 
-	const FText EventLogText = UDamageLogStatics::GenerateDamageLogEventText(DamageLogEvent);
-
-	//If we've hit entry limit, immediately get rid of top-most entry and return it to the pool so we can use it.
-	if (CombatLogList.Num() != 0 && CombatLogList.Num() >= GetEntryLimit())
+	//Merge with a live entry from the same source and move it to the bottom of the log.
+	for (int32 Index = CombatLogList.Num() - 1; Index >= 0; Index--)
 	{
-		AddToCombatLogPool(CombatLogList[0]);
-		CombatLogList.RemoveAt(0, 1, false);
+		if (!CombatLogList[Index].CanMergeWith(DamageLogEvent))
+		{
+			continue;
+		}
+
+		FCombatLog MergedCombatLog = MoveTemp(CombatLogList[Index]);
+		CombatLogList.RemoveAt(Index, 1, false);
+
+		MergedCombatLog.MergeWith(DamageLogEvent);
+		MergedCombatLog.EventText = UDamageLogStatics::GenerateDamageLogEventText(MergedCombatLog.DamageLogEvent);
+		CombatLogList.Add(MoveTemp(MergedCombatLog));
+
+		RefreshRows();
+		UpdateCombatLogTimer();
+		return;
 	}
 
+	const FText EventLogText = UDamageLogStatics::GenerateDamageLogEventText(DamageLogEvent);
+
 	if (EventLogText.IsEmpty())
 	{
 		return;
 	}
 
-	UTextBlock* EventText = CreateTextBlock();
-	EventText->SetFont(EventFont);
-	EventText->SetText(EventLogText);
-
-	CombatLogList.Push(FCombatLog(EventText, DamageLogEvent.ModifierList.Num()));
+	//If we've hit entry limit, immediately get rid of top-most entry so its row can be reused.
+	if (CombatLogList.Num() != 0 && CombatLogList.Num() >= RowList.Num())
+	{
+		CombatLogList.RemoveAt(0, 1, false);
+	}
 
-	UVerticalBoxSlot* EventSlot = VerticalBox->AddChildToVerticalBox(EventText);
-	EventSlot->SetHorizontalAlignment(HAlign_Right);
-	EventSlot->SetVerticalAlignment(VAlign_Bottom);
+	FCombatLog& CombatLog = CombatLogList.Add_GetRef(FCombatLog(DamageLogEvent));
+	CombatLog.EventText = EventLogText;
 
-	if (IsVerbose() && DamageLogEvent.ModifierList.Num() > 0)
+	if (IsVerbose())
 	{
-		FCombatLog& CombatLogWidget = CombatLogList.Last();
+		CombatLog.ModifierTextList.Reserve(FMath::Min(DamageLogEvent.ModifierList.Num(), MaxModifierLineCount));
 
 		for (const FDamageLogEventModifier& Modifier : DamageLogEvent.ModifierList)
 		{
+			if (CombatLog.ModifierTextList.Num() >= MaxModifierLineCount)
+			{
+				break;
+			}
+
 			const FText ModifierLogText = UDamageLogStatics::GenerateDamageLogEventModifierText(Modifier);
 
 			if (ModifierLogText.IsEmpty())
@@ -147,51 +158,128 @@ void UCombatLogWidget::OnReceivedDamageLogEvent(UCombatHistoryComponent* Compone
 				continue;
 			}
 
-			UTextBlock* ModifierText = CreateTextBlock();
-			ModifierText->SetFont(ModifierFont);
-			ModifierText->SetText(ModifierLogText);
-
-			UVerticalBoxSlot* ModifierSlot = VerticalBox->AddChildToVerticalBox(ModifierText);
-			ModifierSlot->SetHorizontalAlignment(HAlign_Right);
-			ModifierSlot->SetVerticalAlignment(VAlign_Bottom);
-			Invalidate(EInvalidateWidgetReason::Layout);
-
-			CombatLogWidget.AddSubWidget(ModifierText);
+			CombatLog.ModifierTextList.Add(ModifierLogText);
 		}
 	}
+
+	RefreshRows();
+	UpdateCombatLogTimer();
 }
 
-UTextBlock* UCombatLogWidget::CreateTextBlock()
+UTextBlock* UCombatLogWidget::CreateTextBlock(const FSlateFontInfo& Font)
 {
-	if (!WidgetTree)
+	if (!WidgetTree || !VerticalBox)
 	{
 		return nullptr;
 	}
 
-	if (TextBlockPool.Num() != 0)
+	UTextBlock* TextBlock = WidgetTree->ConstructWidget<UTextBlock>();
+	TextBlock->SetFont(Font);
+	TextBlock->SetVisibility(ESlateVisibility::Collapsed);
+
+	UVerticalBoxSlot* TextSlot = VerticalBox->AddChildToVerticalBox(TextBlock);
+	TextSlot->SetHorizontalAlignment(HAlign_Right);
+	TextSlot->SetVerticalAlignment(VAlign_Bottom);
+	return TextBlock;
+}
+
+void UCombatLogWidget::UpdateCombatLog()
+{
+	const float DeltaTime = UpdateInterval;
+	const int32 VisibleEntryCount = GetVisibleEntries();
+	bool bRemovedEntry = false;
+
+	//Entries past their lifetime, or pushed out of the visible entry count, fade out and are removed once fully transparent.
+	for (int32 Index = 0; Index < CombatLogList.Num();)
 	{
-		UTextBlock* TextBlock = TextBlockPool.Pop(false);
-		TextBlock->SetRenderOpacity(1.f);
+		FCombatLog& CombatLog = CombatLogList[Index];
+		const bool bOverflowing = Index < CombatLogList.Num() - VisibleEntryCount;
+
+		if ((CombatLog.TickLifeTime(DeltaTime) || bOverflowing) && CombatLog.FadeOut(DeltaTime))
+		{
+			CombatLogList.RemoveAt(Index, 1, false);
+			bRemovedEntry = true;
+			continue;
+		}
+
+		Index++;
 	}
 
-	UTextBlock* TextBlock = WidgetTree->ConstructWidget<UTextBlock>();
-	return TextBlock;
+	if (bRemovedEntry)
+	{
+		RefreshRows();
+	}
+	else
+	{
+		for (int32 Index = 0; Index < CombatLogList.Num(); Index++)
+		{
+			RowList[GetRowIndexForEntry(Index)].SetOpacity(CombatLogList[Index].GetOpacity());
+		}
+	}
+
+	UpdateCombatLogTimer();
 }
 
-void UCombatLogWidget::AddToCombatLogPool(FCombatLog& CombatLog)
+void UCombatLogWidget::RefreshRows()
 {
-	TArray<UTextBlock*>& WidgetList = CombatLog.GetWidgetList();
+	const bool bVerbose = IsVerbose();
 
-	if (WidgetList.Num() == 0)
+	for (int32 RowIndex = 0; RowIndex < RowList.Num(); RowIndex++)
+	{
+		FCombatLogRow& Row = RowList[RowIndex];
+		const int32 EntryIndex = RowIndex - (RowList.Num() - CombatLogList.Num());
+
+		if (!CombatLogList.IsValidIndex(EntryIndex))
+		{
+			Row.EventTextBlock->SetVisibility(ESlateVisibility::Collapsed);
+			for (UTextBlock* ModifierTextBlock : Row.ModifierTextBlockList)
+			{
+				ModifierTextBlock->SetVisibility(ESlateVisibility::Collapsed);
+			}
+			continue;
+		}
+
+		const FCombatLog& CombatLog = CombatLogList[EntryIndex];
+		Row.EventTextBlock->SetText(CombatLog.EventText);
+		Row.EventTextBlock->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+		for (int32 ModifierIndex = 0; ModifierIndex < Row.ModifierTextBlockList.Num(); ModifierIndex++)
+		{
+			UTextBlock* ModifierTextBlock = Row.ModifierTextBlockList[ModifierIndex];
+
+			if (!bVerbose || !CombatLog.ModifierTextList.IsValidIndex(ModifierIndex))
+			{
+				ModifierTextBlock->SetVisibility(ESlateVisibility::Collapsed);
+				continue;
+			}
+
+			ModifierTextBlock->SetText(CombatLog.ModifierTextList[ModifierIndex]);
+			ModifierTextBlock->SetVisibility(ESlateVisibility::HitTestInvisible);
+		}
+
+		Row.SetOpacity(CombatLog.GetOpacity());
+	}
+}
+
+void UCombatLogWidget::UpdateCombatLogTimer()
+{
+	UWorld* World = GetWorld();
+
+	if (!World)
 	{
 		return;
 	}
 
-	for (UTextBlock* Widget : WidgetList)
+	FTimerManager& TimerManager = World->GetTimerManager();
+
+	if (CombatLogList.Num() == 0)
 	{
-		TextBlockPool.Add(Widget);
-		VerticalBox->RemoveChild(Widget);
+		TimerManager.ClearTimer(CombatLogUpdateTimer);
+		return;
 	}
 
-	WidgetList.Empty();
-}
\ No newline at end of file
+	if (!TimerManager.IsTimerActive(CombatLogUpdateTimer))
+	{
+		TimerManager.SetTimer(CombatLogUpdateTimer, FTimerDelegate::CreateUObject(this, &UCombatLogWidget::UpdateCombatLog), UpdateInterval, true);
+	}
+}
@@ -145,6 +145,7 @@ void UAmmo::UpdateAmmoCapacity(bool bFirstInitialization)
 	float ModifiedAmmoCapacity = GetDefaultObject()->MaxAmmoAmount;
 	if (UPlayerClassComponent* PlayerClassComponent = GetOwningFireMode()->GetPlayerClassComponent())
 	{
+		ModifiedAmmoCapacity *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::AmmoCapacity, this);
 		PlayerClassComponent->OnProcessAmmoCapacity.Broadcast(GetOwningWeapon(), this, ModifiedAmmoCapacity);
 	}
 
@@ -267,6 +267,7 @@ void ULoadedAmmo::UpdateAmmoCapacity(bool bFirstInitialization)
 	float ModifiedLoadedAmmoCapacity = Cast<ULoadedAmmo>(GetDefaultObject())->MaxLoadedAmmoAmount;
 	if (UPlayerClassComponent* PlayerClassComponent = GetOwningFireMode()->GetPlayerClassComponent())
 	{
+		ModifiedLoadedAmmoCapacity *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::LoadedAmmoCapacity, this);
 		PlayerClassComponent->OnProcessLoadedAmmoCapacity.Broadcast(GetOwningWeapon(), this, ModifiedLoadedAmmoCapacity);
 	}
 	MaxLoadedAmmoAmount = FMath::FloorToInt(ModifiedLoadedAmmoCapacity);
@@ -307,6 +308,7 @@ float ULoadedAmmo::GetReloadRate() const
 	float ModifiedReloadRate = ReloadRate;
 	if (UPlayerClassComponent* PlayerClassComponent = GetOwningFireMode()->GetPlayerClassComponent())
 	{
+		ModifiedReloadRate *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::ReloadRate, this);
 		PlayerClassComponent->OnProcessReloadRate.Broadcast(GetOwningWeapon(), this, ModifiedReloadRate);
 	}
 
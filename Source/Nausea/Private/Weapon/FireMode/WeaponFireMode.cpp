@@ -307,6 +307,7 @@ float UWeaponFireMode::GetFireRate() const
 	float ModifiedFireRate = FireRate;
 	if (UPlayerClassComponent* PlayerClassComponent = GetPlayerClassComponent())
 	{
+		ModifiedFireRate *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::FireRate, this);
 		PlayerClassComponent->OnProcessFireRate.Broadcast(GetOwningWeapon(), this, ModifiedFireRate);
 	}
 
@@ -15,6 +15,7 @@
 #include "Weapon/Inventory.h"
 #include "Weapon/Weapon.h"
 #include "Character/VoiceComponent.h"
+#include "Algo/BinarySearch.h"
 
 DEFINE_LOG_CATEGORY(LogInventoryManager);
 
@@ -22,6 +23,25 @@ DEFINE_LOG_CATEGORY(LogInventoryManager);
 #define LOG_WEAPON_STATE(WeaponVariable, Verbosity)\
 UE_LOG(LogInventoryManager, Verbosity, TEXT("    - " #WeaponVariable ": %s | State: %s | Pending Putdown: %s"), *GetNameSafe(WeaponVariable), *(WeaponVariable ? UWeapon::GetWeaponStateName(WeaponVariable->GetWeaponState()).ToString() : FString("None")), *(WeaponVariable && WeaponVariable->IsPendingPutDown() ? FString("true") : FString("false")));\
 
+//Orders weapons best first by rating, falling back to UWeapon::FSortByPriority for weapons of equal rating.
+struct FSortWeaponByRating
+{
+	bool operator()(const UWeapon* A, const UWeapon* B) const
+	{
+		if (!A || !B)
+		{
+			return A != nullptr;
+		}
+
+		if (A->GetWeaponRating() != B->GetWeaponRating())
+		{
+			return A->GetWeaponRating() > B->GetWeaponRating();
+		}
+
+		return UWeapon::FSortByPriority()(*A, *B);
+	}
+};
+
 UInventoryManagerComponent::UInventoryManagerComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -140,30 +160,22 @@ void UInventoryManagerComponent::OnPlayerClassChanged(ACorePlayerState* PlayerSt
 
 bool UInventoryManagerComponent::AddInventory(TSubclassOf<UInventory> InventoryClass, bool bDispatchOnRep)
 {
-	if (!InventoryClass)
+	if (!InventoryClass || InventoryClassMap.FindRef(InventoryClass))
 	{
 		return false;
 	}
 
-	for (UInventory* Inventory : InventoryList)
-	{
-		if (!Inventory)
-		{
-			continue;
-		}
-
-		if (Inventory->GetClass() == InventoryClass)
-		{
-			return false;
-		}
-	}
-
 	UInventory* Inventory = NewObject<UInventory>(GetOwner(), InventoryClass);
 
 	if (Inventory)
 	{
 		InventoryList.Add(Inventory);
 		Inventory->RegisterComponent();
+
+		TArray<EWeaponGroup> GroupUpdateList;
+		IndexInventory(Inventory, GroupUpdateList);
+		BroadcastGroupUpdates(GroupUpdateList);
+
 		GetOwner()->ForceNetUpdate();
 		if (bDispatchOnRep)
 		{
@@ -177,29 +189,28 @@ bool UInventoryManagerComponent::AddInventory(TSubclassOf<UInventory> InventoryC
 
 bool UInventoryManagerComponent::RemoveInventory(TSubclassOf<UInventory> InventoryClass, bool bDispatchOnRep)
 {
-	if (!InventoryClass)
+	UInventory* Inventory = InventoryClass ? InventoryClassMap.FindRef(InventoryClass) : nullptr;
+
+	if (!Inventory)
 	{
 		return false;
 	}
 
-	for (UInventory* Inventory : InventoryList)
-	{
-		if (!Inventory || Inventory->GetClass() == InventoryClass)
-		{
-			continue;
-		}
+	TArray<EWeaponGroup> GroupUpdateList;
+	UnindexInventory(Inventory, GroupUpdateList);
+	BroadcastGroupUpdates(GroupUpdateList);
 
-		Inventory->DestroyComponent();
-		if (bDispatchOnRep)
-		{
-			OnRep_InventoryList();
-			MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryManagerComponent, InventoryList, this);
-			GetOwner()->ForceNetUpdate();
-		}
-		return true;
+	InventoryList.Remove(Inventory);
+	Inventory->DestroyComponent();
+
+	if (bDispatchOnRep)
+	{
+		OnRep_InventoryList();
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryManagerComponent, InventoryList, this);
+		GetOwner()->ForceNetUpdate();
 	}
 
-	return false;
+	return true;
 }
 
 #define BIND_NEXT_WEAPON(Type)\
@@ -440,13 +451,8 @@ float UInventoryManagerComponent::GetMovementSpeedModifier() const
 
 UWeapon* UInventoryManagerComponent::GetNextBestWeapon() const
 {
-	float Rating = -MAX_FLT;
-	UWeapon* BestWeapon = nullptr;
-
-	for (UInventory* Inventory : InventoryList)
+	for (UWeapon* Weapon : BestWeaponList)
 	{
-		UWeapon* Weapon = Cast<UWeapon>(Inventory);
-
 		if (!Weapon || Weapon == GetCurrentWeapon())
 		{
 			continue;
@@ -457,20 +463,15 @@ UWeapon* UInventoryManagerComponent::GetNextBestWeapon() const
 			continue;
 		}
 
-		if (Rating > Weapon->GetWeaponRating())
-		{
-			continue;
-		}
-		
-		BestWeapon = Weapon;
+		return Weapon;
 	}
 
-	return BestWeapon;
+	return nullptr;
 }
 
 bool UInventoryManagerComponent::ContainsInventory(UInventory* Inventory) const
 {
-	return InventoryList.Contains(Inventory);
+	return Inventory && InventoryClassMap.FindRef(Inventory->GetClass()) == Inventory;
 }
 
 bool UInventoryManagerComponent::CanEquipWeapon(UWeapon* Weapon) const
@@ -913,10 +914,21 @@ void UInventoryManagerComponent::OnRep_InventoryList()
 		EquipInitialWeapon();
 	}
 
+	TArray<EWeaponGroup> GroupUpdateList;
+
+	//Unindex anything removed since the last update first so GetNextBestWeapon will not pick it.
+	for (UInventory* Inventory : PreviousInventoryList)
+	{
+		if (Inventory && !InventoryList.Contains(Inventory))
+		{
+			UnindexInventory(Inventory, GroupUpdateList);
+		}
+	}
+
 	if (PreviousInventoryList.Num() > InventoryList.Num())
 	{
 		//Our currently equipped weapon is going through some sort of garbage collection
-		if (!CurrentWeapon || !CurrentWeapon->IsPendingKill() || !CurrentWeapon->IsBeingDestroyed() || !InventoryList.Contains(CurrentWeapon))
+		if (!CurrentWeapon || CurrentWeapon->IsPendingKill() || CurrentWeapon->IsBeingDestroyed() || !InventoryList.Contains(CurrentWeapon))
 		{
 			SetCurrentWeapon(GetPendingWeapon() ? GetPendingWeapon() : GetNextBestWeapon());
 		}
@@ -931,22 +943,26 @@ void UInventoryManagerComponent::OnRep_InventoryList()
 
 		if (!PreviousInventoryList.Contains(Inventory))
 		{
-			if (Inventory->OnComponentEndPlay.IsAlreadyBound(this, &UInventoryManagerComponent::OnInventoryEndPlay))
+			if (!Inventory->OnComponentEndPlay.IsAlreadyBound(this, &UInventoryManagerComponent::OnInventoryEndPlay))
 			{
 				Inventory->OnComponentEndPlay.AddDynamic(this, &UInventoryManagerComponent::OnInventoryEndPlay);
 			}
 
+			IndexInventory(Inventory, GroupUpdateList);
 			OnInventoryAdded.Broadcast(Inventory);
 		}
 	}
 
-	RequestMovementSpeedModifierUpdate();
-
-	if (IsLocallyOwned())
+	//Passive modifiers are cached per weapon, firemode and ammo instance.
+	if (UPlayerClassComponent* PlayerClassComponent = GetOwningCharacter() ? GetOwningCharacter()->GetPlayerClassComponent() : nullptr)
 	{
-		UpdateWeaponGroupMap();
+		PlayerClassComponent->MarkPassiveSkillModifiersDirty();
 	}
 
+	RequestMovementSpeedModifierUpdate();
+
+	BroadcastGroupUpdates(GroupUpdateList);
+
 	OnInventoryUpdate.Broadcast(this);
 	PreviousInventoryList = InventoryList;
 }
@@ -1012,92 +1028,87 @@ void UInventoryManagerComponent::EquipInitialWeapon()
 	GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UInventoryManagerComponent::EquipInitialWeapon));
 }
 
-void UInventoryManagerComponent::UpdateWeaponGroupMap()
+void UInventoryManagerComponent::IndexInventory(UInventory* Inventory, TArray<EWeaponGroup>& GroupUpdateList)
 {
-	if (!IsLocallyOwned())
+	if (!Inventory || Inventory->IsPendingKill())
 	{
 		return;
 	}
 
-	TArray<EWeaponGroup> GroupUpdateList;
-
-	TMap<EWeaponGroup, FWeaponGroupArray> NewWeaponGroupMap;
-	NewWeaponGroupMap.Reserve(MAXWEAPONGROUP);
+	UInventory*& IndexedInventory = InventoryClassMap.FindOrAdd(Inventory->GetClass());
 
-	for (UInventory* Inventory : InventoryList)
+	if (IndexedInventory == Inventory)
 	{
-		UWeapon* Weapon = Cast<UWeapon>(Inventory);
-		EWeaponGroup Group = Weapon ? Weapon->GetWeaponGroup() : EWeaponGroup::None;
+		return;
+	}
 
-		if (Group == EWeaponGroup::None)
-		{
-			continue;
-		}
+	ensureMsgf(!IndexedInventory, TEXT("Inventory %s indexed while %s of the same class is still indexed."), *GetNameSafe(Inventory), *GetNameSafe(IndexedInventory));
+	IndexedInventory = Inventory;
 
-		NewWeaponGroupMap.FindOrAdd(Group).WeaponArray.Add(TWeakObjectPtr<UWeapon>(Weapon));
+	UWeapon* Weapon = Cast<UWeapon>(Inventory);
+
+	if (!Weapon)
+	{
+		return;
 	}
 
-	for (TPair<EWeaponGroup, FWeaponGroupArray>& GroupEntry : WeaponGroupMap)
+	BestWeaponList.Insert(Weapon, Algo::UpperBound(BestWeaponList, Weapon, FSortWeaponByRating()));
+
+	const EWeaponGroup Group = Weapon->GetWeaponGroup();
+
+	if (Group == EWeaponGroup::None)
 	{
-		if (!NewWeaponGroupMap.Contains(GroupEntry.Key))
-		{
-			GroupUpdateList.Add(GroupEntry.Key);
-			continue;
-		}
+		return;
+	}
 
-		bool bFoundNullWeapon = false;
-		for (TWeakObjectPtr<UWeapon> Weapon : GroupEntry.Value)
-		{
-			if (!Weapon.IsValid())
-			{
-				bFoundNullWeapon = true;
-				break;
-			}
-		}
+	TArray<TWeakObjectPtr<UWeapon>>& WeaponArray = WeaponGroupMap.FindOrAdd(Group).WeaponArray;
+	const TWeakObjectPtr<UWeapon> WeakWeapon = Weapon;
+	WeaponArray.Insert(WeakWeapon, Algo::UpperBound(WeaponArray, WeakWeapon, UWeapon::FSortByPriority()));
+	GroupUpdateList.AddUnique(Group);
+}
 
-		if (bFoundNullWeapon)
-		{
-			GroupUpdateList.Add(GroupEntry.Key);
-			continue;
-		}
+void UInventoryManagerComponent::UnindexInventory(UInventory* Inventory, TArray<EWeaponGroup>& GroupUpdateList)
+{
+	if (!Inventory || InventoryClassMap.FindRef(Inventory->GetClass()) != Inventory)
+	{
+		return;
+	}
 
-		bool bFoundNewWeapon = false;
-		const TArray<TWeakObjectPtr<UWeapon>>& NewWeaponList = NewWeaponGroupMap[GroupEntry.Key].WeaponArray;
+	InventoryClassMap.Remove(Inventory->GetClass());
 
-		for (const TWeakObjectPtr<UWeapon>& Weapon : NewWeaponList)
-		{
-			if (!GroupEntry.Value.WeaponArray.Contains(Weapon))
-			{
-				bFoundNewWeapon = true;
-				break;
-			}
-		}
+	UWeapon* Weapon = Cast<UWeapon>(Inventory);
 
-		if (bFoundNewWeapon)
-		{
-			GroupUpdateList.Add(GroupEntry.Key);
-			continue;
-		}
+	if (!Weapon)
+	{
+		return;
 	}
 
-	for (TPair<EWeaponGroup, FWeaponGroupArray>& GroupEntry : NewWeaponGroupMap)
+	BestWeaponList.RemoveSingle(Weapon);
+
+	const EWeaponGroup Group = Weapon->GetWeaponGroup();
+	FWeaponGroupArray* WeaponGroup = WeaponGroupMap.Find(Group);
+
+	if (!WeaponGroup)
 	{
-		if (!WeaponGroupMap.Contains(GroupEntry.Key))
-		{
-			GroupUpdateList.Add(GroupEntry.Key);
-			continue;
-		}
+		return;
 	}
-	
-	for (const EWeaponGroup& Group : GroupUpdateList)
+
+	WeaponGroup->WeaponArray.RemoveSingle(TWeakObjectPtr<UWeapon>(Weapon));
+
+	if (WeaponGroup->WeaponArray.Num() == 0)
 	{
-		if (WeaponGroupMap.Contains(Group))
-		{
-			WeaponGroupMap[Group].WeaponArray.Sort(UWeapon::FSortByPriority());
-		}
+		WeaponGroupMap.Remove(Group);
 	}
 
-	WeaponGroupMap = MoveTemp(NewWeaponGroupMap);
+	GroupUpdateList.AddUnique(Group);
+}
+
+void UInventoryManagerComponent::BroadcastGroupUpdates(const TArray<EWeaponGroup>& GroupUpdateList)
+{
+	if (!IsLocallyOwned())
+	{
+		return;
+	}
 
 	for (const EWeaponGroup& Group : GroupUpdateList)
 	{
@@ -1114,6 +1125,10 @@ void UInventoryManagerComponent::OnInventoryEndPlay(UCoreCharacterComponent* Com
 		return;
 	}
 
+	TArray<EWeaponGroup> GroupUpdateList;
+	UnindexInventory(Inventory, GroupUpdateList);
+	BroadcastGroupUpdates(GroupUpdateList);
+
 	OnInventoryRemoved.Broadcast(Inventory);
 }
 
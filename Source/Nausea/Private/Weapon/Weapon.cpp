@@ -155,7 +155,8 @@ float UWeapon::GetEquipDuration() const
 	float ModifierEquipTimeTime = EquipTime;
 	if (UPlayerClassComponent* PlayerClassComponent = GetPlayerClassComponent())
 	{
-		PlayerClassComponent->OnProcessPutDownTime.Broadcast(this, ModifierEquipTimeTime);
+		ModifierEquipTimeTime *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::EquipRate, this);
+		PlayerClassComponent->OnProcessEquipTime.Broadcast(this, ModifierEquipTimeTime);
 	}
 	return ModifierEquipTimeTime;
 }
@@ -165,6 +166,7 @@ float UWeapon::GetPutDownDuration() const
 	float ModifierPutDownTime = PutDownTime;
 	if (UPlayerClassComponent* PlayerClassComponent = GetPlayerClassComponent())
 	{
+		ModifierPutDownTime *= PlayerClassComponent->GetPassiveSkillMultiplier(ESimplePassiveSkill::EquipRate, this);
 		PlayerClassComponent->OnProcessPutDownTime.Broadcast(this, ModifierPutDownTime);
 	}
 	return ModifierPutDownTime;
@@ -53,6 +53,7 @@ class NAUSEA_API ULoopRoutineSelectAbilityRoutine : public ULoopRoutine
 public:
 	virtual void StartRoutine() override;
 	virtual FString DescribeRoutineToGameplayDebugger() const override;
+	virtual void AppendAbilityClassList(TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList) const override;
 protected:
 	virtual URoutineAction* CreateRoutineAction(TSubclassOf<URoutineAction> RoutineActionClass, bool bAutoStart = true) override;
 //~ End URoutine Interface
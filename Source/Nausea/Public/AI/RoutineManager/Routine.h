@@ -10,6 +10,7 @@ class ACoreAIController;
 class URoutineManagerComponent;
 
 class UActionBrainDataObject;
+class UAbilityInfo;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRoutineCompleteSignature, URoutine*, Routine);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FRoutineActionCompleteSignature, URoutine*, Routine, URoutineAction*, RoutineAction);
@@ -54,6 +55,9 @@ public:
 
 	virtual FString DescribeRoutineToGameplayDebugger() const;
 
+	//Appends any abilities this routine may ask its pawn to perform. Used to preload ability content ahead of the pawn spawning.
+	virtual void AppendAbilityClassList(TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList) const {}
+
 public:
 	UPROPERTY(BlueprintAssignable, Category = Routine)
 	FRoutineCompleteSignature OnRoutineComplete;
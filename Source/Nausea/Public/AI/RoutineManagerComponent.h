@@ -32,6 +32,8 @@ public:
 	URoutine* GetCurrentRoutine() const { return CurrentRoutine; }
 	UFUNCTION()
 	URoutineAction* GetCurrentRoutineAction() const;
+	UFUNCTION()
+	TSubclassOf<URoutine> GetDefaultRoutineClass() const { return DefaultRoutineClass; }
 
 	UFUNCTION(BlueprintCallable, Category = RoutineManager)
 	virtual URoutine* CreateRoutine(TSubclassOf<URoutine> RoutineClass, bool bAutoStart = true);
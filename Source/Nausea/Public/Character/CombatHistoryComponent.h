@@ -20,18 +20,23 @@ class NAUSEA_API UCombatHistoryComponent : public UActorComponent
 //~ Begin UActorComponent Interface
 protected:
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 //~ Begin UActorComponent Interface
 
 public:
 	UFUNCTION(BlueprintCallable, Category = CombatHistoryComponent)
 	UStatusComponent* GetStatusComponent() const;
 
+	//Returns a copy of the damage log ordered from oldest to newest.
 	UFUNCTION(BlueprintCallable, Category = CombatHistoryComponent)
-	const TArray<FDamageLogEvent>& GetDamageLogList() const { return DamageLogList; }
+	TArray<FDamageLogEvent> GetDamageLogList() const;
 
 	UFUNCTION(BlueprintCallable, Category = CombatHistoryComponent)
-	const FDamageLogEvent& GetDamageLogDeathEvent() const { return DamageLogList.Last(); }
+	int32 GetDamageLogCount() const { return DamageLogList.Num(); }
+
+	//Returns the most recently logged event (which is the death event if the owner has died).
+	UFUNCTION(BlueprintCallable, Category = CombatHistoryComponent)
+	const FDamageLogEvent& GetDamageLogDeathEvent() const;
 
 protected:
 	UFUNCTION()
@@ -46,12 +51,26 @@ protected:
 	UFUNCTION()
 	void AddDamageLogEvent(const FDamageLogEvent& DamageLogEvent);
 
-	//Returns true if damage log that was pushed to the buffer needs to be sent to the log list.
+	//Combines the given event with a matching buffered event if possible, otherwise adds it to the buffer. Returns the buffer index the event was stored at.
 	UFUNCTION()
 	int32 PushDamageLogEventToBuffer(const FDamageLogEvent& DamageLogEvent);
 
+	//Moves expired buffered events to the log and sends any pending events to the owning client.
+	UFUNCTION()
+	void FlushDamageLog();
+
+	void FlushDamageLogBuffer(bool bForceFlush);
+	void SendPendingDamageLogEvents(bool bReliable);
+	void UpdateFlushTimer();
+
+	UFUNCTION(Client, Unreliable)
+	void Client_Unreliable_SendDamageLogBatch(const TArray<FDamageLogEvent>& DamageLogEventList);
+
+	//Used for batches containing a death event, since those drive the death screen and should not be dropped.
 	UFUNCTION(Client, Reliable)
-	void Client_Relaible_SendDamageLog(const FDamageLogEvent& DamageLogEvent);
+	void Client_Reliable_SendDamageLogBatch(const TArray<FDamageLogEvent>& DamageLogEventList);
+
+	void ReceiveDamageLogBatch(const TArray<FDamageLogEvent>& DamageLogEventList);
 
 public:
 	UPROPERTY(BlueprintAssignable, Category = CombatHistoryComponent)
@@ -60,6 +79,27 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = CombatHistoryComponent)
 	FReceivedDamageLogEventSignature OnReceivedDamageLogDeathEvent;
 
+protected:
+	//Maximum number of events kept in the damage log. Once full, the oldest entries are overwritten.
+	UPROPERTY(EditDefaultsOnly, Category = CombatHistoryComponent, meta = (ClampMin = "1"))
+	int32 MaxDamageLogCount = 64;
+
+	//Maximum number of events that can be waiting to be merged at once. Once full, the oldest buffered event is pushed to the log.
+	UPROPERTY(EditDefaultsOnly, Category = CombatHistoryComponent, meta = (ClampMin = "1"))
+	int32 MaxBufferedDamageLogCount = 8;
+
+	//Interval at which buffered events are checked for expiry and pending events are sent to the owning client.
+	UPROPERTY(EditDefaultsOnly, Category = CombatHistoryComponent, meta = (ClampMin = "0.05"))
+	float DamageLogFlushInterval = 0.25f;
+
+	//Maximum number of events sent in a single batch.
+	UPROPERTY(EditDefaultsOnly, Category = CombatHistoryComponent, meta = (ClampMin = "1"))
+	int32 MaxDamageLogBatchSize = 16;
+
+	//Maximum number of unreliable batches sent per flush. Pending events are also capped at MaxDamageLogCount (oldest dropped first) so the list cannot grow unbounded.
+	UPROPERTY(EditDefaultsOnly, Category = CombatHistoryComponent, meta = (ClampMin = "1"))
+	int32 MaxUnreliableDamageLogBatchesPerFlush = 4;
+
 private:
 	UPROPERTY(Transient)
 	TScriptInterface<IStatusInterface> OwningStatusInterface = nullptr;
@@ -67,6 +107,16 @@ private:
 	UPROPERTY(Transient)
 	TArray<FDamageLogEvent> DamageLogBufferList = TArray<FDamageLogEvent>();
 
+	//Ring buffer of logged events. Once it has reached MaxDamageLogCount, DamageLogHeadIndex points at the oldest entry.
 	UPROPERTY(Transient)
 	TArray<FDamageLogEvent> DamageLogList = TArray<FDamageLogEvent>();
+	UPROPERTY(Transient)
+	int32 DamageLogHeadIndex = 0;
+
+	//Events waiting to be sent to the owning client on the next flush.
+	UPROPERTY(Transient)
+	TArray<FDamageLogEvent> PendingDamageLogSendList = TArray<FDamageLogEvent>();
+
+	UPROPERTY(Transient)
+	FTimerHandle DamageLogFlushTimer;
 };
@@ -141,6 +141,8 @@ public:
 	const UAnimationObject* GetFirstPersonAnimObject() const { return FirstPersonAnimationObject; }
 	const UAnimationObject* GetThirdPersonAnimObject() const { return ThirdPersonAnimationObject; }
 
+	const TArray<TWeakObjectPtr<UPrimitiveComponent>>& GetThirdPersonMeshList() const { return ThirdPersonMeshList; }
+
 	UFUNCTION(BlueprintCallable, Category = Character)
 	UCameraComponent* GetFirstPersonCamera() const { return FirstPersonCamera; }
 	UFUNCTION(BlueprintCallable, Category = Character)
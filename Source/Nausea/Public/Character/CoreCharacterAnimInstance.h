@@ -13,6 +13,27 @@ class UCoreCharacterMovementComponent;
 class UWeapon;
 class UAnimSequence;
 class UAnimMontage;
+class UStatusEffectBase;
+
+USTRUCT()
+struct FStatusMontageLoopEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusMontageLoopEntry() {}
+	FStatusMontageLoopEntry(UAnimMontage* InMontage, UStatusEffectBase* InStatusEffect, float InLoopEndSectionStartTime, float InLoopEndSectionLength)
+		: Montage(InMontage), StatusEffect(InStatusEffect), LoopEndSectionStartTime(InLoopEndSectionStartTime), LoopEndSectionLength(InLoopEndSectionLength) {}
+
+	UPROPERTY(Transient)
+	UAnimMontage* Montage = nullptr;
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UStatusEffectBase> StatusEffect = nullptr;
+	UPROPERTY(Transient)
+	float LoopEndSectionStartTime = 0.f;
+	//The montage jumps to its loop end section once the status has this long remaining. -1 if it loops until the status ends.
+	UPROPERTY(Transient)
+	float LoopEndSectionLength = -1.f;
+};
 
 USTRUCT(BlueprintType)
 struct FCoreCharacterAnimInstanceProxy : public FAnimInstanceProxy
@@ -27,7 +48,10 @@ struct FCoreCharacterAnimInstanceProxy : public FAnimInstanceProxy
 
 	FCoreCharacterAnimInstanceProxy(UAnimInstance* Instance);
 
+//Everything the anim graph reads per frame is copied here by PreUpdate on the game thread so the rest of the update can run on worker threads.
 public:
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    FVector Velocity = FVector::ZeroVector;
     UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
     float MovementDirection = 0.f;
     UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
@@ -46,12 +70,30 @@ public:
     UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
     bool bRunJumping = false;
 
+    //Base aim rotation relative to the character's rotation.
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    float AimPitch = 0.f;
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    float AimYaw = 0.f;
+
     UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
     bool bDead = false;
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    bool bActionBlocked = false;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    bool bHasWeapon = false;
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    EWeaponState WeaponState = EWeaponState::Inactive;
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    bool bFiring = false;
 
     UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
     bool bIsLowLOD = false;
 
+    UPROPERTY(Transient, BlueprintReadOnly, Category = CoreCharacterAnimInstanceProxy)
+    FLocomotionAnimationContainer LocomotionAnimations;
+
 
 protected:
 	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
@@ -77,7 +119,6 @@ public:
 
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
-	virtual void BeginDestroy() override;
 
 	UFUNCTION()
 	const UAnimationObject* GetDefaultAnimationObject() const { return DefaultAnimationObject.GetDefaultObject(); }
@@ -86,11 +127,15 @@ public:
 	const UAnimationObject* GetCharacterAnimationObject() const;
 
 	UFUNCTION()
-	bool DoesMontageHaveRegisteredLoopTimerHandle(UAnimMontage* Montage) const;
+	bool IsStatusMontageLooping(UAnimMontage* Montage) const;
 	UFUNCTION()
-	void RegisterMontageLoopTimerHandle(UAnimMontage* Montage, FTimerHandle Handle);
+	void RegisterStatusMontageLoop(UAnimMontage* Montage, UStatusEffectBase* StatusEffect, float LoopEndSectionStartTime, float LoopEndSectionLength);
 	UFUNCTION()
-	void RevokeMontageLoopTimerHandle(UAnimMontage* Montage);
+	void RevokeStatusMontageLoop(UAnimMontage* Montage);
+
+	//Starts the loop end section of any looping status montage whose status is about to end. Evaluated on every animation update.
+	//Updates can be skipped or throttled (offscreen, URO, animation budget) so the section is started at the point matching the status' remaining time rather than its beginning.
+	void UpdateStatusMontageLoops();
 
 public:
 	UPROPERTY(EditDefaultsOnly, Category = Animation)
@@ -132,12 +177,16 @@ protected:
 	UPROPERTY()
 	FLocomotionAnimationContainer WeaponLocomationAnimations;
 
-	//Used by anim BP. Set by FCoreCharacterAnimInstanceProxy::PreUpdate() to comply with async work.
+	//Used by anim BP. Set by FCoreCharacterAnimInstanceProxy::PreUpdate() to comply with async work. Prefer the proxy's copy, this is kept for anim BPs that still read it.
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Animation)
 	FLocomotionAnimationContainer LocomationAnimations;
 
+	//Resolved once on initialization rather than cast from the owning actor on every access.
+	UPROPERTY(Transient)
+	ACoreCharacter* OwningCharacter = nullptr;
+
 	UPROPERTY(Transient)
-	TMap<UAnimMontage*, FTimerHandle> StatusMontageLoopTimerMap = TMap<UAnimMontage*, FTimerHandle>();
+	TArray<FStatusMontageLoopEntry> StatusMontageLoopList;
 
 protected:
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Animation, meta = (AllowPrivateAccess = "true"))
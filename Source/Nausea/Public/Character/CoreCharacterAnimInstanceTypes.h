@@ -8,6 +8,7 @@
 #include "Gameplay/StatusType.h"
 #include "CoreCharacterAnimInstanceTypes.generated.h"
 
+class AActor;
 class UAnimSequence;
 class UAnimMontage;
 class UBlendSpace;
@@ -96,6 +97,8 @@ struct FHitReactionAnimationContainer
 	UAnimMontage* GetMontage(EHitReactionStrength Strength) const;
 	UAnimMontage* GetMontageForStream(EHitReactionStrength Strength, const FRandomStream& Seed) const;
 
+	void AppendMontageList(TArray<UAnimMontage*>& OutMontageList) const;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Animation)
 	FAnimationMontageContainer LightHitReaction;
@@ -156,6 +159,21 @@ public:
 	static FWeaponMontagePair InvalidMontagePair;
 };
 
+//Section lookups for a montage played by an animation object. Resolved once per montage rather than on every play.
+struct FAnimationMontageSectionInfo
+{
+	FAnimationMontageSectionInfo() {}
+
+	FName GetDirectionSection(EHitReactionDirection Direction) const { return Direction < EHitReactionDirection::MAX ? DirectionSectionList[uint8(Direction)] : NAME_None; }
+	bool HasLoopEndSection() const { return LoopEndSectionLength >= 0.f; }
+
+	//Section to jump to per hit reaction direction. NAME_None if the montage has no such section.
+	FName DirectionSectionList[uint8(EHitReactionDirection::MAX)];
+	//Start time and length of the montage's status loop end section. Length is -1 if it has none.
+	float LoopEndSectionStartTime = 0.f;
+	float LoopEndSectionLength = -1.f;
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class NAUSEA_API UAnimationObject : public UObject
 {
@@ -169,6 +187,11 @@ public:
 //~ End UObject Interface
 protected:
 	void UpdateVisibleProperties();
+
+	//Drops cached montage section info so it is resolved again on next use.
+	void ResetMontageSectionCache() const;
+	//Resets the section cache of every animation object that has cached the saved montage.
+	static void OnObjectSaved(UObject* Object);
 #endif //WITH_EDITOR
 
 public:
@@ -217,6 +240,17 @@ public:
 
 	bool PlayStatusEndMontage(UStatusEffectBase* StatusEffect, UCoreCharacterAnimInstance* AnimInstance, EStatusEndType EndType) const;
 
+	//Appends every montage this animation object can play.
+	void AppendMontageList(TArray<UAnimMontage*>& OutMontageList) const;
+
+	const FAnimationMontageSectionInfo& GetMontageSectionInfo(const UAnimMontage* Montage) const;
+
+	//Resolves section info for every montage this animation object can play. Only does work the first time it is called.
+	int32 PrepareAnimationContent() const;
+
+	//Prepares the animation objects used by the given character class, its meshes' anim instances and its default inventory.
+	static int32 PrepareCharacterAnimationContent(TSubclassOf<AActor> CharacterClass);
+
 public:
 	static FName StatusLoopSection;
 	static FName StatusLoopEndSection;
@@ -242,4 +276,9 @@ protected:
 	bool bHasLoopingReload = false;
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Looping Reload Animation Set", meta = (EditCondition = "bHasLoopingReload", EditConditionHides))
 	TMap<EFireMode, FWeaponMontagePair> LoopingReloadMontage = TMap<EFireMode, FWeaponMontagePair>();
+
+private:
+	//Animation objects are used through their class default object so these are filled on demand.
+	mutable TMap<TObjectKey<UAnimMontage>, FAnimationMontageSectionInfo> MontageSectionInfoMap;
+	mutable bool bAnimationContentPrepared = false;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "UObject/NoExportTypes.h"
 #include "Engine/StreamableManager.h"
 #include "System/MeshMergeTypes.h"
+#include "System/CustomizationStreamingManager.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Character/CoreCharacterComponent.h"
 #include "CoreCustomizationComponent.generated.h"
@@ -29,8 +30,14 @@ public:
     UFUNCTION()
     void SetCustomization(const TArray<UCustomizationAsset*>& InCustomizationList);
 
-    //Any UCustomizationAsset::Apply implementation that needs to load something should do so and let us know here so we can cancel it if we change our customization while loading.
-    void AddCustomizationStreamHandle(TSharedPtr<FStreamableHandle> StreamHandle);
+    //Any UCustomizationAsset::Apply implementation that needs to load something should do so through UCustomizationStreamingManager and let us know here so we can release it if we change our customization.
+    void AddCustomizationStreamHandle(FCustomizationStreamHandle StreamHandle);
+
+    //Priority given to any streaming requested for this component's customization.
+    virtual ECustomizationStreamPriority GetCustomizationStreamPriority() const;
+
+    //Finds the customization list a character class will start with (including classes that add this component in blueprint).
+    static bool GetDefaultCustomizationList(TSubclassOf<AActor> ActorClass, TArray<UCustomizationAsset*>& OutCustomizationList);
 
     //Any UCustomizationAsset::Apply implementation that adds a new component to the character should do so and let us know here so we can destroy it if we change our customization.
     void AddCustomizationComponent(UActorComponent* Component);
@@ -44,6 +51,8 @@ protected:
     UFUNCTION()
     void OnMeshMergeComplete();
 
+    void ReleaseCustomizationStreamHandles();
+
 protected:
     UPROPERTY(EditAnywhere, Category = Customization)
     TArray<UCustomizationAsset*> DefaultCustomizationList = TArray<UCustomizationAsset*>();
@@ -57,6 +66,6 @@ protected:
     UPROPERTY(EditDefaultsOnly)
     bool bPerformMergeInEditor = false;
 
-	TArray<TSharedPtr<FStreamableHandle>> CustomizationStreamableHandleList;
+	TArray<FCustomizationStreamHandle> CustomizationStreamHandleList;
 	TArray<TWeakObjectPtr<UActorComponent>> CustomizationComponentList;
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "CorpseManager.generated.h"
+
+class ACoreCharacter;
+class USkeletalMeshComponent;
+class UPoseableMeshComponent;
+
+UENUM()
+enum class ECorpseState : uint8
+{
+	Simulating,	//Ragdoll is simulating physics.
+	Frozen,		//Physics and animation have been stopped and the corpse is holding its last pose.
+	FadingOut	//Corpse is sinking out of view and will be recycled once done.
+};
+
+USTRUCT()
+struct FCorpseEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FCorpseEntry() {}
+	FCorpseEntry(ACoreCharacter* InCharacter, float InDeathTime)
+		: Character(InCharacter), DeathTime(InDeathTime) {}
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<ACoreCharacter> Character = nullptr;
+	//Pooled mesh holding this corpse's pose once its character has been released.
+	UPROPERTY(Transient)
+	UPoseableMeshComponent* PooledMesh = nullptr;
+	UPROPERTY(Transient)
+	ECorpseState State = ECorpseState::Simulating;
+	UPROPERTY(Transient)
+	float DeathTime = 0.f;
+	UPROPERTY(Transient)
+	float FadeStartTime = 0.f;
+
+	//Higher scores are less significant and are frozen or faded out first.
+	float SortScore = 0.f;
+};
+
+/**
+ * Keeps client side corpses under budget. Only a limited number of ragdolls are allowed to simulate at once, the least significant ones beyond that
+ * (or any that have come to rest) are frozen in their current pose. Corpses beyond a second limit are sunk out of view and recycled.
+ * Frozen corpses made of a single skeletal mesh have their pose copied onto a pooled poseable mesh so the character itself can be released.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UCorpseManager : public UObject, public FTickableGameObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const override { return HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ? ETickableTickType::Never : ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return CorpseList.Num() > 0 && !IsPendingKill(); }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UCorpseManager, STATGROUP_Tickables); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	//Hands a character that has just started ragdolling over to the corpse manager. Does nothing on dedicated servers.
+	static bool RegisterCorpse(ACoreCharacter* Character);
+
+	UFUNCTION(BlueprintCallable, Category = Corpse)
+	int32 GetCorpseCount() const { return CorpseList.Num(); }
+	UFUNCTION(BlueprintCallable, Category = Corpse)
+	int32 GetSimulatingCorpseCount() const;
+
+protected:
+	void RemoveStaleCorpses();
+	void FreezeSettledCorpses(float CurrentTime);
+	void EnforceSimulationBudget();
+	void EnforceCorpseBudget(float CurrentTime);
+	void UpdateFadingCorpses(float DeltaTime, float CurrentTime);
+
+	void FreezeCorpse(FCorpseEntry& Corpse);
+	void StartFadeOut(FCorpseEntry& Corpse, float CurrentTime);
+	void RecycleCorpse(FCorpseEntry& Corpse);
+
+	//Attempts to move the frozen pose of a corpse onto a pooled mesh. Returns false if the corpse is not made of a single skeletal mesh or belongs to a player.
+	bool TransferToPooledMesh(FCorpseEntry& Corpse);
+	UPoseableMeshComponent* AcquirePooledMesh();
+	void ReleasePooledMesh(UPoseableMeshComponent* PoseableMesh);
+
+	void UpdateSortScores(float CurrentTime);
+	FVector GetCorpseLocation(const FCorpseEntry& Corpse) const;
+	bool WasCorpseRecentlyRendered(const FCorpseEntry& Corpse) const;
+	bool IsCorpseAtRest(const FCorpseEntry& Corpse) const;
+
+protected:
+	//Maximum number of ragdolls simulating at once.
+	UPROPERTY(Config)
+	int32 MaxSimulatingCorpses = 12;
+	//Maximum number of corpses (simulating or frozen) before the least significant ones are faded out.
+	UPROPERTY(Config)
+	int32 MaxCorpses = 40;
+	//Ragdolls that have come to rest are frozen once they have simulated for at least this long.
+	UPROPERTY(Config)
+	float MinSimulationTime = 2.f;
+	//Score added per unit of distance to the local view. Age in seconds is the base score.
+	UPROPERTY(Config)
+	float DistanceScoreScale = 0.001f;
+	//Score added to corpses that are not on screen.
+	UPROPERTY(Config)
+	float OffscreenScore = 5.f;
+	UPROPERTY(Config)
+	float FadeOutDuration = 2.f;
+	UPROPERTY(Config)
+	float FadeOutSinkDistance = 100.f;
+
+	UPROPERTY(Transient)
+	TArray<FCorpseEntry> CorpseList;
+
+	//Actor owning every pooled corpse mesh.
+	UPROPERTY(Transient)
+	AActor* CorpsePoolActor = nullptr;
+	UPROPERTY(Transient)
+	TArray<UPoseableMeshComponent*> AvailablePooledMeshList;
+
+	TArray<int32> SortedCorpseIndexList;
+};
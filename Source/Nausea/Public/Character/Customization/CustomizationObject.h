@@ -12,6 +12,8 @@ class ACoreCharacter;
 class UCoreCustomizationComponent;
 class USkeletalMesh;
 class UMaterialInstance;
+class UCustomizationAsset;
+struct FAssetData;
 
 UENUM(BlueprintType)
 enum class ECustomizationSlot : uint8
@@ -56,6 +58,26 @@ extern const TArray<ECustomizationSlot> BodySlotList;
 extern const TArray<ECustomizationSlot> AccessorySlotList;
 extern const TArray<ECustomizationSlot> TextureSlotList;
 
+//Lightweight description of a customization asset read from the asset registry without loading it. See UNauseaAssetManager::GetCustomizationIndex.
+USTRUCT(BlueprintType)
+struct NAUSEA_API FCustomizationIndexEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FCustomizationIndexEntry() {}
+
+	UPROPERTY(BlueprintReadOnly, Category = Customization)
+	FPrimaryAssetId AssetId;
+	UPROPERTY(BlueprintReadOnly, Category = Customization)
+	TSoftObjectPtr<UCustomizationAsset> CustomizationAsset = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category = Customization)
+	ECustomizationSlot Slot = ECustomizationSlot::Invalid;
+	UPROPERTY(BlueprintReadOnly, Category = Customization)
+	FText CustomizationName = FText();
+	UPROPERTY(BlueprintReadOnly, Category = Customization)
+	TSoftObjectPtr<UTexture2D> PreviewIcon = nullptr;
+};
+
 /**
  * Holds data about a specific customization. Should be accessed via CDO and never modified. All new customizations should receive its own CustomziationFactory subclass (see CustomizationFactory.h).
  */
@@ -70,8 +92,15 @@ public:
 //~ Begin UObject Interface
 public:
 	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
 //~ End UObject Interface
 
+public:
+	//Fills out an index entry from the registry tags written by UCustomizationAsset::GetAssetRegistryTags. Returns false if the tags are missing.
+	static bool ReadIndexEntry(const FAssetData& AssetData, FCustomizationIndexEntry& OutEntry);
+	//Fills out an index entry from this loaded asset. Used for assets saved before their registry tags were written.
+	void GetIndexEntry(FCustomizationIndexEntry& OutEntry) const;
+
 public:
 	virtual TSoftObjectPtr<USkeletalMesh> GetSkeletalMesh() const { return nullptr; }
 	virtual TSoftObjectPtr<UTexture2D> GetTexture() const { return nullptr; }
@@ -89,6 +118,8 @@ public:
 	static bool ValidateCustomization(ACorePlayerController* PlayerController, ACoreCharacter* Character, TMap<ECustomizationSlot, UCustomizationAsset*>& CustomizationMap);
 
 	static TArray<TSoftObjectPtr<USkeletalMesh>> GetMeshMergeListForCustomizationList(const TArray<UCustomizationAsset*>& CustomizationList);
+	//Gathers every asset the given customization list references so that it can be streamed in ahead of being applied.
+	static void GetAssetListForCustomizationList(const TArray<UCustomizationAsset*>& CustomizationList, TArray<FSoftObjectPath>& OutAssetList);
 	static void ApplyCustomizationList(UCoreCustomizationComponent* CustomizationComponent, USkeletalMeshComponent* SkeletalMeshComponent, const TArray<UCustomizationAsset*>& CustomizationList);
 
 protected:
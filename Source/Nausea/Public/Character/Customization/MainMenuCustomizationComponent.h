@@ -23,10 +23,16 @@ protected:
 //~ End UActorComponent Interface
 
 //~ Begin UCoreCustomizationComponent Interface
+public:
+	virtual ECustomizationStreamPriority GetCustomizationStreamPriority() const override { return ECustomizationStreamPriority::Immediate; }
 protected:
 	virtual void UpdateCustomization() override;
 //~ End UCoreCustomizationComponent Interface
 
+protected:
+	UFUNCTION()
+	void OnCustomizationLoaded();
+
 protected:
 	UPROPERTY()
 	TMap<ECustomizationSlot, USkeletalMeshComponent*> SkeletalMeshBodyComponents = TMap<ECustomizationSlot, USkeletalMeshComponent*>();
@@ -19,8 +19,11 @@ class NAUSEA_API ADungeonCharacter : public ACoreCharacter
 //~ Begin AActor Interface
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 public:
 	virtual void PreRegisterAllComponents() override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+	virtual bool IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer) override;
 //~ End AActor Interface
 
 //~ Begin IStatusInterface Interface
@@ -0,0 +1,189 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "HordeReplicationManager.generated.h"
+
+class ADungeonCharacter;
+class AController;
+class APawn;
+class APlayerController;
+class UStatusComponent;
+
+USTRUCT()
+struct FHordeConnectionState
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHordeConnectionState() {}
+
+	//Scale applied to the character's net priority for this connection.
+	UPROPERTY(Transient)
+	float PriorityScale = 1.f;
+	//If true, this connection's byte budget is spent and the character will not replicate to it until re-evaluated.
+	UPROPERTY(Transient)
+	bool bPaused = false;
+	UPROPERTY(Transient)
+	float PausedTime = 0.f;
+	UPROPERTY(Transient)
+	float UnpausedTime = 0.f;
+
+	//Set during evaluation.
+	bool bInView = false;
+	bool bInCombat = false;
+	float Distance = 0.f;
+};
+
+USTRUCT()
+struct FHordeReplicationEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHordeReplicationEntry() {}
+	FHordeReplicationEntry(ADungeonCharacter* InCharacter, float InActiveTime)
+		: Character(InCharacter), LastActiveTime(InActiveTime) {}
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<ADungeonCharacter> Character = nullptr;
+	UPROPERTY(Transient)
+	TWeakObjectPtr<AController> LastDamageInstigator = nullptr;
+	UPROPERTY(Transient)
+	float LastDamageTime = -1.f;
+	//Last time this character was moving, fighting or seen by any connection.
+	UPROPERTY(Transient)
+	float LastActiveTime = 0.f;
+	UPROPERTY(Transient)
+	bool bDormant = false;
+
+	//Indexed the same as UHordeReplicationManager::ViewerList.
+	UPROPERTY(Transient)
+	TArray<FHordeConnectionState> ConnectionStateList;
+
+	//Estimated bytes per second this character costs a connection at its current update rate.
+	float EstimatedBytesPerSecond = 0.f;
+};
+
+USTRUCT()
+struct FHordeReplicationViewer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHordeReplicationViewer() {}
+	FHordeReplicationViewer(APlayerController* InPlayerController)
+		: PlayerController(InPlayerController) {}
+
+	UPROPERTY(Transient)
+	APlayerController* PlayerController = nullptr;
+	UPROPERTY(Transient)
+	APawn* Pawn = nullptr;
+	FVector ViewLocation = FVector::ZeroVector;
+	FVector ViewDirection = FVector::ForwardVector;
+};
+
+/**
+ * Server side replication management for dungeon characters. Periodically scores every character against every remote connection by distance,
+ * visibility and combat involvement. The results drive each character's update rate, its per connection net priority and a per connection byte budget
+ * (characters past the budget have replication paused for that connection, starved characters are always let through). Idle characters no connection can see are put into dormancy.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UHordeReplicationManager : public UObject, public FTickableGameObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const override { return HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ? ETickableTickType::Never : ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return EntryList.Num() > 0 && !IsPendingKill(); }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UHordeReplicationManager, STATGROUP_Tickables); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static bool RegisterCharacter(ADungeonCharacter* Character);
+	static void UnregisterCharacter(ADungeonCharacter* Character);
+
+	//Returns the scale to apply to the character's net priority for the given connection viewer.
+	static float GetConnectionPriorityScale(const ADungeonCharacter* Character, const AActor* Viewer);
+	static bool IsReplicationPausedForViewer(const ADungeonCharacter* Character, const AActor* Viewer);
+
+protected:
+	UFUNCTION()
+	void OnCharacterDamageReceived(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser);
+
+	void RemoveStaleEntries();
+	void GatherViewers();
+	void EvaluateEntry(FHordeReplicationEntry& Entry, float CurrentTime);
+	void UpdateDormancy(FHordeReplicationEntry& Entry, float CurrentTime);
+	void ApplyConnectionBudgets(float CurrentTime);
+
+	void SetEntryDormant(FHordeReplicationEntry& Entry, bool bDormant);
+	const FHordeConnectionState* FindConnectionState(const ADungeonCharacter* Character, const AActor* Viewer) const;
+
+protected:
+	//How often characters are re-evaluated.
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.2f;
+
+	UPROPERTY(Config)
+	float CombatNetUpdateFrequency = 30.f;
+	UPROPERTY(Config)
+	float VisibleNetUpdateFrequency = 15.f;
+	UPROPERTY(Config)
+	float OffscreenNetUpdateFrequency = 2.f;
+
+	//Characters closer than this to a viewer are always treated as visible to it.
+	UPROPERTY(Config)
+	float NearDistance = 1500.f;
+	//Distance at which visible characters reach their lowest update rate and priority.
+	UPROPERTY(Config)
+	float FarDistance = 8000.f;
+	//Cosine of the half angle of the view cone used to decide if a character is in view.
+	UPROPERTY(Config)
+	float ViewConeCosine = 0.5f;
+	//How long a character is considered in combat with a player after being damaged by them.
+	UPROPERTY(Config)
+	float CombatInvolvementTime = 5.f;
+
+	UPROPERTY(Config)
+	float CombatPriorityScale = 3.f;
+	UPROPERTY(Config)
+	float OffscreenPriorityScale = 0.25f;
+	UPROPERTY(Config)
+	float MinDistancePriorityScale = 0.1f;
+
+	//Bytes per connection per server net tick all dungeon characters may spend together.
+	UPROPERTY(Config)
+	int32 MaxBytesPerConnectionPerFrame = 1024;
+	//Rough cost of a single dungeon character update. Used to convert update rates into bandwidth.
+	UPROPERTY(Config)
+	int32 EstimatedUpdateBytes = 48;
+	//Characters paused for a connection for this long are let through regardless of budget.
+	UPROPERTY(Config)
+	float MaxStarvationTime = 1.f;
+	//Characters let through due to starvation are kept unpaused for this long so they get a chance to replicate.
+	UPROPERTY(Config)
+	float StarvationGraceTime = 0.5f;
+
+	//Characters idle and unseen by every connection for this long are made dormant.
+	UPROPERTY(Config)
+	float DormancyDelay = 3.f;
+	UPROPERTY(Config)
+	float IdleSpeedThreshold = 10.f;
+
+	UPROPERTY(Transient)
+	TArray<FHordeReplicationEntry> EntryList;
+	UPROPERTY(Transient)
+	TArray<FHordeReplicationViewer> ViewerList;
+
+	TMap<TObjectKey<ADungeonCharacter>, int32> EntryIndexMap;
+	TMap<TObjectKey<AActor>, int32> ViewerIndexMap;
+
+	TArray<int32> SortedEntryIndexList;
+
+	float TimeUntilEvaluation = 0.f;
+};
@@ -167,10 +167,19 @@ protected:
 	UFUNCTION(Server, Reliable, WithValidation)
 	void Server_Reliable_RequestVoiceCommand(const FGameplayTag& VoiceTag);
 
-	UFUNCTION(NetMulticast, Reliable)
-	void Multicast_Reliable_BroadcastVoiceCommand(const FGameplayTag& VoiceTag);
-
-	void GenerateVoiceRandomFloat();
+	//Sent to each listener's own voice command component on behalf of the speaking one.
+	UFUNCTION(Client, Unreliable)
+	void Client_Unreliable_ReceiveVoiceCommand(UVoiceCommandComponent* Speaker, const FGameplayTag& VoiceTag, uint8 Sequence);
+
+	//Server only. Voice requests made within MinBroadcastInterval of the previous broadcast are coalesced into a single delayed broadcast.
+	void QueueVoiceBroadcast(const FGameplayTag& VoiceTag);
+	void FlushPendingVoiceBroadcast();
+	void BroadcastVoiceCommand(const FGameplayTag& VoiceTag, uint8 Sequence);
+	bool CanPlayerHearVoice(const APlayerController* Listener, const FGameplayTag& VoiceTag) const;
+	void ReceiveVoiceCommand(const FGameplayTag& VoiceTag, uint8 Sequence);
+
+	//The voice variation is derived from the replicated base seed and a per-broadcast sequence number so every client picks the same sound wave.
+	void SetVoiceSequence(uint8 Sequence);
 	float GetVoiceRandomFloat() const;
 
 	template<EVoiceCommandMenuInput Input>
@@ -203,9 +212,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = AI, meta = (EditCondition = "bMakeNoiseOnPickup", DisplayName = "Make Noise On Pickup"))
 	FCoreNoiseParams VoiceCommandNoise = FCoreNoiseParams(CoreNoiseTag::InventoryPickup, 0.15f, 0.f);
 
-	UPROPERTY(Transient)
-	TMap<FGameplayTag, USoundWaveContainer*> LoadedVoiceSoundWaveContainerMap = TMap<FGameplayTag, USoundWaveContainer*>();
-
 	UPROPERTY(Transient)
 	ACorePlayerState* OwningPlayerState = nullptr;
 
@@ -222,6 +228,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = VoiceCommandComponent)
 	float VoiceCommandCooldownDuration = 2.f;
 
+	//Minimum time between voice broadcasts from this speaker. Requests within this window are coalesced, keeping the latest accepted request.
+	UPROPERTY(EditDefaultsOnly, Category = VoiceCommandComponent)
+	float MinBroadcastInterval = 0.25f;
+	//Distance at which non-radio voices (and radio voices for players of other teams) stop being sent to a player.
+	UPROPERTY(EditDefaultsOnly, Category = VoiceCommandComponent)
+	float VoiceAudibleDistance = 4000.f;
+
+	UPROPERTY(Transient)
+	float LastBroadcastTime = -1.f;
+	UPROPERTY(Transient)
+	FGameplayTag PendingBroadcastVoiceTag;
+	UPROPERTY(Transient)
+	uint8 PendingBroadcastSequence = 0;
+	UPROPERTY(Transient)
+	FTimerHandle PendingBroadcastTimerHandle;
+
 	UPROPERTY(Transient)
 	bool bVoiceCommandMenuOpen = false;
 	UPROPERTY(Transient)
@@ -235,8 +257,10 @@ private:
 	//Base seed with which all voice variations are based on.
 	UPROPERTY(Transient, Replicated)
 	FRandomStream RandomVoiceSeed = 0;
-	//Generated via UVoiceCommandComponent::GenerateVoiceRandomNumber and consumed later on.
-	//Never directly interact with. Use UVoiceCommandComponent::GenerateVoiceRandomNumber and UVoiceCommandComponent::ConsumeVoiceRandomNumber to interact with.
+	//Server only. Incremented for each voice broadcast and sent along with it.
+	UPROPERTY(Transient)
+	uint8 VoiceSequence = 0;
+	//Set via UVoiceCommandComponent::SetVoiceSequence. Never directly interact with.
 	UPROPERTY(Transient)
 	float VoiceRandomFloat = -1.f;
 
@@ -257,6 +281,33 @@ public:
 	static FText GetTitleForVoiceGameplayTag(const FGameplayTag& VoiceTag);
 };
 
+USTRUCT()
+struct FVoiceLineEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TSoftObjectPtr<USoundWave> SoundWave = nullptr;
+	//Running total of weights up to and including this entry within its tag's range.
+	UPROPERTY()
+	float CumulativeWeight = 0.f;
+	UPROPERTY()
+	float Duration = -1.f;
+};
+
+USTRUCT()
+struct FVoiceLineRange
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	int32 StartIndex = 0;
+	UPROPERTY()
+	int32 Count = 0;
+	UPROPERTY()
+	float TotalWeight = 0.f;
+};
+
 UCLASS(BlueprintType, Blueprintable, AutoExpandCategories = (VoiceDataObject))
 class NAUSEA_API UVoiceDataObject : public UObject
 {
@@ -266,6 +317,7 @@ class NAUSEA_API UVoiceDataObject : public UObject
 #if WITH_EDITOR
 public:
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
 #endif // WITH_EDITOR
 public:
 	virtual void Serialize(FArchive& Ar) override;
@@ -275,6 +327,8 @@ public:
 public:
 	bool IsValidVoiceTag(const FGameplayTag& Request) const;
 	USoundWave* GetSoundWave(const FGameplayTag& Request, float Random) const;
+	//Returns the duration of the voice line that would be picked for the given random value, or -1 if unknown.
+	float GetVoiceDuration(const FGameplayTag& Request, float Random) const;
 
 	bool CanIgnoreVoiceSoundWaveMap() const { return bIgnoresVoiceSoundWaveMap; }
 
@@ -284,6 +338,12 @@ public:
 	void LoadSoundWaveContainers();
 	void UnloadSoundWaveContainers();
 
+protected:
+	//Maps every voice tag to the container property it is edited through.
+	void RebuildSoundWaveContainerMaps();
+	//Flattens the sound wave containers into VoiceLineList and VoiceLineRangeMap. Done when the asset is saved (baking durations), or at load if the asset predates the table.
+	void BuildVoiceLineTable(bool bBakeDurations = false);
+	const FVoiceLineEntry* FindVoiceLine(const FGameplayTag& Request, float Random) const;
 
 protected:
 	//A map of all tags to USoundWaves that this voice can perform.
@@ -386,9 +446,19 @@ protected:
 	UPROPERTY()
 	TMap<FGameplayTag, USoundWaveContainer*> VoiceEventSoundWaveContainerMap = TMap<FGameplayTag, USoundWaveContainer*>();
 	
+	//Every voice line of this voice, packed by tag. VoiceLineRangeMap maps each leaf voice tag to its range in VoiceLineList.
+	UPROPERTY()
+	TArray<FVoiceLineEntry> VoiceLineList;
+	UPROPERTY()
+	TMap<FGameplayTag, FVoiceLineRange> VoiceLineRangeMap;
+
 	UPROPERTY(Transient)
 	bool bHasLoadedSoundContainers = false;
 
+	//Pain, status and reaction lines are played far more often (and by far more characters) so they are requested first at a higher priority.
+	TSharedPtr<FStreamableHandle> PriorityVoiceLineHandle;
+	TSharedPtr<FStreamableHandle> VoiceLineHandle;
+
 	//If true we ignore we if we can resolve a valid voice in UVoiceDataObject::VoiceSoundWaveMap when trying to perform a voice.
 	//Used when UVoiceDataObject::VoiceSoundAsset, UVoiceDataObject::RadioSoundAsset , UVoiceDataObject::VoiceRadioSoundAsset do not use USoundWave parameters.
 	UPROPERTY(EditDefaultsOnly, Category = VoiceDataObject)
@@ -411,6 +481,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = VoiceCommandComponent)
 	static EVoicePriority GetPriorityOfVoiceTag(const FGameplayTag& VoiceTag);
 
+	//Returns true if this is a leaf voice command or voice event tag.
+	static bool IsVoiceTag(const FGameplayTag& VoiceTag);
+
 	//Master tag that is the parent-most tag of all voice tags. Used for validation of voice requests.
 	static FGameplayTag VoiceParent;
 
@@ -437,18 +510,14 @@ class USoundWaveContainer : public UObject
 	GENERATED_UCLASS_BODY()
 
 public:
-	USoundWave* GetSoundWave(float Random) const;
-
-	bool LoadSoundWaveContainer();
-	void LoadComplete();
-	bool UnloadSoundWaveContainer();
+	const TArray<TSoftObjectPtr<USoundWave>>& GetSoundWaveList() const { return SoundWaveList; }
+	float GetSoundWaveWeight(int32 Index) const { return SoundWaveWeightList.IsValidIndex(Index) ? SoundWaveWeightList[Index] : 1.f; }
 
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = VoiceEntry)
 	TArray<TSoftObjectPtr<USoundWave>> SoundWaveList = TArray<TSoftObjectPtr<USoundWave>>();
 
-	UPROPERTY(Transient)
-	TArray<USoundWave*> LoadedSoundWaveList = TArray<USoundWave*>();
-
-	TSharedPtr<FStreamableHandle> StreamableHandle;
+	//Optional selection weight for each entry of SoundWaveList. Entries without a weight default to 1.
+	UPROPERTY(EditDefaultsOnly, Category = VoiceEntry)
+	TArray<float> SoundWaveWeightList = TArray<float>();
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "UObject/SoftObjectPtr.h"
+#include "Templates/SubclassOf.h"
+#include "AbilityContentManager.generated.h"
+
+class AActor;
+class UAbilityComponent;
+class UAbilityInfo;
+struct FStreamableHandle;
+
+NAUSEA_API DECLARE_LOG_CATEGORY_EXTERN(LogAbilityContent, Warning, All);
+
+UENUM()
+enum class EAbilityContentState : uint8
+{
+	Queued,		//Waiting for a free request slot.
+	Loading,	//Streamable request is in flight.
+	Loaded		//Content is resident and held for the rest of the match.
+};
+
+USTRUCT()
+struct FAbilityContentEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FAbilityContentEntry() {}
+
+	UPROPERTY(Transient)
+	EAbilityContentState State = EAbilityContentState::Queued;
+	//Components that initialized this ability before its content was resident. Notified once it is.
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UAbilityComponent>> PendingComponentList;
+	//Number of times a component needed this ability before its content was resident.
+	UPROPERTY(Transient)
+	int32 NotReadyCount = 0;
+
+	//Real time this ability was first requested, when its request was dispatched and when it completed.
+	double RequestTime = 0.0;
+	double DispatchTime = 0.0;
+	double CompleteTime = 0.0;
+	bool bHighPriority = false;
+
+	TSharedPtr<FStreamableHandle> Handle = nullptr;
+};
+
+/**
+ * Shared registry of ability content (decal classes and cast/activation montages). Abilities are queued for preload as soon as the characters that use them
+ * are known (via the wave content preloader) and every ability component using an ability shares the same streamable request.
+ * Only a limited number of requests are in flight at once, abilities needed by a component right now skip ahead of preloads. Load latency is recorded per ability.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UAbilityContentManager : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin UObject Interface
+public:
+	virtual void BeginDestroy() override;
+//~ End UObject Interface
+
+public:
+	//Queues a preload of every ability the given character class can use, either directly through its ability component or through its AI controller's default routine.
+	static int32 PreloadCharacterAbilities(const UObject* WorldContextObject, TSubclassOf<AActor> CharacterClass);
+	static bool PreloadAbility(const UObject* WorldContextObject, TSubclassOf<UAbilityInfo> AbilityClass);
+
+	//Called when an ability is initialized on a component. The component is notified via UAbilityComponent::OnAbilityContentLoaded once the content is resident
+	//(immediately if it already is). Returns false if there is no ability content manager available.
+	static bool RequestAbilityContent(UAbilityComponent* AbilityComponent, TSubclassOf<UAbilityInfo> AbilityClass);
+
+	static void GetAbilityContentAssetList(TSubclassOf<UAbilityInfo> AbilityClass, TArray<FSoftObjectPath>& AssetList);
+	static void GetCharacterAbilityClassList(TSubclassOf<AActor> CharacterClass, TArray<TSubclassOf<UAbilityInfo>>& AbilityClassList);
+
+	UFUNCTION(BlueprintCallable, Category = Ability)
+	bool IsAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass) const;
+	//Time in seconds between an ability first being requested and its content becoming resident. Returns -1 if it has not finished loading.
+	UFUNCTION(BlueprintCallable, Category = Ability)
+	float GetAbilityLoadLatency(TSubclassOf<UAbilityInfo> AbilityClass) const;
+	UFUNCTION(BlueprintCallable, Category = Ability)
+	int32 GetAbilityNotReadyCount(TSubclassOf<UAbilityInfo> AbilityClass) const;
+	UFUNCTION(BlueprintCallable, Category = Ability)
+	int32 GetInFlightRequestCount() const { return InFlightRequestCount; }
+
+protected:
+	FAbilityContentEntry& FindOrQueueEntry(TSubclassOf<UAbilityInfo> AbilityClass, bool bHighPriority);
+	void DispatchQueuedRequests();
+	bool DispatchRequest(TSubclassOf<UAbilityInfo> AbilityClass, FAbilityContentEntry& Entry);
+
+	void OnAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass);
+	void CompleteEntry(TSubclassOf<UAbilityInfo> AbilityClass, FAbilityContentEntry& Entry);
+
+protected:
+	//Maximum number of ability content requests in flight at once.
+	UPROPERTY(Config)
+	int32 MaxInFlightRequests = 4;
+
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<UAbilityInfo>, FAbilityContentEntry> AbilityContentMap;
+	//Abilities waiting for a free request slot. High priority requests are kept ahead of preloads.
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<UAbilityInfo>> QueuedAbilityList;
+
+	int32 InFlightRequestCount = 0;
+};
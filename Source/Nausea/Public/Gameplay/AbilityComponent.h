@@ -151,6 +151,11 @@ public:
 	UFUNCTION()
 	void OnAbilitySoftObjectLoadComplete(UObject* Object);
 
+	//Called by the ability content manager once an initialized ability's content is resident.
+	void OnAbilityContentLoaded(TSubclassOf<UAbilityInfo> AbilityClass);
+
+	const TArray<TSubclassOf<UAbilityInfo>>& GetAbilityClassList() const { return AbilityClassList; }
+
 	UFUNCTION()
 	bool IsHandleValid(FAbilityInstanceHandle InstanceHandle) const;
 
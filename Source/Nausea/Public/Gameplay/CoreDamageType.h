@@ -28,6 +28,36 @@ enum class EApplicationResult : uint8
 	None //Event should not apply to target.
 };
 
+USTRUCT()
+struct FStatusEffectPowerEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectPowerEntry() {}
+	FStatusEffectPowerEntry(TSubclassOf<UStatusEffectBase> InStatusEffectClass, float InPower)
+		: StatusEffectClass(InStatusEffectClass), Power(InPower) {}
+
+	UPROPERTY(Transient)
+	TSubclassOf<UStatusEffectBase> StatusEffectClass = nullptr;
+	UPROPERTY(Transient)
+	float Power = 0.f;
+};
+
+USTRUCT()
+struct FGenericStatusEffectPowerEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FGenericStatusEffectPowerEntry() {}
+	FGenericStatusEffectPowerEntry(EStatusType InStatusType, float InPower)
+		: StatusType(InStatusType), Power(InPower) {}
+
+	UPROPERTY(Transient)
+	EStatusType StatusType = EStatusType::Invalid;
+	UPROPERTY(Transient)
+	float Power = 0.f;
+};
+
 /**
  * 
  */
@@ -60,6 +90,10 @@ public:
 
 	const TMap<EStatusType, float>& GetGenericStatusEffectMap() const { return GenericStatusEffectMap; }
 
+	//Flattened versions of StatusEffectMap and GenericStatusEffectMap. Soft classes are resolved once on first use.
+	const TArray<FStatusEffectPowerEntry>& GetStatusEffectList() const;
+	const TArray<FGenericStatusEffectPowerEntry>& GetGenericStatusEffectList() const;
+
 	EApplicationLogic GetDamageApplicationLogic() const { return DamageApplicationLogic; }
 	EApplicationLogic GetStatusApplicationLogic() const { return StatusApplicationLogic; }
 
@@ -78,6 +112,9 @@ public:
 
 	EHitReactionStrength GetHitReactionStrength(const FHitEvent& HitEvent) const;
 
+protected:
+	void InitializeStatusEffectLists();
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = Logic)
 	EApplicationLogic DamageApplicationLogic = EApplicationLogic::Enemy;
@@ -118,6 +155,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = StatusEffect)
 	TMap<EStatusType, float> GenericStatusEffectMap;
 
+	UPROPERTY(Transient)
+	bool bInitializedStatusEffectLists = false;
+	UPROPERTY(Transient)
+	TArray<FStatusEffectPowerEntry> StatusEffectList;
+	UPROPERTY(Transient)
+	TArray<FGenericStatusEffectPowerEntry> GenericStatusEffectList;
+
 	UPROPERTY(EditDefaultsOnly, Category = StatusEffect)
 	bool bScaleStatusEffectPowerByDamage = false;
 
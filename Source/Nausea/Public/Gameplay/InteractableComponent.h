@@ -6,6 +6,7 @@
 #include "Internationalization/StringTableRegistry.h"
 #include "Components/ActorComponent.h"
 #include "Gameplay/InteractableTypes.h"
+#include "GameplayTags/Classes/GameplayTagContainer.h"
 #include "InteractableComponent.generated.h"
 
 class IInteractableInterface;
@@ -26,6 +27,7 @@ friend UPawnInteractionComponent;
 //~ Begin UActorComponent Interface 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 //~ End UActorComponent Interface
 
 public:
@@ -55,6 +57,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Interaction)
 	float GetHoldInteractionDuration() const { return HoldInteractionDuration; }
 
+	//Owners of interactable components are registered with this tag in the core singleton's tagged actor registry while in play.
+	static const FGameplayTagContainer& GetInteractableTagContainer();
+	bool IsRegisteredInteractable() const { return bRegisteredInteractable; }
+	//Distance from the given location to the sphere around the owner's origin enclosing its colliding components, captured when this component began play.
+	float GetDistanceToInteractable(const FVector& Location) const;
+	//Largest extent of the interactables currently registered in the given world. Used to pad queries against the tagged actor registry, which are made against owner origins.
+	static float GetLargestInteractableExtent(const UWorld* World);
+
 	UFUNCTION(BlueprintCallable, Category = Interaction)
 	virtual void GetInteractableInfo(UPawnInteractionComponent* Instigator, FText& Text, TSoftObjectPtr<UTexture2D>& Icon) const;
 
@@ -103,4 +113,9 @@ private:
 
 	UPROPERTY(Transient)
 	TScriptInterface<IInteractableInterface> InteractableInterface = nullptr;
+
+	UPROPERTY(Transient)
+	bool bRegisteredInteractable = false;
+	UPROPERTY(Transient)
+	float InteractableExtent = 0.f;
 };
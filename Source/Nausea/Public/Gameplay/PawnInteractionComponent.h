@@ -116,6 +116,15 @@ protected:
 
 	UFUNCTION()
 	void SetCurrentLookAtActor(AActor* Actor);
+
+	//Returns true if the view has moved or rotated enough since the last scan, or the last scan is older than ScanMaxInterval.
+	bool ShouldPerformInteractionScan(const FVector& InteractionLocation, const FVector& InteractionDirection) const;
+	void PerformInteractionScan(const FVector& InteractionLocation, const FVector& InteractionDirection);
+	void RefreshInteractionCandidates(const FVector& InteractionLocation);
+	FORCEINLINE void ForceNextInteractionScan() { LastScanTime = -1.f; }
+
+	//Cheap server side check that a client's interaction request could have come from a valid scan.
+	bool IsValidInteractionRequest(const UInteractableComponent* Target, const FVector& Location) const;
 	
 	UFUNCTION()
 	void OnHoveredWidgetChanged(UWidgetComponent* WidgetComponent, UWidgetComponent* PreviousWidgetComponent);
@@ -137,6 +146,28 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Interaction)
 	float InteractionExtent = 10.f;
 
+	//Interaction scans are skipped while the view has moved less than ScanLocationThreshold and rotated less than ScanRotationThreshold (in degrees).
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float ScanLocationThreshold = 15.f;
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float ScanRotationThreshold = 3.f;
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float ScanMinInterval = 0.033f;
+	//Scans still run at this interval while the view is still so that moving interactables are picked up.
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float ScanMaxInterval = 0.2f;
+	//How long the current interaction target is kept after scans stop hitting it.
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float TargetLossGraceTime = 0.1f;
+	//Interactables within InteractionDistance plus this padding are considered candidates. Distance is measured to the bounds of the interactable owner's colliding components.
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float CandidateRadiusPadding = 500.f;
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float CandidateRefreshInterval = 0.5f;
+	//Allowed distance between a client's reported interaction location and the server's.
+	UPROPERTY(EditDefaultsOnly, Category = Interaction)
+	float ServerInteractionLocationTolerance = 200.f;
+
 	UPROPERTY()
 	bool bIsAwaitingResponse = false;
 	UPROPERTY()
@@ -147,4 +178,20 @@ private:
 	TWeakObjectPtr<UInteractableComponent> CurrentInteractionTarget = nullptr;
 	UPROPERTY(Transient)
 	TWeakObjectPtr<AActor> CurrentLookAtActor = nullptr;
+
+	UPROPERTY(Transient)
+	FVector LastScanLocation = FVector::ZeroVector;
+	UPROPERTY(Transient)
+	FVector LastScanDirection = FVector::ZeroVector;
+	UPROPERTY(Transient)
+	float LastScanTime = -1.f;
+	UPROPERTY(Transient)
+	float LastCandidateRefreshTime = -1.f;
+	UPROPERTY(Transient)
+	float CurrentInteractionTargetLastSeenTime = -1.f;
+
+	//Interactable components near the owning pawn. Scan hits on interactables outside of this set are ignored.
+	TSet<TObjectKey<UInteractableComponent>> InteractionCandidateSet;
+	TArray<FHitResult> ScanHitResultList;
+	TArray<AActor*> CandidateActorList;
 };
\ No newline at end of file
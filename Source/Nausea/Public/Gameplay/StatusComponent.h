@@ -22,6 +22,10 @@ class ACorePlayerState;
 class ACoreCharacter;
 class UDamageType;
 class UNauseaDamageType;
+class USkeletalMesh;
+class USkinnedMeshComponent;
+class USkeletalMeshComponent;
+class UPhysicsAsset;
 
 //Helper struct for health and anything else that would want to be clamped between 0 and a specified maximum. 
 USTRUCT(BlueprintType)
@@ -191,6 +195,30 @@ struct TStructOpsTypeTraits< FPartStatContainer > : public TStructOpsTypeTraitsB
 	};
 };
 
+//Bone to part index lookup. Built once per status configuration and skeletal mesh pair and shared by every status component using them.
+struct FBonePartLookup
+{
+	FBonePartLookup() {}
+
+public:
+	FORCEINLINE int32 GetPartIndex(int32 BoneIndex) const { return BonePartIndexList.IsValidIndex(BoneIndex) ? BonePartIndexList[BoneIndex] : INDEX_NONE; }
+	FORCEINLINE int32 GetPartIndex(const FName& BoneName) const { const int32* PartIndex = NamePartIndexMap.Find(BoneName); return PartIndex ? *PartIndex : INDEX_NONE; }
+	//Uses the hit's body index if it was against a component using the mesh and physics asset this lookup was built for, otherwise falls back to the name map.
+	int32 GetPartIndexForHit(const FHitResult& HitResult) const;
+
+	FORCEINLINE const USkeletalMesh* GetSkeletalMesh() const { return SkeletalMesh.Get(); }
+
+public:
+	TWeakObjectPtr<const USkeletalMesh> SkeletalMesh = nullptr;
+	TWeakObjectPtr<const UPhysicsAsset> PhysicsAsset = nullptr;
+	//Part index of each bone in SkeletalMesh, indexed by bone index.
+	TArray<int32> BonePartIndexList;
+	//Part index of each body in PhysicsAsset, indexed by body index (FHitResult::Item for skeletal mesh hits).
+	TArray<int32> BodyPartIndexList;
+	//Part index by bone or part name. Used for meshes other than SkeletalMesh.
+	TMap<FName, int32> NamePartIndexMap;
+};
+
 USTRUCT(BlueprintType)
 struct FPartDestroyedEvent
 {
@@ -358,6 +386,10 @@ public:
 	UFUNCTION()
 	int32 GetPartHealthIndexForBone(const FName& BoneName) const;
 
+	//Resolves the hit part using the bone index of the hit component if it is the mesh the part lookup was built for.
+	int32 GetPartHealthIndexForHit(const FHitResult& HitResult) const;
+	FORCEINLINE int32 GetPartHealthIndexForBoneIndex(int32 BoneIndex) const { return BonePartLookup.IsValid() ? BonePartLookup->GetPartIndex(BoneIndex) : INDEX_NONE; }
+
 	void RequestMovementSpeedUpdate() { bUpdateMovementSpeedModifier = true; }
 	void RequestRotationRateUpdate() { bUpdateRotationRateModifier = true; }
 
@@ -529,8 +561,8 @@ protected:
 	FPartStatContainer PartHealthList;
 	UPROPERTY(Transient)
 	TMap<FName, float> PreviousPartHealthMap;
-	UPROPERTY(Transient)
-	TMap<FName, int32> BonePartIndexMap;
+	//Shared with all other status components using the same config and mesh. Owned by the config object's CDO.
+	TSharedPtr<const FBonePartLookup> BonePartLookup = nullptr;
 	
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_Armour)
 	FStatStruct Armour;
@@ -544,11 +576,11 @@ protected:
 	UPROPERTY(Transient)
 	TArray<UStatusEffectBase*> StatusEffectList;
 
+	//Generic status effect class and power multiplier for this component, indexed by EStatusType.
 	UPROPERTY(Transient)
-	TMap<EStatusType, TSubclassOf<UStatusEffectBase>> GenericStatusEffectMap;
-
+	TArray<TSubclassOf<UStatusEffectBase>> GenericStatusEffectClassList;
 	UPROPERTY(Transient)
-	TMap<EStatusType, float> GenericStatusEffectMultiplierMap;
+	TArray<float> GenericStatusEffectMultiplierList;
 
 	UPROPERTY(Transient)
 	int32 BlockingActionCounter = 0;
@@ -642,9 +674,20 @@ class NAUSEA_API UStatusComponentConfigObject : public UObject
 {
 	GENERATED_UCLASS_BODY()
 
+//~ Begin UObject Interface
+public:
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif //WITH_EDITOR
+//~ End UObject Interface
+
 public:
 	virtual void ConfigureStatusComponent(UStatusComponent* StatusComponent) const;
 
+protected:
+	//Returns the bone to part lookup for the given mesh component, building and caching it if this is the first time its mesh has been seen.
+	TSharedPtr<const FBonePartLookup> GetBonePartLookup(const USkeletalMeshComponent* MeshComponent) const;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = Basic)
 	FStatStruct Health = FStatStruct(100.f, 100.f);
@@ -687,4 +730,9 @@ protected:
 	UCurveFloat* StatusDifficultyScalingCurve = nullptr;
 	UPROPERTY(EditDefaultsOnly, Category = Difficulty)
 	UCurveFloat* StatusPlayerCountScalingCurve = nullptr;
+
+private:
+	//Only ever populated on the CDO, since that is what configures status components.
+	mutable TSharedPtr<const FBonePartLookup> NameBonePartLookup = nullptr;
+	mutable TMap<TWeakObjectPtr<const USkeletalMesh>, TSharedPtr<const FBonePartLookup>> BonePartLookupCache;
 };
\ No newline at end of file
@@ -286,6 +286,14 @@ struct FHitEvent : public FFastArraySerializerItem
 		ID = IDCounter;
 	}
 
+	//Hit events are sent to every relevant client, so only the data needed to play hit reactions is sent and it is quantized as much as possible.
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	//Called by the server before replicating so that the hit location can be sent as a small offset from the owner.
+	void SetOwnerLocation(const FVector& OwnerLocation);
+	//Called by clients on receive to convert the replicated offset back into a world location.
+	void ResolveHitLocation(const FVector& OwnerLocation);
+
 public:
 	UPROPERTY()
 	TSubclassOf<UCoreDamageType> DamageType = nullptr;
@@ -303,4 +311,20 @@ public:
 	uint64 ID = 0;
 
 	static uint64 IDCounter;
+
+	//Damage is sent in tenths and clamped to this value.
+	static constexpr float MaxNetDamage = 100000.f;
+
+protected:
+	//Hit location relative to the owner. Only valid on the server after SetOwnerLocation has been called or on clients after receiving this event.
+	FVector RelativeHitLocation = FAISystem::InvalidLocation;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHitEvent> : public TStructOpsTypeTraitsBase2<FHitEvent>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
\ No newline at end of file
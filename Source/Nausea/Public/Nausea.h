@@ -6,10 +6,14 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 //LOG CATEGORIES
 DECLARE_LOG_CATEGORY_EXTERN(LogUI, Warning, All);
 
+//CSV CATEGORIES
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(NAUSEA_API, Nausea);
+
 class FNauseaModule : public FDefaultGameModuleImpl
 {
 	// Begin IModuleInterface
@@ -125,6 +125,10 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = Mission, meta = (DisplayName="On Objective Progress Changed",ScriptName="ObjectiveProgressChanged"))
 	void K2_ObjectiveProgressChanged(UObjective* Objective, float Progress);
 
+	//Mission completion and progress are aggregated from objective events so only the objective that changed is re-evaluated.
+	void RebuildObjectiveAggregates();
+	void UpdateObjectiveAggregates(UObjective* Objective);
+
 	UFUNCTION(Reliable, NetMulticast)
 	void Multicast_Reliable_MissionStarted();
 	UFUNCTION(Reliable, NetMulticast)
@@ -151,6 +155,22 @@ protected:
 
 	UPROPERTY()
 	UMissionComponent* FollowingMission = nullptr;
+
+	//Index into ObjectiveList (and the cached state and progress lists) for each objective.
+	TMap<TObjectKey<UObjective>, int32> ObjectiveIndexMap;
+	UPROPERTY(Transient)
+	TArray<EObjectiveState> CachedObjectiveStateList;
+	UPROPERTY(Transient)
+	TArray<float> CachedObjectiveProgressList;
+
+	UPROPERTY(Transient)
+	int32 RequiredObjectiveCount = 0;
+	UPROPERTY(Transient)
+	int32 CompletedRequiredObjectiveCount = 0;
+	UPROPERTY(Transient)
+	int32 ProgressObjectiveCount = 0;
+	UPROPERTY(Transient)
+	float ProgressSum = 0.f;
 };
 
 UCLASS(BlueprintType, Blueprintable, AutoExpandCategories = (Default))
@@ -42,14 +42,18 @@ protected:
 	UFUNCTION()
 	void OnActorDied(UStatusComponent* Component, float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser);
 
+	//Removes the actor from the remaining set and unbinds from it. Safe to call more than once per actor (death and destruction both report here).
+	void RemoveRemainingActor(AActor* Actor);
+
 	UFUNCTION()
 	void UpdateObjectiveProgress();
 
 protected:
 	UPROPERTY()
 	TArray<TWeakObjectPtr<AActor>> ActorList;
-	UPROPERTY()
-	TArray<TWeakObjectPtr<AActor>> RemainingActorList;
+
+	//Actors still alive, maintained from death and destruction callbacks.
+	TSet<TObjectKey<AActor>> RemainingActorSet;
 
 	UPROPERTY()
 	int32 StartingActorCount = -1;
@@ -4,10 +4,77 @@
 
 #include "CoreMinimal.h"
 #include "Objective/Objective.h"
+#include "Engine/NetSerialization.h"
 #include "ObjectivePlayerVolume.generated.h"
 
 class AActor;
 class ACoreCharacter;
+class UObjectivePlayerVolume;
+
+USTRUCT()
+struct FObjectiveOverlappingCharacter : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	FObjectiveOverlappingCharacter() {}
+	FObjectiveOverlappingCharacter(ACoreCharacter* InCharacter)
+		: Character(InCharacter) {}
+
+	UPROPERTY()
+	TWeakObjectPtr<ACoreCharacter> Character = nullptr;
+};
+
+USTRUCT()
+struct FObjectiveOverlappingCharacterContainer : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FAST_ARRAY_SERIALIZER_OPERATORS(FObjectiveOverlappingCharacter, CharacterList);
+
+friend UObjectivePlayerVolume;
+
+public:
+	FObjectiveOverlappingCharacterContainer() {}
+
+	FORCEINLINE void SetOwningObjective(UObjectivePlayerVolume* InOwningObjective) { OwningObjective = InOwningObjective; }
+
+private:
+	UPROPERTY()
+	TArray<FObjectiveOverlappingCharacter> CharacterList;
+
+	UPROPERTY(NotReplicated)
+	UObjectivePlayerVolume* OwningObjective = nullptr;
+
+public:
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FObjectiveOverlappingCharacter, FObjectiveOverlappingCharacterContainer>(CharacterList, DeltaParms, *this);
+	}
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+};
+
+template<>
+struct TStructOpsTypeTraits< FObjectiveOverlappingCharacterContainer > : public TStructOpsTypeTraitsBase2< FObjectiveOverlappingCharacterContainer >
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+//Server side bookkeeping for a character overlapping any of an objective's volumes.
+struct FObjectiveCharacterOverlapState
+{
+	FObjectiveCharacterOverlapState() {}
+
+	//Number of overlap actors this character is currently inside of.
+	int32 OverlapCount = 0;
+	//Index into FObjectiveOverlappingCharacterContainer::CharacterList, or INDEX_NONE if the character is not listed (for example because it is dead).
+	int32 ListIndex = INDEX_NONE;
+};
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FObjectivePlayerStatusChangedSignature, UObjectivePlayerVolume*, Objective, ACoreCharacter*, Character);
@@ -20,6 +87,8 @@ UCLASS()
 class NAUSEA_API UObjectivePlayerVolume : public UObjective
 {
 	GENERATED_UCLASS_BODY()
+
+friend FObjectiveOverlappingCharacterContainer;
 	
 //~ Begin UObjective Interface
 public:
@@ -48,7 +117,9 @@ public:
 	int32 GetNumberOfOverlappingCharacters() const;
 	
 	UFUNCTION(BlueprintCallable, Category = Objective)
-	TArray<ACoreCharacter*> GetOverlappingCharacters() const;
+	const TArray<ACoreCharacter*>& GetOverlappingCharacters() const { return OverlappingCharacterView; }
+
+	bool IsCharacterOverlapping(const ACoreCharacter* Character) const;
 
 protected:
 	UFUNCTION()
@@ -79,8 +150,10 @@ protected:
 	UFUNCTION()
 	void NotifyKilled(AController* Killer, AController* Killed, ACoreCharacter* KilledCharacter, const struct FDamageEvent& DamageEvent);
 
-	UFUNCTION()
-	void OnRep_OverlappingCharacters(TArray<TWeakObjectPtr<ACoreCharacter>> PreviousOverlappingCharacters);
+	//Called on both the server and clients whenever a character is added to or removed from the overlapping character list.
+	void NotifyCharacterEntered(ACoreCharacter* Character);
+	void NotifyCharacterExited(ACoreCharacter* Character);
+	void NotifyCharacterListChanged();
 
 	UFUNCTION(BlueprintImplementableEvent, Category = Objective, meta = (DisplayName = "On Player Entered Objective", ScriptName = "OnPlayerEnteredObjective"))
 	void K2_OnPlayerEntered(ACoreCharacter* Character);
@@ -104,9 +177,18 @@ protected:
 	UPROPERTY()
 	TArray<AActor*> OverlapActors;
 
-	UPROPERTY(ReplicatedUsing = OnRep_OverlappingCharacters)
-	TArray<TWeakObjectPtr<ACoreCharacter>> OverlappingCharacters;
+	UPROPERTY(Replicated)
+	FObjectiveOverlappingCharacterContainer OverlappingCharacters;
+
+	//Cached list of valid overlapping characters handed out to UI and Blueprint. Maintained incrementally as characters enter and exit.
+	UPROPERTY(Transient)
+	TArray<ACoreCharacter*> OverlappingCharacterView;
+
+	TMap<TObjectKey<ACoreCharacter>, FObjectiveCharacterOverlapState> CharacterOverlapStateMap;
 
 	UPROPERTY(EditDefaultsOnly, Category = Objective)
 	bool bPercentOfAliveCharacters = true;
+
+	//Server only. Parallel to OverlappingCharacters' list so that back-indices can be fixed up even if the moved character has since been destroyed.
+	TArray<TObjectKey<ACoreCharacter>> ListedCharacterKeyList;
 };
@@ -214,6 +214,10 @@ public:
 public:
 	virtual void Initialize();
 
+	//Requests an async preload of the content this wave config spawns. Nested wave configs are preloaded by their parent instead.
+	virtual void RequestContentPreload();
+	virtual void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const {}
+
 	UFUNCTION()
 	virtual void SetActive(bool bNewIsActive);
 
@@ -19,6 +19,8 @@ class NAUSEA_API UMultiWaveConfig : public UObjectiveWaveConfig
 //~ Begin UObjectiveWaveConfig Interface
 public:
 	virtual void Initialize() override;
+	virtual void RequestContentPreload() override;
+	virtual void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const override;
 protected:
 	virtual void StartSpawning() override;
 	virtual void StopSpawning() override;
@@ -59,6 +61,10 @@ protected:
 	UFUNCTION()
 	void WaveCountUpdated();
 
+	//Streams in content for the wave at the given index and the PreloadWaveCount waves after it. Releases content held for earlier waves.
+	UFUNCTION()
+	void PreloadUpcomingWaves(int32 WaveIndex);
+
 	UFUNCTION()
 	void StartWaveIntermission();
 	UFUNCTION(BlueprintImplementableEvent, Category = Objective, BlueprintAuthorityOnly)
@@ -84,6 +90,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = WaveConfig)
 	TArray<TSubclassOf<UObjectiveWaveConfig>> WaveConfigClassList;
 
+	//Number of waves ahead of the current wave whose content is streamed in during intermissions.
+	UPROPERTY(EditDefaultsOnly, Category = WaveConfig, meta = (ClampMin = "0"))
+	int32 PreloadWaveCount = 1;
+
 	UPROPERTY()
 	UObjectiveWaveConfig* ActiveWaveConfigInstance = nullptr;
 	UPROPERTY()
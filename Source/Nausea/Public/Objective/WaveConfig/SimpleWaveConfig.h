@@ -40,6 +40,10 @@ public:
 	TSubclassOf<ACoreCharacter> GetNextSpawnClass();
 	void AppendSpawns(const TArray<TSubclassOf<ACoreCharacter>>& SpawnList);
 
+	void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const;
+	//Fills LoadedSpawnMap from the spawn group's soft classes.
+	void ResolveSpawnMap();
+
 public:
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<USpawnGroupObject> SpawnGroup;
@@ -60,7 +64,7 @@ class NAUSEA_API USimpleWaveConfig : public UObjectiveWaveConfig
 	
 //~ Begin UObjectiveWaveConfig Interface
 public:
-	virtual void Initialize() override;
+	virtual void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const override;
 protected:
 	virtual void StartSpawning() override;
 	virtual void StopSpawning() override;
@@ -87,6 +91,10 @@ protected:
 	UFUNCTION()
 	virtual void PerformSpawn(int32& NumberOfSpawns, uint8 RetryCount = 0);
 
+	//Resolves spawn group classes. Deferred until spawning starts so that the content can be preloaded beforehand.
+	UFUNCTION()
+	void ResolveSpawnGroupList();
+
 	UFUNCTION()
 	virtual void GenerateSpawnGroupArray();
 
@@ -121,6 +129,8 @@ protected:
 	int32 RemainingWaitingToSpawnCount = -1;
 	UPROPERTY(Transient)
 	int32 PendingSpawnCount = 0;
+	UPROPERTY(Transient)
+	bool bResolvedSpawnGroupList = false;
 
 	UPROPERTY()
 	FTimerHandle NextSpawnTimerHandle;
@@ -46,6 +46,10 @@ public:
 
 	void InternalPawnReachedEndPoint(ADungeonCharacter* Character);
 
+	//Starts the next wave without waiting for the current wave's characters to be killed. Used to drive wave progression during stress tests.
+	//Does nothing (and returns false) if the current wave is the final wave or is still spawning, since initializing the next wave would drop its remaining spawns.
+	bool ForceStartNextWave();
+
 public:
 	//ADungeonCharacter* KilledCharacter, AController* EventInstigator, AActor* DamageCauser, int32& CoinAmount
 	DECLARE_EVENT_FourParams(ADungeonGameMode, FProcessCoinAmountForKillEvent, ADungeonCharacter*, AController*, AActor*, int32&)
@@ -89,6 +89,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = WaveSetup)
 	void GetCharacterClassListForWave(int64 WaveNumber, TArray<TSubclassOf<ADungeonCharacter>>& DungeonCharacterClassList) const;
 
+	//Streams in content for the given wave and the PreloadWaveCount waves after it. Releases content held for earlier waves.
+	UFUNCTION(BlueprintCallable, Category = WaveSetup)
+	void PreloadUpcomingWaves(int64 WaveNumber);
+	void GetPreloadAssetListForWave(int64 WaveNumber, TArray<FSoftObjectPath>& AssetList) const;
+
 	UFUNCTION()
 	void OnWaveCharacterListEmpty();
 
@@ -99,6 +104,9 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = WaveSetup)
 	bool IsFinalWave(int64 WaveNumber) const { return WaveNumber >= LastWaveNumber; }
+	//Returns true if every configuration of the currently initialized wave has spawned all of its characters (or no wave has been initialized).
+	UFUNCTION(BlueprintCallable, Category = WaveSetup)
+	bool IsCurrentWaveDoneSpawning() const;
 
 	UFUNCTION(BlueprintCallable, Category = WaveSetup)
 	UCurveFloat* GetDefaultWaveSizeScaling() const { return DefaultWaveSizeScaling; }
@@ -136,6 +144,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category = WaveSetup)
 	TArray<FWaveModifierEntry> ModifierList;
 
+	//Number of waves ahead of the current wave whose content is streamed in during intermissions.
+	UPROPERTY(EditAnywhere, Category = WaveSetup, meta = (ClampMin = "0"))
+	int32 PreloadWaveCount = 1;
+
 	UPROPERTY(Transient)
 	int64 InitializedWave = -1;
 	UPROPERTY(Transient)
@@ -177,6 +189,7 @@ public:
 	int32 GetSpawnBatchAmount(int64 WaveNumber, UDungeonWaveSetup* Setup = nullptr) const;
 
 	void AppendCharacterClassListForWave(int64 WaveNumber, TArray<TSubclassOf<ADungeonCharacter>>& DungeonCharacterClassList) const;
+	void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const;
 
 	UFUNCTION(BlueprintCallable, Category = Configuration)
 	bool IsAutoStartWave() const { return bIsAutoStartWave; }
@@ -341,6 +354,7 @@ public:
 	bool RefundSpawnClass(TSubclassOf<ADungeonCharacter> CharacterClass);
 
 	TSubclassOf<ADungeonCharacter> GetClass() const;
+	const TSoftClassPtr<ADungeonCharacter>& GetSoftClass() const { return Character; }
 
 protected:
 	UPROPERTY(EditAnywhere, Category = SpawnGroup)
@@ -362,6 +376,7 @@ public:
 	void Initialize();
 
 	void AppendCharacterClassListForWave(int64 WaveNumber, TArray<TSubclassOf<ADungeonCharacter>>& DungeonCharacterClassList) const;
+	void AppendPreloadAssetList(TArray<FSoftObjectPath>& AssetList) const;
 
 	bool HasRemainingSpawns() const;
 	TSubclassOf<ADungeonCharacter> GetNextSpawnClass();
@@ -8,6 +8,8 @@
 
 class ADungeonGameState;
 class UDungeonWaveSetup;
+class UTrapManager;
+class UHordeReplicationManager;
 
 UENUM(BlueprintType)
 enum class EMatchEndType : uint8
@@ -58,6 +60,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = GameState)
 	UDungeonWaveSetup* GetWaveSetup() const;
 
+	UTrapManager* GetTrapManager() const { return TrapManager; }
+	UHordeReplicationManager* GetHordeReplicationManager() const { return HordeReplicationManager; }
+
 	UFUNCTION(BlueprintCallable, Category = GameState)
 	int64 GetCurrentWaveNumber() const { return CurrentWaveNumber; }
 	UFUNCTION(BlueprintCallable, Category = GameState)
@@ -139,6 +144,11 @@ protected:
 	UPROPERTY(Transient)
 	TArray<TSubclassOf<ADungeonCharacter>> CurrentDungeonCharacterClassList;
 
+	UPROPERTY(Transient)
+	UTrapManager* TrapManager = nullptr;
+	UPROPERTY(Transient)
+	UHordeReplicationManager* HordeReplicationManager = nullptr;
+
 	UPROPERTY(Transient)
 	mutable UDungeonWaveSetup* CurrentWaveSetup = nullptr;
 };
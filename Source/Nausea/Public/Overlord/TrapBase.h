@@ -9,6 +9,7 @@
 class UTexture2D;
 class ADungeonPlayerController;
 class APlacementActor;
+class UDamageType;
 
 UCLASS()
 class NAUSEA_API ATrapBase : public AActor
@@ -54,11 +55,18 @@ public:
 	void SetOccupancy(APlacementActor* TargetPlacementActor, const FPlacementCoordinates& BottomLeftCorner, const FPlacementCoordinates& TopRightCorner);
 	void RevokeOccupancy();
 
+	//Called by the UTrapManager once an activation queued via PerformOverlapTestWithPrimitiveAndApplyDamage has been resolved (and its damage applied).
+	virtual void OnTrapActivationResolved(UPrimitiveComponent* Component, const TArray<AActor*>& HitActorList);
+
 protected:
 	UFUNCTION(BlueprintCallable, Category = Trap, meta = (AutoCreateRefTerm = "ActorsToIgnore"))
-	TArray<AActor*> PerformOverlapTestWithPrimitive(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, TArray<AActor*> ActorsToIgnore);
+	TArray<AActor*> PerformOverlapTestWithPrimitive(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore);
+	//Queues an overlap test with the trap manager. Overlaps are resolved and damage applied in a single batch alongside every other trap activated this frame.
 	UFUNCTION(BlueprintCallable, Category = Trap, meta = (AutoCreateRefTerm = "ActorsToIgnore"))
-	TArray<AActor*> PerformOverlapTestWithPrimitiveAndApplyDamage(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, TArray<AActor*> ActorsToIgnore);
+	bool PerformOverlapTestWithPrimitiveAndApplyDamage(UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TSubclassOf<UDamageType> DamageType, float Damage);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = Trap, meta = (DisplayName = "On Trap Activation Resolved", ScriptName = "TrapActivationResolved"))
+	void K2_OnTrapActivationResolved(UPrimitiveComponent* Component, const TArray<AActor*>& HitActorList);
 
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = Trap)
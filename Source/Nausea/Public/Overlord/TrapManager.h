@@ -0,0 +1,149 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "TrapManager.generated.h"
+
+class ATrapBase;
+class UPrimitiveComponent;
+class UDamageType;
+
+USTRUCT()
+struct FTrapActivation
+{
+	GENERATED_USTRUCT_BODY()
+
+	FTrapActivation() {}
+	FTrapActivation(ATrapBase* InTrap, UPrimitiveComponent* InComponent, TSubclassOf<AActor> InActorClassFilter, const TArray<AActor*>& InActorsToIgnore, TSubclassOf<UDamageType> InDamageType, float InDamage)
+		: Trap(InTrap), Component(InComponent), ActorClassFilter(InActorClassFilter), ActorsToIgnore(InActorsToIgnore), DamageType(InDamageType), Damage(InDamage) {}
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<ATrapBase> Trap = nullptr;
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UPrimitiveComponent> Component = nullptr;
+	UPROPERTY(Transient)
+	TSubclassOf<AActor> ActorClassFilter = nullptr;
+	UPROPERTY(Transient)
+	TArray<AActor*> ActorsToIgnore;
+	UPROPERTY(Transient)
+	TSubclassOf<UDamageType> DamageType = nullptr;
+	UPROPERTY(Transient)
+	float Damage = 0.f;
+
+	//Index into UTrapManager::ClusterList of the scene query cluster this activation was grouped into.
+	int32 ClusterIndex = INDEX_NONE;
+	//Range into UTrapManager::HitActorList containing the actors this activation hit. Each actor appears at most once.
+	int32 HitStartIndex = 0;
+	int32 HitCount = 0;
+};
+
+USTRUCT()
+struct FTrapOverlapCandidate
+{
+	GENERATED_USTRUCT_BODY()
+
+	FTrapOverlapCandidate() {}
+	FTrapOverlapCandidate(AActor* InActor, UPrimitiveComponent* InComponent)
+		: Actor(InActor), Component(InComponent) {}
+
+	UPROPERTY(Transient)
+	AActor* Actor = nullptr;
+	UPROPERTY(Transient)
+	UPrimitiveComponent* Component = nullptr;
+
+	FBox Bounds = FBox(ForceInit);
+};
+
+//Group of nearby activations sharing a single scene query.
+USTRUCT()
+struct FTrapActivationCluster
+{
+	GENERATED_USTRUCT_BODY()
+
+	FTrapActivationCluster() {}
+
+	FBox Bounds = FBox(ForceInit);
+	//Sum of the volumes of every activation in this cluster. Used to decide if merging another activation would make the query too wasteful.
+	float MemberVolume = 0.f;
+};
+
+USTRUCT()
+struct FTrapDamageEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FTrapDamageEntry() {}
+	FTrapDamageEntry(AActor* InTarget, TSubclassOf<UDamageType> InDamageType, ATrapBase* InDamageCauser)
+		: Target(InTarget), DamageType(InDamageType), DamageCauser(InDamageCauser) {}
+
+	UPROPERTY(Transient)
+	AActor* Target = nullptr;
+	UPROPERTY(Transient)
+	TSubclassOf<UDamageType> DamageType = nullptr;
+	UPROPERTY(Transient)
+	ATrapBase* DamageCauser = nullptr;
+	UPROPERTY(Transient)
+	float Damage = 0.f;
+};
+
+/**
+ * Gathers trap activations over a frame and resolves them together. Nearby activations are grouped into clusters that share a single scene query,
+ * each activation is then tested against its cluster's candidate list and damage is summed per target, damage type and trap owner before being applied.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UTrapManager : public UObject, public FTickableGameObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const override { return HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ? ETickableTickType::Never : ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return PendingActivationList.Num() > 0 && !IsPendingKill(); }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UTrapManager, STATGROUP_Tickables); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	//Queues an overlap test for the given trap primitive. It will be resolved (and damage applied if a damage type is provided) along with every other activation this frame.
+	static bool QueueTrapActivation(ATrapBase* Trap, UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TSubclassOf<UDamageType> DamageType, float Damage);
+
+	//Performs an immediate overlap test for the given primitive against dungeon pawns.
+	static void PerformOverlapTest(const UPrimitiveComponent* Component, TSubclassOf<AActor> ActorClassFilter, const TArray<AActor*>& ActorsToIgnore, TArray<AActor*>& OutActorList);
+
+protected:
+	void ResolvePendingActivations();
+	void BuildActivationClusters();
+	void GatherOverlapCandidates(const FTrapActivationCluster& Cluster);
+	void ResolveActivation(FTrapActivation& Activation);
+	void ApplyPendingDamage();
+
+protected:
+	//An activation is only merged into a cluster if the merged bounds' volume stays within this multiple of the summed volume of its members.
+	UPROPERTY(Config)
+	float MaxClusterVolumeScale = 2.f;
+
+	UPROPERTY(Transient)
+	TArray<FTrapActivation> PendingActivationList;
+	//Activations currently being resolved. Kept separate so traps reacting to their results can queue activations for next frame.
+	UPROPERTY(Transient)
+	TArray<FTrapActivation> ResolvingActivationList;
+	UPROPERTY(Transient)
+	TArray<FTrapActivationCluster> ClusterList;
+	UPROPERTY(Transient)
+	TArray<FTrapOverlapCandidate> CandidateList;
+	UPROPERTY(Transient)
+	TArray<AActor*> HitActorList;
+	UPROPERTY(Transient)
+	TArray<FTrapDamageEntry> DamageEntryList;
+
+	TArray<FOverlapResult> OverlapResultList;
+	//Actors already hit by the activation currently being resolved.
+	TSet<AActor*> ActivationHitActorSet;
+	TMap<TTuple<AActor*, UClass*, AActor*>, int32> DamageEntryIndexMap;
+};
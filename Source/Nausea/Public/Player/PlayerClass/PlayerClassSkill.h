@@ -17,6 +17,7 @@ class UFireMode;
 class UAmmo;
 class ULoadedAmmo;
 class UCoreDamageType;
+class UStatusComponent;
 
 UCLASS(BlueprintType, Blueprintable, EditInlineNew, DefaultToInstanced, AutoExpandCategories = (Default))
 class NAUSEA_API UPlayerClassSkill : public UPlayerClassObject
@@ -137,32 +138,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Simple Passive Skill")
 	FText GetSkillPowerForSkillDescription() const;
 
-protected:
-	void ApplySkillToValue(float& Value) const;
-
-	UFUNCTION()
-	void ProcessWeaponEvent(const UWeapon* Weapon, float& Value);
-
-	UFUNCTION()
-	void ProcessFireModeEvent(const UWeapon* Weapon, const UFireMode* FireMode, float& Value);
-
-	UFUNCTION()
-	void ProcessRecoilEvent(const UWeapon* Weapon, const UFireMode* FireMode, float& RecoilX, float& RecoilY, float& Rate);
-
-	UFUNCTION()
-	void ProcessAmmoEvent(const UWeapon* Weapon, const UAmmo* Ammo, float& Value);
-
-	UFUNCTION()
-	void ProcessLoadedAmmoEvent(const UWeapon* Weapon, const ULoadedAmmo* LoadedAmmo, float& Value);
+	ESimplePassiveSkill GetPassiveSkill() const { return PassiveSkill; }
 
-	UFUNCTION()
-	void ProcessDamageValueEvent(UStatusComponent* Target, float& Value, const struct FDamageEvent& DamageEvent, ACorePlayerState* Instigator);
+	//Returns true if this skill applies to the given relevance object (a weapon, firemode, ammo or damage type depending on PassiveSkill). See UPlayerClassComponent::GetPassiveSkillMultiplier.
+	bool IsRelevantObject(const UObject* RelevanceObject) const;
 
-	UFUNCTION()
-	void ProcessStatValueEvent(AActor* TargetActor, float& Value);
+	//Multiplier this skill applies to every value it modifies.
+	float GetSkillMultiplier() const;
 
-	UFUNCTION()
-	void ProcessCharacterEvent(const ACoreCharacter* Character, float& Value);
+	//Pushes a damage log modifier for this skill onto the target's damage log.
+	void PushDamageLogModifier(UStatusComponent* Target, float Multiplier) const;
 
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = Description)
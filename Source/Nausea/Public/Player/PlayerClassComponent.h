@@ -12,6 +12,7 @@
 class ACorePlayerState;
 
 class UPlayerClassSkill;
+class UPlayerClassSimplePassiveSkill;
 class UPlayerClassExperienceSource;
 
 class ACoreCharacter;
@@ -46,6 +47,65 @@ struct FExperienceSourceEntry
 	UPlayerClassExperienceSource* ExperienceSource = nullptr;
 };
 
+//Immutable data of a single player class variant, cached from the class default object.
+struct FPlayerClassVariantRecord
+{
+	TArray<UPlayerClassSkill*> VariantSkillList;
+	//Core skills followed by this variant's skills.
+	TArray<UPlayerClassSkill*> ActiveSkillList;
+	//Core default inventory followed by this variant's default inventory.
+	TArray<TSoftClassPtr<UInventory>> DefaultInventoryList;
+	FLinearColor Colour = FLinearColor::Black;
+	UMaterialInterface* BackplateMaterial = nullptr;
+	UMaterialInterface* HexagonBackplateMaterial = nullptr;
+};
+
+//Immutable data of a player class, cached from the class default object. See UPlayerClassComponent::GetPlayerClassRecord.
+struct FPlayerClassRecord
+{
+	TWeakObjectPtr<const UPlayerClassComponent> PlayerClassCDO = nullptr;
+	//Record generation this record was built in. See UPlayerClassComponent::GetPlayerClassRecordGeneration.
+	uint32 Generation = 0;
+
+	FText Title;
+	FText Description;
+	TSoftObjectPtr<UTexture2D> Icon;
+	TSoftObjectPtr<UTexture2D> IconLarge;
+	FLinearColor CoreColour = FLinearColor::Black;
+
+	FPlayerClassVariantRecord CoreRecord;
+	FPlayerClassVariantRecord PrimaryRecord;
+	FPlayerClassVariantRecord AlternativeRecord;
+
+	int32 MaxLevel = 0;
+	bool bHasExperienceCurve = false;
+	//Experience curve value of every level from 0 to MaxLevel + 1.
+	TArray<float> ExperienceCurveValueList;
+
+	const FPlayerClassVariantRecord* GetVariantRecord(EPlayerClassVariant Variant) const
+	{
+		switch (Variant)
+		{
+		case EPlayerClassVariant::Core:
+			return &CoreRecord;
+		case EPlayerClassVariant::Primary:
+			return &PrimaryRecord;
+		case EPlayerClassVariant::Alternative:
+			return &AlternativeRecord;
+		}
+
+		return nullptr;
+	}
+};
+
+//Flattened result of every simple passive skill of one type relevant to one object. See UPlayerClassComponent::GetPassiveSkillMultiplier.
+struct FPassiveSkillModifier
+{
+	float Multiplier = 1.f;
+	//Skills that make up Multiplier alongside their individual multipliers. Only used for damage logging.
+	TArray<TPair<const UPlayerClassSimplePassiveSkill*, float>, TInlineAllocator<2>> ContributorList;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLevelChangedSignature, UPlayerClassComponent*, PlayerClass, int32, Level);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLevelProgressChangedSignature, UPlayerClassComponent*, PlayerClass, float, Progress);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSkillListUpdatedSignature, UPlayerClassComponent*, PlayerClass, const TArray<UPlayerClassSkill*>&, SkillList);
@@ -58,6 +118,9 @@ class NAUSEA_API UPlayerClassComponent : public UActorComponent, public IPlayerO
 //~ Begin UObject Interface	
 public:
 	virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif //WITH_EDITOR
 protected:
 	virtual void PostNetReceive() override;
 //~ Begin UObject Interface
@@ -129,7 +192,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Class)
 	void ProcessInitialInventoryList(TArray<TSubclassOf<UInventory>>& InventoryClassList) const;
 
+	//Adds a simple passive skill to the passive modifier table. Simple passive skills register here instead of binding to the bonus hooks below.
+	void RegisterSimplePassiveSkill(UPlayerClassSimplePassiveSkill* Skill);
+	//Discards every cached passive modifier so they are rebuilt on next query. Called when level, variant or the owner's inventory changes.
+	void MarkPassiveSkillModifiersDirty();
+
+	//Returns the combined multiplier of every simple passive skill of the given type relevant to RelevanceObject.
+	//RelevanceObject is the weapon, firemode, ammo or damage type CDO being modified, or null for skill types without filters.
+	float GetPassiveSkillMultiplier(ESimplePassiveSkill SkillType, const UObject* RelevanceObject) const;
+	//Applies damage passive modifiers to Value and logs each contributing skill on the target if it performs damage logging.
+	void ApplyPassiveSkillDamageModifiers(ESimplePassiveSkill SkillType, UStatusComponent* Target, float& Value, const struct FDamageEvent& DamageEvent) const;
+
 protected:
+	const FPassiveSkillModifier& GetPassiveSkillModifier(ESimplePassiveSkill SkillType, const UObject* RelevanceObject) const;
+
 	UFUNCTION()
 	void OnRep_Level();
 
@@ -291,15 +367,31 @@ private:
 	UPROPERTY(Transient)
 	bool bPendingExperienceUpdate = false;
 
+	//Registered simple passive skills by type. Skills are owned by this component's skill lists.
+	TMap<ESimplePassiveSkill, TArray<UPlayerClassSimplePassiveSkill*>> SimplePassiveSkillMap;
+	//Passive modifiers built on demand per skill type and relevance object.
+	mutable TMap<TPair<ESimplePassiveSkill, TObjectKey<UObject>>, FPassiveSkillModifier> PassiveSkillModifierMap;
+
 public:
+	//Returns the cached record of the given player class, building it on first use. Records are built for every available class when the game state receives its player class list.
+	//Records stay in memory (and keep the objects they reference alive) for the lifetime of the game. When a class default object is edited or reinstanced its record is replaced by a new one
+	//and the record generation is bumped, so anything holding on to record data should compare the record's Generation against GetPlayerClassRecordGeneration.
+	static const FPlayerClassRecord* GetPlayerClassRecord(TSubclassOf<UPlayerClassComponent> PlayerClass);
+	static uint32 GetPlayerClassRecordGeneration();
+	static void BuildPlayerClassRecords(const TArray<TSubclassOf<UPlayerClassComponent>>& PlayerClassList);
+protected:
+	void BuildPlayerClassRecord(FPlayerClassRecord& Record) const;
+
+public:
+
 	UFUNCTION(BlueprintCallable, Category = PlayerClass)
-	static TArray<UPlayerClassSkill*> GetCoreSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass);
+	static const TArray<UPlayerClassSkill*>& GetCoreSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass);
 
 	UFUNCTION(BlueprintCallable, Category = PlayerClass)
-	static TArray<UPlayerClassSkill*> GetVariantSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
+	static const TArray<UPlayerClassSkill*>& GetVariantSkillListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
 	
 	UFUNCTION(BlueprintCallable, Category = Class)
-	static TArray<UPlayerClassSkill*> GetActiveSkillListListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
+	static const TArray<UPlayerClassSkill*>& GetActiveSkillListListOfClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
 
 	UFUNCTION(BlueprintCallable, Category = PlayerClass)
 	static FText GetPlayerClassTitle(TSubclassOf<UPlayerClassComponent> PlayerClass);
@@ -324,7 +416,7 @@ public:
 	static UMaterialInterface* GetPlayerClassHexagonBackplateMaterial(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
 
 	UFUNCTION(BlueprintCallable, Category = PlayerClass, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
-	static TArray<TSoftClassPtr<UInventory>> GetDefaultInventoryListFromClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
+	static const TArray<TSoftClassPtr<UInventory>>& GetDefaultInventoryListFromClass(TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
 
 	UFUNCTION(BlueprintCallable, Category = PlayerClass)
 	static int32 GetPlayerClassLevel(TScriptInterface<IPlayerOwnershipInterface> PlayerOwnedInterface, TSubclassOf<UPlayerClassComponent> PlayerClass, EPlayerClassVariant PlayerClassVariant);
@@ -9,6 +9,9 @@
 class ACoreGameMode;
 class ACorePlayerState;
 class USpawnCharacterSystem;
+class UWaveContentPreloader;
+class UCorpseManager;
+class UAbilityContentManager;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMatchStateChanged, ACoreGameState*, GameState, FName, MatchState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPlayerArrayChangeSignature, bool, bIsPlayer, ACorePlayerState*, PlayerState);
@@ -32,6 +35,8 @@ public:
 	virtual void AddPlayerState(APlayerState* PlayerState) override;
 	virtual void RemovePlayerState(APlayerState* PlayerState) override;
 	virtual void OnRep_MatchState() override;
+protected:
+	virtual void HandleMatchIsWaitingToStart() override;
 //~ End AGameStateBase Interface
 
 public:
@@ -76,6 +81,9 @@ public:
 	uint8 GetGameDifficultyForScaling() const { return GetGameDifficulty(); }
 
 	USpawnCharacterSystem* GetSpawnCharacterSystem() const { return SpawnCharacterSystem; }
+	UWaveContentPreloader* GetWaveContentPreloader() const { return WaveContentPreloader; }
+	UCorpseManager* GetCorpseManager() const { return CorpseManager; }
+	UAbilityContentManager* GetAbilityContentManager() const { return AbilityContentManager; }
 
 public:
 	UPROPERTY(BlueprintAssignable, Category = Objective)
@@ -118,6 +126,9 @@ protected:
 	UFUNCTION()
 	void OnPlayerAliveUpdate(ACorePlayerState* PlayerState, bool bAlive);
 
+	//Streams in the customization the given player's character will spawn with while we wait for the match to start.
+	void PreloadPlayerCustomization(ACorePlayerState* PlayerState);
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = GameState)
 	TArray<TSoftClassPtr<UPlayerClassComponent>> DefaultPlayerClassList;
@@ -139,6 +150,12 @@ protected:
 
 	UPROPERTY(Transient)
 	USpawnCharacterSystem* SpawnCharacterSystem = nullptr;
+	UPROPERTY(Transient)
+	UWaveContentPreloader* WaveContentPreloader = nullptr;
+	UPROPERTY(Transient)
+	UCorpseManager* CorpseManager = nullptr;
+	UPROPERTY(Transient)
+	UAbilityContentManager* AbilityContentManager = nullptr;
 
 public:
 	/** Returns the current CoreGameState or Null if it can't be retrieved */
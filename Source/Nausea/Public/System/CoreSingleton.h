@@ -16,10 +16,92 @@ DECLARE_STATS_GROUP(TEXT("CoreCustomizationComponent"), STATGROUP_Customization,
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnSingletonTickSignature, float, DeltaTime);
 
+//Optional uniform grid over the actors registered with a tag. Rebuilt at most once per frame, and only when queried.
+struct FTaggedActorSpatialGrid
+{
+	FTaggedActorSpatialGrid() {}
+
+public:
+	FORCEINLINE bool IsEnabled() const { return CellSize > 0.f; }
+	FORCEINLINE FIntVector GetCell(const FVector& Location) const { return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize)); }
+	FORCEINLINE void Invalidate() { BuildFrame = MAX_uint64; }
+
+public:
+	float CellSize = 0.f;
+	uint64 BuildFrame = MAX_uint64;
+	//Slot indices into the owning FTaggedActorList's ActorList, by cell.
+	TMap<FIntVector, TArray<int32>> CellMap;
+};
+
+//Dense list of actors registered with a single tag. Removal swaps the last slot into the removed one.
+struct FTaggedActorList
+{
+	FTaggedActorList() {}
+
+public:
+	TArray<TWeakObjectPtr<AActor>> ActorList;
+	//Parallel to ActorList. Kept so that back-indices can be fixed up even if the moved actor has since been destroyed.
+	TArray<TObjectKey<AActor>> ActorKeyList;
+
+	mutable FTaggedActorSpatialGrid SpatialGrid;
+};
+
+//Every tag an actor is registered with and the slot it occupies in that tag's list.
+struct FTaggedActorEntry
+{
+	FTaggedActorEntry() {}
+
+public:
+	int32* FindSlot(const FGameplayTag& Tag);
+
+public:
+	TArray<TPair<FGameplayTag, int32>, TInlineAllocator<4>> SlotList;
+};
+
+class FTaggedActorRegistry
+{
+public:
+	//Returns true if this actor was not registered with any tag prior to this call.
+	bool Register(AActor* Actor, const FGameplayTagContainer& TagContainer);
+	//Returns true if this actor is no longer registered with any tag after this call.
+	bool Unregister(AActor* Actor, const FGameplayTagContainer& TagContainer);
+	void UnregisterAll(AActor* Actor);
+
+	//If bExactMatch is false, actors registered with child tags of any of the given tags are included as well.
+	void GetActors(TArray<AActor*>& OutActorList, const FGameplayTagContainer& TagContainer, bool bExactMatch) const;
+	void GetActorsInRadius(TArray<AActor*>& OutActorList, const FGameplayTagContainer& TagContainer, const FVector& Location, float Radius, bool bExactMatch) const;
+
+	//A CellSize of 0 or less disables the spatial grid for the given tag.
+	void SetSpatialGridCellSize(const FGameplayTag& Tag, float CellSize);
+
+protected:
+	void GatherTaggedActorLists(TArray<const FTaggedActorList*, TInlineAllocator<8>>& OutTaggedActorLists, const FGameplayTagContainer& TagContainer, bool bExactMatch) const;
+	void RemoveSlot(const FGameplayTag& Tag, int32 SlotIndex);
+	void RebuildSpatialGrid(const FTaggedActorList& TaggedActorList) const;
+
+private:
+	TMap<FGameplayTag, FTaggedActorList> TaggedActorListMap;
+	TMap<TObjectKey<AActor>, FTaggedActorEntry> ActorEntryMap;
+	//Stored separately so that the setting outlives the tag's list being emptied.
+	TMap<FGameplayTag, float> SpatialGridCellSizeMap;
+};
+
+USTRUCT()
+struct FTaggedActorSpatialGridSetting
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	FGameplayTag Tag;
+	UPROPERTY()
+	float CellSize = 0.f;
+};
+
 /**
  * 
  */
-UCLASS()
+UCLASS(Config = Game)
 class NAUSEA_API UCoreSingleton : public UObject, public FTickableGameObject
 {
 	GENERATED_UCLASS_BODY()
@@ -34,6 +116,11 @@ public:
 	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
 //~ End FTickableGameObject Interface
 
+//~ Begin UObject Interface
+public:
+	virtual void PostInitProperties() override;
+//~ End UObject Interface
+
 public:
 	UFUNCTION(BlueprintCallable, Category = Singleton, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 	static void BindToSingletonTick(const UObject* WorldContextObject, FOnSingletonTickSignature Delegate);
@@ -42,7 +129,10 @@ public:
 
 	static void RegisterActorWithTag(const UObject* WorldContextObject, AActor* Actor, const FGameplayTagContainer& Tag);
 	static void UnregisterActorWithTag(const UObject* WorldContextObject, AActor* Actor, const FGameplayTagContainer& Tag);
-	static void GetActorsWithTag(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag);
+	static void GetActorsWithTag(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag, bool bExactMatch = true);
+	static void GetActorsWithTagInRadius(const UObject* WorldContextObject, TArray<AActor*>& ActorList, const FGameplayTagContainer& Tag, const FVector& Location, float Radius, bool bExactMatch = true);
+	//Enables a spatial grid for radius queries against the given tag. Worth enabling for tags with many actors that are queried often.
+	static void SetTagSpatialGridCellSize(const UObject* WorldContextObject, const FGameplayTag& Tag, float CellSize);
 
 	UFUNCTION(BlueprintCallable, Category = Singleton, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext, DisplayName = "Register Actor With Tag"))
 	static void K2_RegisterActorWithTag(const UObject* WorldContextObject, AActor* Actor, FGameplayTagContainer Tag) { RegisterActorWithTag(WorldContextObject, Actor, Tag); }
@@ -51,17 +141,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Singleton, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext, DisplayName = "Get Actors With Tag"))
 	static TArray<AActor*> K2_GetActorsWithTag(const UObject* WorldContextObject, FGameplayTagContainer Tag)
 	{
-		static TArray<AActor*> ResultList;
+		TArray<AActor*> ResultList;
 		GetActorsWithTag(WorldContextObject, ResultList, Tag);
 		return ResultList;
 	}
+	UFUNCTION(BlueprintCallable, Category = Singleton, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext, DisplayName = "Get Actors With Tag In Radius"))
+	static TArray<AActor*> K2_GetActorsWithTagInRadius(const UObject* WorldContextObject, FGameplayTagContainer Tag, FVector Location, float Radius, bool bExactMatch = true)
+	{
+		TArray<AActor*> ResultList;
+		GetActorsWithTagInRadius(WorldContextObject, ResultList, Tag, Location, Radius, bExactMatch);
+		return ResultList;
+	}
+
+protected:
+	//Makes sure destroyed actors do not linger in the tagged actor registry if they were never unregistered.
+	UFUNCTION()
+	void OnTaggedActorDestroyed(AActor* DestroyedActor);
 
 private:
+	//Tags that are queried by radius often enough to be worth a spatial grid, applied to the tagged actor registry on creation.
+	UPROPERTY(Config)
+	TArray<FTaggedActorSpatialGridSetting> TagSpatialGridSettingList;
+
 	UPROPERTY(Transient, DuplicateTransient)
 	TArray<FOnSingletonTickSignature> SingletonTickCallbackList;
 
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UGameInstance> GameInstance = nullptr;
 
-	TMap<FGameplayTag, TArray<TWeakObjectPtr<AActor>>> ActorGameplayTagMap = TMap<FGameplayTag, TArray<TWeakObjectPtr<AActor>>>();
+	FTaggedActorRegistry TaggedActorRegistry;
 };
\ No newline at end of file
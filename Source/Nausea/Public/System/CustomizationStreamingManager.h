@@ -0,0 +1,147 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "Engine/StreamableManager.h"
+#include "CustomizationStreamingManager.generated.h"
+
+class UCustomizationAsset;
+
+UENUM()
+enum class ECustomizationStreamPriority : uint8
+{
+	Preload,	//Speculative loads (such as lobby preloads). Started only once nothing more important is waiting.
+	Normal,		//Customization being applied to a character in the world.
+	Immediate	//Customization the local player is directly looking at (their own character or the main menu preview). Ignores the in-flight budget.
+};
+
+USTRUCT()
+struct FCustomizationStreamHandle
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FCustomizationStreamHandle() {}
+
+	FORCEINLINE bool operator== (const FCustomizationStreamHandle& InData) const { return Handle == InData.Handle; }
+	FORCEINLINE bool operator!= (const FCustomizationStreamHandle& InData) const { return Handle != InData.Handle; }
+
+	bool IsValid() const { return Handle != 0; }
+
+	static FCustomizationStreamHandle GenerateHandle()
+	{
+		if (++FCustomizationStreamHandle::HandleIDCounter == 0)
+		{
+			FCustomizationStreamHandle::HandleIDCounter++;
+		}
+
+		return FCustomizationStreamHandle(FCustomizationStreamHandle::HandleIDCounter);
+	}
+
+	FORCEINLINE friend uint32 GetTypeHash(FCustomizationStreamHandle Other)
+	{
+		return GetTypeHash(Other.Handle);
+	}
+
+protected:
+	FCustomizationStreamHandle(uint64 InHandle) { Handle = InHandle; }
+
+	UPROPERTY()
+	uint64 Handle = 0;
+
+	static uint64 HandleIDCounter;
+};
+
+struct FCustomizationStreamRequest
+{
+	TWeakObjectPtr<const UObject> Requester = nullptr;
+	ECustomizationStreamPriority Priority = ECustomizationStreamPriority::Normal;
+	TArray<FSoftObjectPath> AssetList;
+	FStreamableDelegate Delegate;
+
+	bool bStarted = false;
+	bool bCompleted = false;
+
+	//Used to order pending requests of the same priority. Lower is started sooner.
+	float SortScore = 0.f;
+};
+
+struct FCustomizationAssetEntry
+{
+	TSharedPtr<FStreamableHandle> Handle = nullptr;
+	//Number of started requests holding this asset.
+	int32 ReferenceCount = 0;
+};
+
+/**
+ * Streams customization assets for every character (and the main menu preview) under a shared budget.
+ * Pending requests are started by priority, then by visibility and distance to the local view. Requests for the same asset share a single streamable handle.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UCustomizationStreamingManager : public UObject, public FTickableGameObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin UObject Interface
+public:
+	virtual void BeginDestroy() override;
+//~ End UObject Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const override { return HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ? ETickableTickType::Never : ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return OutstandingRequestCount > 0 && !IsPendingKill(); }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UCustomizationStreamingManager, STATGROUP_Tickables); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	//Queues a load of the given assets on behalf of the requester. The delegate is called once every asset has loaded unless the request is released first.
+	//If the request could be completed immediately (see IsRequestComplete) the delegate is not called.
+	static FCustomizationStreamHandle RequestLoad(const UObject* WorldContextObject, const UObject* Requester, const TArray<FSoftObjectPath>& AssetList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate);
+	static bool IsRequestComplete(const UObject* WorldContextObject, FCustomizationStreamHandle Handle);
+	//Cancels the request if it has not completed and drops its hold on any assets it was keeping loaded.
+	static void ReleaseRequest(const UObject* WorldContextObject, FCustomizationStreamHandle Handle);
+	static int32 ReleaseAllRequests(const UObject* WorldContextObject, const UObject* Requester);
+
+	//Preloads everything the given customization list will need. Only one preload is held per requester.
+	static FCustomizationStreamHandle PreloadCustomizationList(const UObject* WorldContextObject, const UObject* Requester, const TArray<UCustomizationAsset*>& CustomizationList);
+
+protected:
+	FCustomizationStreamHandle AddRequest(const UObject* Requester, const TArray<FSoftObjectPath>& AssetList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate);
+	void RemoveRequest(FCustomizationStreamHandle Handle);
+
+	//Returns the number of assets this request started streaming.
+	int32 StartRequest(FCustomizationStreamRequest& Request);
+	void ReleaseRequestAssets(FCustomizationStreamRequest& Request);
+	bool HasRequestLoaded(const FCustomizationStreamRequest& Request) const;
+
+	void RemoveStaleRequests();
+	void CompleteLoadedRequests();
+	void StartPendingRequests();
+
+	float GetRequestSortScore(const FCustomizationStreamRequest& Request, const FVector& ViewLocation, const FVector& ViewDirection, bool bHasView) const;
+	int32 GetInFlightAssetCount() const;
+
+protected:
+	//Maximum number of customization assets streaming at once. Immediate requests are started regardless.
+	UPROPERTY(Config)
+	int32 MaxInFlightAssetLoads = 8;
+	//Distance added to the sort score of requesters that are not on screen.
+	UPROPERTY(Config)
+	float OffscreenDistancePenalty = 5000.f;
+
+	TMap<FCustomizationStreamHandle, FCustomizationStreamRequest> RequestMap;
+	TMap<FSoftObjectPath, FCustomizationAssetEntry> AssetEntryMap;
+
+	//Number of requests that are pending or loading.
+	int32 OutstandingRequestCount = 0;
+
+	TArray<FCustomizationStreamHandle> SortedPendingRequestList;
+	TArray<FStreamableDelegate> CompletedDelegateList;
+};
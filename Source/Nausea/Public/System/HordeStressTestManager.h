@@ -0,0 +1,115 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "Async/Future.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "HordeStressTestManager.generated.h"
+
+class UNetConnection;
+
+NAUSEA_API DECLARE_LOG_CATEGORY_EXTERN(LogHordeStressTest, Log, All);
+
+/**
+ * Drives an unattended horde stress test when the game is launched with -HordeStressTest. Meant to be run headless, i.e. a NauseaServer build
+ * (or -server -nullrhi) on the dungeon map plus any number of -nullrhi -nosound clients connecting to it, none of which need a GPU.
+ *
+ * On the server, waves are spawned through the regular wave configuration and spawn character system. The match is started once clients are ready
+ * (or after MatchStartTimeout with none). Waves can optionally be forced to start on a fixed interval without waiting for the previous wave's characters to be killed,
+ * so the horde keeps growing. A wave is only forced once the current one has finished spawning and never past the final wave.
+ * On clients, the local player holds fire with their current weapon while turning and periodically performs one of their abilities.
+ *
+ * Each process writes a CSV profiler capture containing the Nausea subsystem timings (horde replication, corpses, traps, animation) alongside the engine's own
+ * frame, thread and memory stats. The server also records horde size, wave progress, process memory and replicated bytes per connection.
+ * Pass -llm -llmcsv as well for per tag allocation data. The process exits once the run is over or the match has ended.
+ *
+ * Options (command line overrides config): -StressDuration= -StressSampleInterval= -StressWaveInterval= -StressMatchStartTimeout= -StressReportDir=
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UHordeStressTestManager : public UObject, public FTickableGameObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const override { return HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ? ETickableTickType::Never : ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return bRunning && !IsPendingKill(); }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UHordeStressTestManager, STATGROUP_Tickables); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static bool IsStressTestRequested();
+
+	void StartStressTest();
+
+	UFUNCTION(BlueprintCallable, Category = StressTest)
+	bool IsRunning() const { return bRunning; }
+
+protected:
+	void BeginRun();
+	void FinishRun();
+
+	void UpdateServer(UWorld* World, float DeltaTime, float ElapsedTime);
+	void UpdateSimulatedClient(UWorld* World, float DeltaTime);
+	void RecordSample(UWorld* World);
+
+	int32 GetConnectionIndex(const UNetConnection* Connection);
+
+protected:
+	//Length of the run in seconds, from the moment the first world begins play.
+	UPROPERTY(Config)
+	float Duration = 300.f;
+	//How often horde, memory and bandwidth stats are sampled.
+	UPROPERTY(Config)
+	float SampleInterval = 1.f;
+	//If greater than zero, the next wave is forced to start this often (once the current wave has finished spawning) regardless of whether its characters are still alive.
+	UPROPERTY(Config)
+	float WaveInterval = 0.f;
+	//If the match has not started this long into the run (no client connected or ready), it is started anyway.
+	UPROPERTY(Config)
+	float MatchStartTimeout = 30.f;
+	//Folder the CSV capture is written to. Defaults to the project's Profiling/CSV folder.
+	UPROPERTY(Config)
+	FString ReportDirectory;
+
+	//Simulated clients alternate between holding and releasing fire on this period.
+	UPROPERTY(Config)
+	float FireBurstDuration = 3.f;
+	UPROPERTY(Config)
+	float AbilityInterval = 5.f;
+	//Degrees per second simulated clients turn while firing.
+	UPROPERTY(Config)
+	float TurnRate = 45.f;
+
+	bool bRunning = false;
+	bool bRunStarted = false;
+	bool bFinishing = false;
+
+	double RunStartTime = 0.0;
+	float TimeUntilSample = 0.f;
+	float TimeUntilForcedWave = 0.f;
+
+	float TimeUntilFireToggle = 0.f;
+	float TimeUntilAbility = 0.f;
+	bool bHoldingFire = false;
+
+	//Aggregates logged once the run is over.
+	int32 FrameCount = 0;
+	float TotalFrameTime = 0.f;
+	float MaxFrameTime = 0.f;
+	int32 PeakCharacterCount = 0;
+	int32 PeakOutBytesPerSecond = 0;
+
+	//Connections are given a stable index the first time they are sampled so their stats stay in the same CSV column.
+	TMap<TObjectKey<UNetConnection>, int32> ConnectionIndexMap;
+
+#if CSV_PROFILER
+	TSharedFuture<FString> CaptureFuture;
+#endif //CSV_PROFILER
+};
@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayTags/Classes/GameplayTagContainer.h"
 #include "MapDataAsset.generated.h"
 
+class UMapDataAsset;
+struct FAssetData;
+
 UENUM(BlueprintType)
 enum class EGameType : uint8
 {
@@ -33,6 +37,36 @@ struct FObjectiveEntry
 	TSoftObjectPtr<UTexture> ObjectiveIcon = nullptr;
 };
 
+//Lightweight description of a map data asset read from the asset registry without loading it. See UNauseaAssetManager::GetMapDataIndex.
+USTRUCT(BlueprintType)
+struct NAUSEA_API FMapDataIndexEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FMapDataIndexEntry() {}
+
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	FPrimaryAssetId AssetId;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	TSoftObjectPtr<UMapDataAsset> MapDataAsset = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	TSoftObjectPtr<UWorld> MapAsset = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	FText MapName = FText();
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	TSoftObjectPtr<UTexture> MapIcon = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	EGameType GameType = EGameType::Invalid;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	bool bMainMenu = false;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	int32 MinPlayerCount = 1;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	int32 MaxPlayerCount = 1;
+	UPROPERTY(BlueprintReadOnly, Category = MapData)
+	FGameplayTagContainer MapTags;
+};
+
 /**
  * 
  */
@@ -44,6 +78,17 @@ class NAUSEA_API UMapDataAsset : public UPrimaryDataAsset
 public:
 	static const FPrimaryAssetType MapDataAssetType;
 
+//~ Begin UObject Interface
+public:
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+//~ End UObject Interface
+
+public:
+	//Fills out an index entry from the registry tags written by UMapDataAsset::GetAssetRegistryTags. Returns false if the asset data is not a map data asset.
+	static bool ReadIndexEntry(const FAssetData& AssetData, FMapDataIndexEntry& OutEntry);
+	//Fills out an index entry from this loaded asset. Used for assets saved before their registry tags were written.
+	void GetIndexEntry(FMapDataIndexEntry& OutEntry) const;
+
 	UFUNCTION(BlueprintCallable, Category = MapData)
 	const TSoftObjectPtr<UWorld>& GetMapAsset() const { return MapAsset; }
 	
@@ -70,6 +115,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = MapData)
 	static FText GetGameTypeTextForEnum(EGameType GameType);
 
+	UFUNCTION(BlueprintCallable, Category = MapData)
+	int32 GetMinPlayerCount() const { return MinPlayerCount; }
+	UFUNCTION(BlueprintCallable, Category = MapData)
+	int32 GetMaxPlayerCount() const { return MaxPlayerCount; }
+	UFUNCTION(BlueprintCallable, Category = MapData)
+	const FGameplayTagContainer& GetMapTags() const { return MapTags; }
+
 	UFUNCTION(BlueprintCallable, Category = MapData)
 	const TArray<FObjectiveEntry>& GetObjectiveList() const { return ObjectiveList; }
 
@@ -98,6 +150,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = MapData)
 	EGameType GameType = EGameType::Raid;
 
+	UPROPERTY(EditDefaultsOnly, Category = MapData, meta = (ClampMin = 1))
+	int32 MinPlayerCount = 1;
+	UPROPERTY(EditDefaultsOnly, Category = MapData, meta = (ClampMin = 1))
+	int32 MaxPlayerCount = 4;
+
+	UPROPERTY(EditDefaultsOnly, Category = MapData)
+	FGameplayTagContainer MapTags;
+
 	UPROPERTY(EditDefaultsOnly, Category = MapData)
 	TArray<FObjectiveEntry> ObjectiveList = TArray<FObjectiveEntry>();
 };
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "MeshMergeTypes.generated.h"
 
 class UCustomizationAsset;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UTexture;
+struct FSkelMeshMergeSectionMapping;
 
 DECLARE_DELEGATE(FCustomizationMergeRequestDelegate);
 
@@ -25,6 +29,17 @@ public:
 
 	const TArray<TSoftObjectPtr<USkeletalMesh>>& GetMeshList() const { return MeshList; }
 
+	friend uint32 GetTypeHash(const FMeshList& InMeshList)
+	{
+		uint32 Hash = 0;
+		for (const TSoftObjectPtr<USkeletalMesh>& Mesh : InMeshList.MeshList)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Mesh.ToSoftObjectPath()));
+		}
+
+		return Hash;
+	}
+
 protected:
 	UPROPERTY(Transient)
 	TArray<TSoftObjectPtr<USkeletalMesh>> MeshList = TArray<TSoftObjectPtr<USkeletalMesh>>();
@@ -204,11 +219,51 @@ protected:
 	USkeletalMesh* TargetMesh = nullptr;
 };
 
-UCLASS()
+//Key of a shared material instance. A source material and the (name sorted) texture overrides applied on top of it.
+struct FSharedMaterialKey
+{
+	TWeakObjectPtr<UMaterialInterface> SourceMaterial = nullptr;
+	TArray<TPair<FName, TWeakObjectPtr<UTexture>>> TextureOverrideList;
+
+	void SetTextureOverride(FName ParameterName, UTexture* Texture);
+
+	bool operator==(const FSharedMaterialKey& Other) const { return SourceMaterial == Other.SourceMaterial && TextureOverrideList == Other.TextureOverrideList; }
+
+	friend uint32 GetTypeHash(const FSharedMaterialKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.SourceMaterial);
+		for (const TPair<FName, TWeakObjectPtr<UTexture>>& TextureOverride : Key.TextureOverrideList)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(TextureOverride.Key), GetTypeHash(TextureOverride.Value)));
+		}
+
+		return Hash;
+	}
+};
+
+//A shared material instance's key and the worlds it has been handed out in. Instances are released once every world using them has been cleaned up.
+struct FSharedMaterialEntry
+{
+	FSharedMaterialKey Key;
+	TArray<TObjectKey<UWorld>, TInlineAllocator<2>> WorldList;
+};
+
+/**
+ * Merges customization skeletal meshes and bakes their materials. Merges are cached by customization set, sections with compatible materials are collapsed into
+ * a single merged section and texture override material instances are shared between every character using the same overrides.
+ * Nothing here touches the GPU so baking can be exercised under -nullrhi.
+ */
+UCLASS(Config = Game)
 class NAUSEA_API UCustomizationMergeManager : public UObject
 {
 	GENERATED_BODY()
 
+//~ Begin UObject Interface
+public:
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+//~ End UObject Interface
+
 public:
 	static FMeshMergeHandle RequestMeshMerge(const UObject* WorldContextObject, const FMeshList& MeshList, FCustomizationMergeRequestDelegate&& Delegate);
 
@@ -216,6 +271,15 @@ public:
 
 	static FMergedMesh GetMergedMesh(const UObject* WorldContextObject, FMeshMergeHandle Handle);
 
+	//Returns a material instance of SourceMaterial with the given texture override (and any overrides SourceMaterial already had through this function) applied.
+	static UMaterialInterface* GetSharedTextureOverrideMaterial(const UObject* WorldContextObject, UMaterialInterface* SourceMaterial, FName ParameterName, UTexture* Texture);
+
+	//Builds a forced section mapping that collapses sections with compatible materials into one merged section where the combined bone map still fits a section.
+	static void BuildSectionMapping(const TArray<USkeletalMesh*>& SkeletalMeshList, TArray<FSkelMeshMergeSectionMapping>& OutSectionMapping);
+	//Returns true if sections using these materials can be drawn as one section.
+	static bool AreMaterialsCompatible(const UMaterialInterface* MaterialA, const UMaterialInterface* MaterialB);
+	static uint32 GetMaterialCompatibilityHash(const UMaterialInterface* Material);
+
 protected:
 	FActiveMergeRequest& StartMeshMerge(const FMeshList& MeshList);
 	void LoadMeshMergeAssets(FActiveMergeRequest& Request);
@@ -225,6 +289,7 @@ protected:
 	void StartNextPendingMeshMerge();
 
 	void MeshMergeComplete(FActiveMergeRequest& Request);
+	void RecordMergeTime(double MergeMilliseconds);
 
 	FActiveMergeRequest& GetActiveMergeRequest(FMeshMergeHandle Handle);
 
@@ -232,6 +297,8 @@ protected:
 	FMeshMergeHandle GetActiveMergeRequestFromCustomizationSet(const FMeshList& InMeshList) const;
 	FMeshMergeHandle GetPendingMergeRequestFromCustomizationSet(const FMeshList& InMeshList) const;
 
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
 protected:
 	//Array of merges that are pending.
 	UPROPERTY(Transient)
@@ -248,4 +315,17 @@ protected:
 	//Keeps reference counters to assets that we're merging to prevent them from being streamed out during merge.
 	UPROPERTY(Transient)
 	TSet<UObject*> LoadedAsssetList = TSet<UObject*>();
+
+	//Customization set hash to completed merge.
+	TMap<uint32, FMeshMergeHandle> MergedMeshHashMap;
+
+	UPROPERTY(Transient)
+	TMap<uint32, UMaterialInstanceDynamic*> SharedMaterialMap;
+	TMap<TObjectKey<UMaterialInterface>, FSharedMaterialEntry> SharedMaterialEntryMap;
+	FDelegateHandle WorldCleanupHandle;
+
+	//Average merge time in milliseconds we allow per frame. Merges can not be split so time spent over budget delays the next merge by as many frames as it overran.
+	UPROPERTY(Config)
+	float MergeBudgetMilliseconds = 4.f;
+	double MergeBudgetDebt = 0.0;
 };
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "Engine/AssetManager.h"
 #include "NauseaAssetManager.generated.h"
 
+struct FMapDataIndexEntry;
+struct FCustomizationIndexEntry;
+
 /**
  * 
  */
@@ -22,4 +25,8 @@ public:
 public:
 	void SetForceSynchronousLoadEnabled(bool bEnable) { bShouldUseSynchronousLoad = bEnable; }
 
+	//Builds an index of every map data asset from its asset registry tags. Only assets saved without those tags are loaded.
+	void GetMapDataIndex(TArray<FMapDataIndexEntry>& OutIndex) const;
+	//Builds an index of every customization asset from its asset registry tags. Only assets saved without those tags are loaded.
+	void GetCustomizationIndex(TArray<FCustomizationIndexEntry>& OutIndex) const;
 };
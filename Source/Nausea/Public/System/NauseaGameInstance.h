@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
+#include "System/MapDataAsset.h"
+#include "Character/Customization/CustomizationObject.h"
+#include "System/CustomizationStreamingManager.h"
 #include "NauseaGameInstance.generated.h"
 
 class UWorld;
@@ -30,12 +33,22 @@ public:
 //~ End UGameInstance Interface
 
 public:
+	//Loads every map data asset. Prefer the map data index and UNauseaGameInstance::RequestMapDataAssets for anything that only needs some of them.
 	UFUNCTION()
 	bool LoadMapDataList(bool bImmediate);
 
+	const TArray<FMapDataIndexEntry>& GetMapDataIndex() const { return MapDataIndex; }
+	const FMapDataIndexEntry* FindMapDataIndexEntry(const TSoftObjectPtr<UWorld>& World) const;
+	//Streams in the given map data assets (typically the ones the current UI page shows). High priority requests are loaded ahead of other async loads.
+	TSharedPtr<FStreamableHandle> RequestMapDataAssets(const TArray<FPrimaryAssetId>& AssetIdList, bool bHighPriority, FSimpleDelegate&& Delegate);
+
+	UFUNCTION(BlueprintCallable, Category = GameInstance, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+	static const TArray<FMapDataIndexEntry>& GetMapDataIndex(const UObject* WorldContextObject);
+
 	const TMap<TSoftObjectPtr<UWorld>, UMapDataAsset*>& GetMapDataAssetMap() const { return MapDataAssetMap; }
-	UMapDataAsset* GetMapDataAsset(TSoftObjectPtr<UWorld> World) const;
-	UMapDataAsset* GetMapDataAssetForCurrentWorld() const;
+	//Returns the map data asset of the given world. If it has not been streamed in yet it is loaded immediately.
+	UMapDataAsset* GetMapDataAsset(TSoftObjectPtr<UWorld> World);
+	UMapDataAsset* GetMapDataAssetForCurrentWorld();
 
 	UFUNCTION(BlueprintCallable, Category = GameInstance, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 	static const TMap<TSoftObjectPtr<UWorld>, UMapDataAsset*>& GetMapDataAssetMap(const UObject* WorldContextObject);
@@ -52,12 +65,22 @@ public:
 	UFUNCTION()
 	bool IsMapDataListReady() const { return bIsMapDataListReady; }
 
+	//Loads every customization asset. Prefer the customization index and UNauseaGameInstance::RequestCustomizationAssets for anything that only needs some of them.
 	UFUNCTION()
 	bool LoadCustomizationList(bool bImmediate);
 	UFUNCTION()
 	bool IsCustomizationObjectListReady() const { return bIsCustomizationObjectListReady; }
 
+	const TArray<FCustomizationIndexEntry>& GetCustomizationIndex() const { return CustomizationIndex; }
+	//Streams in the given customization assets through the customization streaming manager. UI pages should request what they show with ECustomizationStreamPriority::Immediate.
+	FCustomizationStreamHandle RequestCustomizationAssets(const UObject* Requester, const TArray<FPrimaryAssetId>& AssetIdList, ECustomizationStreamPriority Priority, FStreamableDelegate&& Delegate);
+
+	UFUNCTION(BlueprintCallable, Category = GameInstance, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+	static const TArray<FCustomizationIndexEntry>& GetCustomizationIndex(const UObject* WorldContextObject);
+
 	class UCustomizationMergeManager* GetCustomizationManager() const { return CustomizationManager; }
+	class UCustomizationStreamingManager* GetCustomizationStreamingManager() const { return CustomizationStreamingManager; }
+	class UHordeStressTestManager* GetHordeStressTestManager() const { return HordeStressTestManager; }
 
 public:
 	UPROPERTY()
@@ -66,6 +89,9 @@ public:
 	FCustomizationObjectListReadySignature OnCustomizationObjectListReady;
 
 protected:
+	//Builds the map data and customization indices from the asset registry. Does not load any of the indexed assets.
+	void BuildAssetIndices();
+
 	UFUNCTION()
 	void CheckMapDataListLoadComplete();
 
@@ -73,9 +99,18 @@ protected:
 	void CheckCustomizationObjectListLoadComplete();
 
 protected:
+	UPROPERTY(Transient)
+	TArray<FMapDataIndexEntry> MapDataIndex;
+	//Index into MapDataIndex by map world path.
+	TMap<FSoftObjectPath, int32> MapDataIndexLookup;
+	UPROPERTY(Transient)
+	TArray<FCustomizationIndexEntry> CustomizationIndex;
+
 	UPROPERTY()
 	bool bIsMapDataListReady = false;
 	UPROPERTY()
+	bool bIsMapDataListLoading = false;
+	UPROPERTY()
 	TMap<TSoftObjectPtr<UWorld>, UMapDataAsset*> MapDataAssetMap;
 	UPROPERTY()
 	TArray<FPrimaryAssetId> PendingMapDataAssetList;
@@ -83,12 +118,21 @@ protected:
 	UPROPERTY()
 	bool bIsCustomizationObjectListReady = false;
 	UPROPERTY()
+	bool bIsCustomizationObjectListLoading = false;
+	UPROPERTY()
 	TArray<UCustomizationAsset*> CustomizationObjectList;
 	UPROPERTY()
 	TArray<FPrimaryAssetId> PendingCustomizationObjectAssetList;
 
 	UPROPERTY(Transient, DuplicateTransient)
 	UCustomizationMergeManager* CustomizationManager = nullptr;
+
+	UPROPERTY(Transient, DuplicateTransient)
+	UCustomizationStreamingManager* CustomizationStreamingManager = nullptr;
+
+	//Only created when launched with -HordeStressTest.
+	UPROPERTY(Transient, DuplicateTransient)
+	class UHordeStressTestManager* HordeStressTestManager = nullptr;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMapLoadAsyncActionSignature, bool, bResult);
@@ -107,6 +151,10 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", CallableWithoutWorldContext), Category = UI)
 	static UMapLoadAsyncAction* RequestMapList(const UObject* WorldContextObject);
 
+	//Streams in only the map data assets of the given index entries at high priority.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", CallableWithoutWorldContext), Category = UI)
+	static UMapLoadAsyncAction* RequestMapDataAssets(const UObject* WorldContextObject, const TArray<FMapDataIndexEntry>& EntryList);
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FMapLoadAsyncActionSignature OnMapDataListLoaded;
@@ -115,7 +163,17 @@ protected:
 	UFUNCTION()
 	void OnMapLoadRequestComplete(UNauseaGameInstance* NauseaGameInstance, const TArray<UMapDataAsset*>& MapDataAssetList);
 
+	void OnMapDataAssetsLoaded();
+
+	static UMapLoadAsyncAction* CreateAction(const UObject* WorldContextObject);
+
 protected:
 	UPROPERTY()
 	TWeakObjectPtr<UNauseaGameInstance> OwningGameInstance;
+
+	//If not empty, only these map data assets are requested instead of the whole list.
+	UPROPERTY()
+	TArray<FPrimaryAssetId> RequestedAssetIdList;
+
+	TSharedPtr<FStreamableHandle> StreamableHandle;
 };
\ No newline at end of file
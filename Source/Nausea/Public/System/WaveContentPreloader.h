@@ -0,0 +1,79 @@
+// Copyright 2020-2022 Heavy Mettle Interactive. Published under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "UObject/SoftObjectPtr.h"
+#include "WaveContentPreloader.generated.h"
+
+struct FStreamableHandle;
+
+NAUSEA_API DECLARE_LOG_CATEGORY_EXTERN(LogWaveContentPreloader, Warning, All);
+
+struct FWaveContentPreloadRequest
+{
+	FWaveContentPreloadRequest() {}
+	FWaveContentPreloadRequest(const UObject* InRequester, int64 InWaveNumber, TSharedPtr<FStreamableHandle> InHandle)
+		: Requester(InRequester), WaveNumber(InWaveNumber), Handle(InHandle) {}
+
+	TWeakObjectPtr<const UObject> Requester = nullptr;
+	int64 WaveNumber = INDEX_NONE;
+	TSharedPtr<FStreamableHandle> Handle = nullptr;
+};
+
+/**
+ * Streams in wave content (character classes and everything they hard reference) ahead of the wave that needs it.
+ * Handles are held per requester and wave number until the requester releases them.
+ */
+UCLASS()
+class NAUSEA_API UWaveContentPreloader : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+//~ Begin UObject Interface
+public:
+	virtual void BeginDestroy() override;
+//~ End UObject Interface
+
+public:
+	//Requests an async load of the given assets for the given requester and wave. Does nothing if a request for this wave is already held.
+	static bool RequestPreload(const UObject* WorldContextObject, const UObject* Requester, int64 WaveNumber, const TArray<FSoftObjectPath>& AssetList);
+	//Releases any held handles for the given requester whose wave number is below the given wave number.
+	static int32 ReleasePreloadsBefore(const UObject* WorldContextObject, const UObject* Requester, int64 WaveNumber);
+	static int32 ReleaseAllPreloads(const UObject* WorldContextObject, const UObject* Requester);
+
+	//Returns the class if it has already been loaded (ideally by a preload), otherwise loads it synchronously and records the miss.
+	template<class TClass>
+	static TSubclassOf<TClass> ResolveClass(const TSoftClassPtr<TClass>& SoftClass)
+	{
+		if (UClass* LoadedClass = SoftClass.Get())
+		{
+			return LoadedClass;
+		}
+
+		if (SoftClass.IsNull())
+		{
+			return nullptr;
+		}
+
+		return LoadClassSynchronous(SoftClass.ToSoftObjectPath());
+	}
+
+	//Number of times a wave content load missed its preload and had to block on a synchronous load.
+	static int32 GetSynchronousLoadCount() { return SynchronousLoadCount; }
+
+protected:
+	static UClass* LoadClassSynchronous(const FSoftObjectPath& ClassPath);
+
+	bool AddRequest(const UObject* Requester, int64 WaveNumber, const TArray<FSoftObjectPath>& AssetList);
+	int32 ReleaseRequests(const UObject* Requester, int64 WaveNumber);
+
+	//Queues ability content and prepares animation content for every pawn class a completed preload brought in.
+	void OnPreloadComplete(TSharedPtr<FStreamableHandle> Handle);
+
+protected:
+	TArray<FWaveContentPreloadRequest> PreloadRequestList;
+
+	static int32 SynchronousLoadCount;
+};
@@ -16,40 +16,66 @@ struct FCombatLog
 
 	FCombatLog() {}
 
-	FCombatLog(UTextBlock* Widget, int32 ModifierCount)
-	{
-		WidgetList.Reserve(ModifierCount + 1);
-		WidgetList.Add(Widget);
-	}
+	FCombatLog(const FDamageLogEvent& InDamageLogEvent)
+		: DamageLogEvent(InDamageLogEvent) {}
 
 public:
-	FORCEINLINE void AddSubWidget(UTextBlock* Widget) { WidgetList.Add(Widget); }
+	//Returns true if the given event comes from the same source as this entry and this entry is not already on its way out.
+	bool CanMergeWith(const FDamageLogEvent& Other) const;
+	void MergeWith(const FDamageLogEvent& Other);
 
-	bool FadeOut(float DeltaTime);
+	bool FadeOut(float DeltaTime) { Opacity = FMath::Clamp(Opacity - (DeltaTime * 2.f), 0.f, 1.f); return Opacity == 0.f; }
 	bool TickLifeTime(float DeltaTime) { LifeTime -= DeltaTime; return LifeTime <= 0.f; }
 
-	TArray<UTextBlock*>& GetWidgetList() { return WidgetList; }
+	float GetOpacity() const { return Opacity; }
+
+public:
+	UPROPERTY()
+	FDamageLogEvent DamageLogEvent;
 
-protected:
 	UPROPERTY()
-	TArray<UTextBlock*> WidgetList = TArray<UTextBlock*>();
+	FText EventText;
+	UPROPERTY()
+	TArray<FText> ModifierTextList;
+
+protected:
 	UPROPERTY()
 	float LifeTime = 1.f;
+	UPROPERTY()
+	float Opacity = 1.f;
+};
+
+//A fixed set of text blocks used to display a single combat log entry.
+USTRUCT()
+struct FCombatLogRow
+{
+	GENERATED_USTRUCT_BODY()
+
+	FCombatLogRow() {}
+
+public:
+	void SetOpacity(float Opacity);
+
+public:
+	UPROPERTY()
+	UTextBlock* EventTextBlock = nullptr;
+	UPROPERTY()
+	TArray<UTextBlock*> ModifierTextBlockList;
 };
 
 /**
- * 
+ * Displays the most recent combat log entries using a fixed pool of text blocks created on initialization.
  */
 UCLASS(BlueprintType, Blueprintable)
 class NAUSEA_API UCombatLogWidget : public UUserWidget
 {
 	GENERATED_UCLASS_BODY()
 	
-//~ Begin UCombatLogWidget Interface
+//~ Begin UUserWidget Interface
 protected:
 	virtual void NativeOnInitialized() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
-//~ End UCombatLogWidget Interface
+	virtual void NativeDestruct() override;
+//~ End UUserWidget Interface
 
 public:
 	UFUNCTION(BlueprintCallable, Category = CombatLogWidget)
@@ -72,9 +98,17 @@ protected:
 	void OnReceivedDamageLogEvent(UCombatHistoryComponent* Component, const FDamageLogEvent& DamageLogEvent);
 
 	UFUNCTION()
-	UTextBlock* CreateTextBlock();
+	UTextBlock* CreateTextBlock(const FSlateFontInfo& Font);
+
+	//Updates lifetime and fade of all entries. Driven by a single timer that only runs while entries are present.
 	UFUNCTION()
-	void AddToCombatLogPool(FCombatLog& CombatLog);
+	void UpdateCombatLog();
+
+	//Reassigns entry contents to the row pool. Only called when entries are added, merged or removed.
+	void RefreshRows();
+	void UpdateCombatLogTimer();
+
+	FORCEINLINE int32 GetRowIndexForEntry(int32 EntryIndex) const { return RowList.Num() - CombatLogList.Num() + EntryIndex; }
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = CombatLogWidget)
@@ -82,6 +116,13 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = CombatLogWidget)
 	FSlateFontInfo ModifierFont;
 
+	//Maximum number of modifier lines displayed per entry. Additional modifiers are not shown.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = CombatLogWidget, meta = (ClampMin = "0"))
+	int32 MaxModifierLineCount = 4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = CombatLogWidget, meta = (ClampMin = "0.01"))
+	float UpdateInterval = 0.033f;
+
 	UPROPERTY()
 	class UVerticalBox* VerticalBox = nullptr;
 
@@ -89,6 +130,10 @@ protected:
 	TArray<FCombatLog> CombatLogList = TArray<FCombatLog>();
 
 private:
+	//Fixed pool of rows (one per entry up to GetEntryLimit()). Entries are bottom-aligned onto the last rows.
 	UPROPERTY()
-	TArray<UTextBlock*> TextBlockPool = TArray<UTextBlock*>();
-};
\ No newline at end of file
+	TArray<FCombatLogRow> RowList = TArray<FCombatLogRow>();
+
+	UPROPERTY()
+	FTimerHandle CombatLogUpdateTimer;
+};
@@ -118,6 +118,8 @@ public:
 	FORCEINLINE UWeapon* GetCurrentWeapon() const { return CurrentWeapon; }
 	UFUNCTION(BlueprintCallable, Category = InventoryManager)
 	FORCEINLINE UWeapon* GetPendingWeapon() const { return PendingWeapon; }
+
+	const TArray<TSubclassOf<UInventory>>& GetDefaultInventoryList() const { return DefaultInventoryList; }
 	//Gets best weapon that is not currently equipped.
 
 	UFUNCTION(BlueprintCallable, Category = InventoryManager)
@@ -222,8 +224,12 @@ protected:
 	void OnRep_InventoryList();
 	UFUNCTION()
 	void EquipInitialWeapon();
-	UFUNCTION()
-	void UpdateWeaponGroupMap();
+
+	//Adds an inventory to the class lookup, its sorted weapon group and the best weapon list. Does nothing if it is already indexed.
+	void IndexInventory(UInventory* Inventory, TArray<EWeaponGroup>& GroupUpdateList);
+	//Removes an inventory from every index. Does nothing if it is not indexed.
+	void UnindexInventory(UInventory* Inventory, TArray<EWeaponGroup>& GroupUpdateList);
+	void BroadcastGroupUpdates(const TArray<EWeaponGroup>& GroupUpdateList);
 
 	UFUNCTION()
 	void OnInventoryEndPlay(UCoreCharacterComponent* Component, EEndPlayReason::Type Reason);
@@ -250,8 +256,15 @@ protected:
 	UPROPERTY(Transient)
 	TArray<UInventory*> PreviousInventoryList;
 
+	//Weapons by group, each group kept sorted by UWeapon::FSortByPriority as inventory is added and removed.
 	UPROPERTY(Transient)
 	TMap<EWeaponGroup, FWeaponGroupArray> WeaponGroupMap;
+	//Indexed inventory by class. Used by AddInventory and RemoveInventory to avoid walking InventoryList.
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<UInventory>, UInventory*> InventoryClassMap;
+	//Every indexed weapon ordered best first by rating then priority. Used by UInventoryManagerComponent::GetNextBestWeapon.
+	UPROPERTY(Transient)
+	TArray<UWeapon*> BestWeaponList;
 
 	UPROPERTY(Transient)
 	mutable float CachedMovementSpeedModifier = 1.f;
@@ -133,6 +133,10 @@ public:
 	TSubclassOf<UAnimInstance> GetWeaponAnimInstance1P() const { return WeaponAnimInstance1P; }
 	UFUNCTION(BlueprintPure, Category = Weapon)
 	TSubclassOf<UAnimInstance> GetWeaponAnimInstance3P() const { return WeaponAnimInstance3P; }
+	UFUNCTION(BlueprintPure, Category = Weapon)
+	TSubclassOf<UAnimationObject> GetFirstPersonAnimationClass() const { return FirstPersonAnimation; }
+	UFUNCTION(BlueprintPure, Category = Weapon)
+	TSubclassOf<UAnimationObject> GetThirdPersonAnimationClass() const { return ThirdPersonAnimation; }
 
 	//UI and general display info
 	UFUNCTION(BlueprintCallable, Category = Weapon)